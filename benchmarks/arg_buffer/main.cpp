@@ -0,0 +1,107 @@
+///
+/// @file arg_buffer/main.cpp
+/// @brief Cost and heap allocations of capturing and formatting log arguments.
+///
+/// Compares the inline ArgBuffer encoding against the previous std::any + std::tuple
+/// storage, for the argument signatures most commonly seen in log calls.
+///
+
+#include <any>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+#include <slog/core/log_record.hpp>
+#include <slog/fmt/deferred_format.hpp>
+
+#include <common/bench_utils.hpp>
+
+// Global replacement counting every heap allocation of the process.
+// GCC can't tell the replaced operator new apart from the default one.
+#if defined(__GNUC__) && !defined(__clang__)
+    #pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+static std::atomic<uint64_t> g_allocations{0};
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace
+{
+
+constexpr uint64_t ITERATIONS = 2'000'000;
+
+template<typename F>
+void run(std::string_view name, F&& fn)
+{
+    uint64_t before = g_allocations.load(std::memory_order_relaxed);
+    double ns = slog::bench::measure_ns(ITERATIONS, fn);
+    uint64_t allocs = g_allocations.load(std::memory_order_relaxed) - before;
+
+    slog::bench::print_row(name, ns, static_cast<double>(allocs) / ITERATIONS, "allocs/record");
+}
+
+template<typename... Args>
+void bench_capture(std::string_view name, Args... args)
+{
+    slog::LogRecord record;
+    std::any legacy;
+
+    run(std::string(name) + " [ArgBuffer]", [&](uint64_t) {
+        slog::fmt::store_args<std::decay_t<Args>...>(record.stored_args, args...);
+        slog::bench::do_not_optimize(record.stored_args);
+    });
+    run(std::string(name) + " [std::any]", [&](uint64_t) {
+        legacy.emplace<std::tuple<std::decay_t<Args>...>>(args...);
+        slog::bench::do_not_optimize(legacy);
+    });
+}
+
+template<typename... Args>
+void bench_roundtrip(std::string_view name, std::string_view fmt, Args... args)
+{
+    slog::LogRecord record;
+
+    record.format_fn = &slog::fmt::format_deferred<std::decay_t<Args>...>;
+    run(name, [&](uint64_t) {
+        slog::fmt::store_args<std::decay_t<Args>...>(record.stored_args, args...);
+        record.format_fn(fmt, record.args(), record.string_buffer, slog::fmt::FormatMode::MESSAGE);
+        slog::bench::do_not_optimize(record.string_buffer);
+    });
+}
+
+} // namespace
+
+int main()
+{
+    const std::string short_str = "request-42";
+    const std::string long_str(512, 'x');
+
+    slog::bench::print_header("capture");
+    bench_capture("int", 42);
+    bench_capture("int, double", 42, 3.14);
+    bench_capture("literal, int", "user", 42);
+    bench_capture("string(short), int, double", short_str, 42, 3.14);
+    bench_capture("string_view, uint64, bool", std::string_view("id"), uint64_t{7}, true);
+    bench_capture("string(512B)", long_str);
+
+    slog::bench::print_header("capture + format (warm output buffer)");
+    bench_roundtrip("int, double", "{} {:.2f}", 42, 3.14);
+    bench_roundtrip("literal, string(short), int", "{} {} {}", "user", short_str, 42);
+
+    return 0;
+}
@@ -0,0 +1,134 @@
+///
+/// @file async_stats/main.cpp
+/// @brief Cost of the async pipeline stats: producer counters, snapshot and periodic report.
+///
+/// Producer counters: threads bump a counter, either one atomic shared by all of them or
+/// their own cacheline of a ProducerStats. Push: mean cost of a push to a worker, the stats
+/// are always on. Snapshot: mean cost of Worker::stats() while the worker runs.
+///
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <slog/async/stats.hpp>
+#include <slog/async/worker.hpp>
+
+#include <common/bench_utils.hpp>
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+constexpr uint64_t INCREMENTS = 2000000;
+constexpr uint64_t PUSHES = 200000;
+
+class NullSink : public slog::sinks::ISink
+{
+public:
+    explicit NullSink(std::string_view name) : ISink(name) {}
+
+    void flush() override {}
+
+private:
+    void _write(std::string_view message) override { slog::bench::do_not_optimize(message); }
+};
+
+slog::LogRecord make_record()
+{
+    slog::LogRecord record;
+
+    record.level = slog::LogLevel::INFO;
+    record.thread_id = 0;
+    record.format_str = "stats record";
+    return record;
+}
+
+// Mean ns per increment seen by each of `threads` threads
+template<typename Increment>
+double contended(size_t threads, Increment&& increment)
+{
+    std::vector<std::thread> pool;
+    std::vector<double> costs(threads);
+
+    for (size_t t = 0; t < threads; t++) {
+        pool.emplace_back([&, t]() {
+            costs[t] = slog::bench::measure_ns(INCREMENTS, [&](uint64_t) { increment(); });
+        });
+    }
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+
+    double total = 0.0;
+
+    for (double cost : costs) {
+        total += cost;
+    }
+    return total / static_cast<double>(threads);
+}
+
+void bench_counters(size_t threads)
+{
+    std::atomic<uint64_t> shared{0};
+    auto sharded = std::make_unique<slog::async::ProducerStats>();
+    char name[64];
+
+    std::snprintf(name, sizeof(name), "shared atomic, %zu threads", threads);
+    slog::bench::print_row(name, contended(threads, [&]() { shared.fetch_add(1, std::memory_order_relaxed); }),
+                           static_cast<double>(threads), "threads");
+    std::snprintf(name, sizeof(name), "sharded, %zu threads", threads);
+    slog::bench::print_row(name, contended(threads, [&]() {
+        sharded->local().enqueued.fetch_add(1, std::memory_order_relaxed);
+    }), static_cast<double>(threads), "threads");
+}
+
+void bench_worker()
+{
+    auto manager = std::make_shared<slog::sinks::SinkManager>(std::make_shared<NullSink>("null"));
+    auto reports = std::make_shared<slog::sinks::SinkManager>(std::make_shared<NullSink>("reports"));
+    slog::async::Worker worker;
+    slog::async::ManagerHandle handle = worker.attach(manager);
+
+    manager->set_pattern("%v");
+    slog::bench::print_row("push", slog::bench::measure_ns(PUSHES, [&](uint64_t) {
+        worker.push(slog::async::AsyncOp{make_record(), handle});
+    }), 0.0, "");
+    slog::bench::print_row("stats() snapshot", slog::bench::measure_ns(PUSHES, [&](uint64_t) {
+        slog::bench::do_not_optimize(worker.stats());
+    }), 0.0, "");
+
+    worker.set_stats_reporting(reports, "stats", std::chrono::milliseconds(1));
+    slog::bench::print_row("push, 1ms stats report", slog::bench::measure_ns(PUSHES, [&](uint64_t) {
+        worker.push(slog::async::AsyncOp{make_record(), handle});
+    }), 0.0, "");
+
+    slog::async::WorkerStats stats = worker.stats();
+
+    std::printf("enqueued %llu  high water %llu/%llu  producer wait %lld us  busy %lld us  idle %lld us  "
+                "%.1f records per wakeup\n",
+                static_cast<unsigned long long>(stats.enqueued),
+                static_cast<unsigned long long>(stats.high_water),
+                static_cast<unsigned long long>(stats.capacity),
+                static_cast<long long>(stats.producer_wait.count() / 1000),
+                static_cast<long long>(stats.busy.count() / 1000),
+                static_cast<long long>(stats.idle.count() / 1000), stats.records_per_wakeup());
+}
+
+} // namespace
+
+int main()
+{
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    slog::bench::print_header("Producer counters");
+    bench_counters(1);
+    bench_counters(4);
+    slog::bench::print_header("Worker");
+    bench_worker();
+    return 0;
+}
@@ -0,0 +1,90 @@
+///
+/// @file batch_write/main.cpp
+/// @brief Per-record against batched dispatch to the built-in sinks.
+///
+/// The worker hands every sink the records of a logger in batches of SLOG_ASYNC_BATCH_SIZE.
+/// A line buffered console (terminal or pipe) pays a write syscall per line when records are
+/// dispatched one by one, a batch is written with a single stdio call.
+///
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <slog/fmt/deferred_format.hpp>
+#include <slog/sinks/console_sink.hpp>
+#include <slog/sinks/file_sink.hpp>
+#include <slog/sinks/sink_manager.hpp>
+
+#include <common/bench_utils.hpp>
+
+namespace
+{
+
+constexpr uint64_t ITERATIONS = 200'000;
+constexpr size_t BATCH_SIZE = SLOG_ASYNC_BATCH_SIZE;
+
+void fill(std::vector<slog::LogRecord>& records, uint64_t first)
+{
+    for (size_t i = 0; i < records.size(); i++) {
+        records[i].level = slog::LogLevel::INFO;
+        records[i].logger_name = "bench";
+        records[i].thread_id = 1;
+        records[i].format_str = "request {} served in {}us";
+        records[i].format_fn = &slog::fmt::format_deferred<uint64_t, double>;
+        slog::fmt::store_args<uint64_t, double>(records[i].stored_args, first + i, 12.5);
+    }
+}
+
+void bench(std::string_view name, const std::shared_ptr<slog::sinks::ISink>& sink)
+{
+    slog::sinks::SinkManager manager(sink);
+    std::vector<slog::LogRecord> records(BATCH_SIZE);
+    std::vector<slog::LogRecord*> pointers;
+
+    for (slog::LogRecord& record : records) {
+        pointers.push_back(&record);
+    }
+
+    double single = slog::bench::measure_ns(ITERATIONS / BATCH_SIZE, [&](uint64_t i) {
+        fill(records, i * BATCH_SIZE);
+        for (slog::LogRecord& record : records) {
+            manager.dispatch(record);
+        }
+    });
+    double batched = slog::bench::measure_ns(ITERATIONS / BATCH_SIZE, [&](uint64_t i) {
+        fill(records, i * BATCH_SIZE);
+        manager.dispatch(pointers);
+    });
+    sink->flush();
+
+    slog::bench::print_row(std::string(name) + " [per record]", single / BATCH_SIZE, 1.0,
+                           "stdio calls/record");
+    slog::bench::print_row(std::string(name) + " [batched]", batched / BATCH_SIZE,
+                           1.0 / BATCH_SIZE, "stdio calls/record");
+}
+
+} // namespace
+
+int main()
+{
+    std::FILE* null_stream = std::fopen("/dev/null", "w");
+
+    if (!null_stream) {
+        std::perror("fopen /dev/null");
+        return 1;
+    }
+    // Same buffering as a terminal
+    std::setvbuf(null_stream, nullptr, _IOLBF, BUFSIZ);
+
+    slog::bench::print_header("Sink dispatch, batch of " + std::to_string(BATCH_SIZE));
+    bench("ConsoleSink (line buffered)",
+          std::make_shared<slog::sinks::ConsoleSink>("console", null_stream));
+    bench("FileSink", std::make_shared<slog::sinks::FileSink>("file", "/tmp/slog_bench_batch.log"));
+
+    std::fclose(null_stream);
+    std::remove("/tmp/slog_bench_batch.log");
+    return 0;
+}
@@ -0,0 +1,153 @@
+///
+/// @file byte_ring/main.cpp
+/// @brief Throughput and memory footprint of the async transports.
+///
+/// Producers push records shaped like the ones built by a log call into either the
+/// fixed-slot MPSCQueue<AsyncOp> or the variable-length ByteRingQueue, while a single
+/// consumer drains them. Reports records/sec and records/sec per MB of queue memory.
+///
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <slog/async/async_op.hpp>
+#include <slog/async/byte_ring_queue.hpp>
+#include <slog/async/encoded_record.hpp>
+#include <slog/async/mpsc_queue.hpp>
+#include <slog/async/policies.hpp>
+#include <slog/fmt/deferred_format.hpp>
+
+#include <common/bench_utils.hpp>
+
+namespace
+{
+
+constexpr size_t RECORDS_PER_PRODUCER = 500'000;
+constexpr size_t MPSC_SLOTS = 8192;
+constexpr size_t RING_BYTES = 1 << 20;
+
+using SlotQueue = slog::async::MPSCQueue<slog::async::AsyncOp, MPSC_SLOTS,
+                                         slog::async::BlockOnFull>;
+using RingQueue = slog::async::ByteRingQueue<RING_BYTES, slog::async::BlockOnFull>;
+
+slog::async::AsyncOp make_op(size_t thread, size_t i)
+{
+    slog::async::AsyncOp op;
+
+    op.record.level = slog::LogLevel::INFO;
+    op.record.logger_name = "bench";
+    op.record.format_str = "request {} served by {} in {}us";
+    op.record.thread_id = thread;
+    op.record.format_fn = &slog::fmt::format_deferred<size_t, std::string_view, double>;
+    slog::fmt::store_args<size_t, std::string_view, double>(
+        op.record.stored_args, i, std::string_view("worker-03"), 12.5);
+    return op;
+}
+
+template<typename Push, typename Pop>
+double run(size_t producers, Push&& push, Pop&& pop)
+{
+    std::atomic<bool> start{false};
+    std::vector<std::thread> threads;
+    size_t total = producers * RECORDS_PER_PRODUCER;
+    size_t consumed = 0;
+
+    for (size_t t = 0; t < producers; t++) {
+        threads.emplace_back([&, t]() {
+            while (!start.load(std::memory_order_acquire));
+            for (size_t i = 0; i < RECORDS_PER_PRODUCER; i++) {
+                push(make_op(t, i));
+            }
+        });
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    while (consumed < total) {
+        if (pop()) {
+            consumed++;
+        }
+        else {
+            // Like the worker, give the CPU back to the producers when there is nothing to do
+            std::this_thread::yield();
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    for (auto& t : threads) {
+        t.join();
+    }
+    return static_cast<double>(total) / std::chrono::duration<double>(end - begin).count();
+}
+
+void print_result(std::string_view name, double records_per_sec, size_t bytes)
+{
+    double mb = static_cast<double>(bytes) / (1024.0 * 1024.0);
+
+    std::printf("%-40.*s %12.0f rec/s  %12.0f rec/s/MB  (%.2f MB)\n",
+                static_cast<int>(name.size()), name.data(), records_per_sec,
+                records_per_sec / mb, mb);
+}
+
+void bench(size_t producers)
+{
+    std::string suffix = " [" + std::to_string(producers) + " producers]";
+
+    {
+        auto queue = std::make_unique<SlotQueue>();
+        slog::async::AsyncOp out;
+        double rate = run(
+            producers, [&](slog::async::AsyncOp&& op) { queue->push(std::move(op)); },
+            [&]() {
+                if (!queue->pop(out)) {
+                    return false;
+                }
+                slog::bench::do_not_optimize(out.record.args());
+                return true;
+            });
+
+        print_result("MPSCQueue<AsyncOp>" + suffix, rate, queue->memory().bytes);
+    }
+    {
+        auto queue = std::make_unique<RingQueue>();
+        slog::LogRecord out;
+        double rate = run(
+            producers,
+            [&](slog::async::AsyncOp&& op) {
+                queue->push(slog::async::EncodedRecord::encoded_size(op), [&op](std::byte* dst) {
+                    slog::async::EncodedRecord::encode(dst, std::move(op));
+                });
+            },
+            [&]() {
+                return queue->pop([&](std::byte* data, size_t) {
+                    slog::async::EncodedRecord* enc = slog::async::EncodedRecord::from(data);
+
+                    enc->decode(out);
+                    slog::bench::do_not_optimize(out.args());
+                    enc->destroy();
+                });
+            });
+
+        print_result("ByteRingQueue" + suffix, rate, queue->capacity());
+    }
+}
+
+} // namespace
+
+int main()
+{
+    std::printf("sizeof(AsyncOp) = %zu, max encoded record = %zu bytes\n",
+                sizeof(slog::async::AsyncOp), slog::async::EncodedRecord::max_size());
+
+    slog::bench::print_header("Async transport throughput");
+    for (size_t producers : {1, 2, 4}) {
+        bench(producers);
+    }
+    return 0;
+}
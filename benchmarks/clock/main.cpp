@@ -0,0 +1,62 @@
+///
+/// @file clock/main.cpp
+/// @brief Timestamp capture cost on the producer for every clock source.
+///
+/// The producer pays now() for every record, the TSC clock defers the conversion to wall time
+/// to resolve() on the consumer. Select the clock with SLOG_CLOCK_COARSE or SLOG_CLOCK_TSC.
+///
+
+#include <chrono>
+#include <cstdio>
+
+#include <slog/details/clock.hpp>
+
+#include <common/bench_utils.hpp>
+
+namespace
+{
+
+constexpr uint64_t ITERATIONS = 10'000'000;
+
+template<typename Clock>
+double capture_ns()
+{
+    return slog::bench::measure_ns(ITERATIONS, [](uint64_t) {
+        slog::bench::do_not_optimize(Clock::now());
+    });
+}
+
+} // namespace
+
+int main()
+{
+    double system = capture_ns<slog::details::SystemClock>();
+    double coarse = capture_ns<slog::details::CoarseClock>();
+    double tsc = capture_ns<slog::details::TscClock>();
+
+    slog::bench::print_header("Capture (producer, per record)");
+    slog::bench::print_row("system_clock", system, 1.0, "x");
+    slog::bench::print_row("CLOCK_REALTIME_COARSE", coarse, system / coarse, "x faster");
+    slog::bench::print_row("TSC", tsc, system / tsc, "x faster");
+
+    // Resolving on the consumer, the ticks are spread over ~10ms to exercise the mapping
+    slog::details::TimePoint ticks = slog::details::TscClock::now();
+    double resolve = slog::bench::measure_ns(ITERATIONS, [&](uint64_t i) {
+        slog::bench::do_not_optimize(slog::details::TscClock::resolve(
+            ticks + slog::details::TimePoint::duration(static_cast<int64_t>(i))));
+    });
+
+    slog::bench::print_header("Conversion (consumer, per record)");
+    slog::bench::print_row("TSC resolve", resolve, tsc + resolve, "ns capture + resolve");
+
+    // Accuracy of the mapping against system_clock
+    slog::details::TimePoint wall = std::chrono::system_clock::now();
+    slog::details::TimePoint converted =
+        slog::details::TscClock::resolve(slog::details::TscClock::now());
+
+    std::printf("TSC to wall clock offset: %lld ns (%.4f ns/tick)\n",
+                static_cast<long long>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(converted - wall).count()),
+                slog::details::TscClock::instance().ns_per_tick());
+    return 0;
+}
@@ -0,0 +1,60 @@
+#ifndef SLOG_BENCH_UTILS_HPP
+#define SLOG_BENCH_UTILS_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string_view>
+
+namespace slog::bench
+{
+
+// Prevents the compiler from optimizing away `value`
+template<typename T>
+inline void do_not_optimize(T const& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+inline void clobber_memory()
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+// Runs `fn` `iterations` times and returns the mean cost in nanoseconds
+template<typename F>
+double measure_ns(uint64_t iterations, F&& fn)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        fn(i);
+    }
+    clobber_memory();
+
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() /
+           static_cast<double>(iterations);
+}
+
+inline void print_header(std::string_view title)
+{
+    std::printf("\n== %.*s ==\n", static_cast<int>(title.size()), title.data());
+}
+
+inline void print_row(std::string_view name, double ns, double extra, std::string_view extra_label)
+{
+    std::printf("%-40.*s %10.2f ns  %10.3f %.*s\n", static_cast<int>(name.size()), name.data(), ns,
+                extra, static_cast<int>(extra_label.size()), extra_label.data());
+}
+
+} // namespace slog::bench
+
+#endif // SLOG_BENCH_UTILS_HPP
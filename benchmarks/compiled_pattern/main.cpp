@@ -0,0 +1,63 @@
+///
+/// @file compiled_pattern/main.cpp
+/// @brief Runtime PatternFormatter against patterns compiled with slog::fmt::compiled_pattern.
+///
+/// The runtime formatter loops over its steps and calls every flag through the flag table, a
+/// compiled pattern is a straight-line function sized once for the whole output.
+///
+
+#include <chrono>
+#include <string>
+#include <string_view>
+
+#include <slog/fmt/pattern_formatter.hpp>
+
+#include <common/bench_utils.hpp>
+
+namespace
+{
+
+constexpr uint64_t ITERATIONS = 5'000'000;
+
+template<slog::fmt::PatternString Pattern>
+void bench(std::string_view name)
+{
+    slog::fmt::PatternFormatter runtime(Pattern.view());
+    slog::fmt::PatternFormatter compiled(slog::fmt::compiled_pattern<Pattern>);
+    slog::LogRecord record;
+    std::string dest;
+
+    record.level = slog::LogLevel::INFO;
+    record.logger_name = "bench";
+    record.string_buffer = "request 42 served in 12.5us";
+    record.location = std::source_location::current();
+    record.thread_id = 1;
+
+    auto base = std::chrono::system_clock::now();
+    auto run = [&](const slog::fmt::PatternFormatter& formatter) {
+        return slog::bench::measure_ns(ITERATIONS, [&](uint64_t i) {
+            // One new second every 1000 records
+            record.timestamp = base + std::chrono::milliseconds(i);
+            dest.clear();
+            formatter.format(record, dest);
+            slog::bench::do_not_optimize(dest.data());
+        });
+    };
+    double runtime_ns = run(runtime);
+    double compiled_ns = run(compiled);
+
+    slog::bench::print_row(std::string(name) + " [runtime]", runtime_ns, 1.0, "x");
+    slog::bench::print_row(std::string(name) + " [compiled]", compiled_ns, runtime_ns / compiled_ns,
+                           "x faster");
+}
+
+} // namespace
+
+int main()
+{
+    slog::bench::print_header("Format one record");
+    bench<"[%Y-%m-%d %H:%M:%S.%e] [%l] %v\n">("default");
+    bench<"%H:%M:%S.%f [%L] [%n] [%t] %s:%# %v\n">("source location");
+    bench<"[%l] %v\n">("level + message");
+    return 0;
+}
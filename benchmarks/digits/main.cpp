@@ -0,0 +1,129 @@
+///
+/// @file digits/main.cpp
+/// @brief Timestamp prefix "YYYY-MM-DD HH:MM:SS.mmm" rendered with the numeric kernels.
+///
+/// std::to_chars plus zero padding per field (the former flag implementation) against the two
+/// digits table per field and the table date followed by the packed clock block.
+///
+
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+#include <slog/fmt/digits.hpp>
+
+#include <common/bench_utils.hpp>
+
+namespace
+{
+
+constexpr uint64_t ITERATIONS = 20'000'000;
+constexpr size_t PREFIX_WIDTH = 23;
+
+struct Fields
+{
+    uint32_t year, month, day, hour, minute, second, millis;
+};
+
+// Varied fields so the kernels cannot be folded, a power of two for cheap indexing
+std::array<Fields, 4096> make_fields()
+{
+    std::array<Fields, 4096> fields{};
+    std::mt19937 rng(42);
+
+    auto next = [&](uint32_t bound) { return static_cast<uint32_t>(rng() % bound); };
+
+    for (Fields& f : fields) {
+        f = {1970 + next(300), 1 + next(12), 1 + next(31), next(24), next(60), next(60), next(1000)};
+    }
+    return fields;
+}
+
+char* to_chars_padded(char* out, uint32_t value, int width)
+{
+    char buf[10];
+    std::to_chars_result result = std::to_chars(buf, buf + sizeof(buf), value);
+    int digits = static_cast<int>(result.ptr - buf);
+
+    for (; digits < width; width--) {
+        *out++ = '0';
+    }
+    std::memcpy(out, buf, static_cast<size_t>(result.ptr - buf));
+    return out + (result.ptr - buf);
+}
+
+char* render_to_chars(char* out, const Fields& f)
+{
+    out = to_chars_padded(out, f.year, 4);
+    *out++ = '-';
+    out = to_chars_padded(out, f.month, 2);
+    *out++ = '-';
+    out = to_chars_padded(out, f.day, 2);
+    *out++ = ' ';
+    out = to_chars_padded(out, f.hour, 2);
+    *out++ = ':';
+    out = to_chars_padded(out, f.minute, 2);
+    *out++ = ':';
+    out = to_chars_padded(out, f.second, 2);
+    *out++ = '.';
+    return to_chars_padded(out, f.millis, 3);
+}
+
+char* render_date(char* out, const Fields& f)
+{
+    out = slog::fmt::detail::write_fixed<4>(out, f.year);
+    *out++ = '-';
+    out = slog::fmt::detail::write_fixed<2>(out, f.month);
+    *out++ = '-';
+    out = slog::fmt::detail::write_fixed<2>(out, f.day);
+    *out++ = ' ';
+    return out;
+}
+
+char* render_pairs(char* out, const Fields& f)
+{
+    out = render_date(out, f);
+    out = slog::fmt::detail::write_fixed<2>(out, f.hour);
+    *out++ = ':';
+    out = slog::fmt::detail::write_fixed<2>(out, f.minute);
+    *out++ = ':';
+    out = slog::fmt::detail::write_fixed<2>(out, f.second);
+    *out++ = '.';
+    return slog::fmt::detail::write_fixed<3>(out, f.millis);
+}
+
+char* render_clock(char* out, const Fields& f)
+{
+    out = render_date(out, f);
+    return slog::fmt::detail::write_clock(out, f.hour, f.minute, f.second, f.millis);
+}
+
+template<typename Render>
+double bench(const std::array<Fields, 4096>& fields, Render render)
+{
+    char buf[PREFIX_WIDTH];
+
+    return slog::bench::measure_ns(ITERATIONS, [&](uint64_t i) {
+        render(buf, fields[i & (fields.size() - 1)]);
+        slog::bench::do_not_optimize(buf);
+    });
+}
+
+} // namespace
+
+int main()
+{
+    std::array<Fields, 4096> fields = make_fields();
+
+    slog::bench::print_header("Timestamp prefix, YYYY-MM-DD HH:MM:SS.mmm");
+    double to_chars_ns = bench(fields, render_to_chars);
+    double pairs_ns = bench(fields, render_pairs);
+    double clock_ns = bench(fields, render_clock);
+
+    slog::bench::print_row("to_chars + padding", to_chars_ns, 1.0, "x");
+    slog::bench::print_row("digit pairs", pairs_ns, to_chars_ns / pairs_ns, "x faster");
+    slog::bench::print_row("digit pairs + clock block", clock_ns, to_chars_ns / clock_ns, "x faster");
+    return 0;
+}
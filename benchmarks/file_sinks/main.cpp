@@ -0,0 +1,109 @@
+///
+/// @file file_sinks/main.cpp
+/// @brief FileSink against UringFileSink (io_uring and its pwrite fallback), on tmpfs and on a
+/// real filesystem.
+///
+/// Lines are written the way the async worker writes them, in batches, with an explicit flush
+/// now and then. FileSink blocks in a write syscall every time its stdio buffer fills and in
+/// fflush; UringFileSink copies the lines into a chunk and submits full chunks (and the
+/// partial one on flush) without waiting for them. The batch latency percentiles show where
+/// the writer blocks, the throughput includes closing the sink, i.e. until every write
+/// completed. Usage:
+///
+///     slog_bench_file_sinks [<directory>...]
+///
+/// Default directories: /dev/shm (tmpfs) and the current directory.
+///
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <slog/sinks/file_sink.hpp>
+#include <slog/sinks/uring_file_sink.hpp>
+
+#include <common/bench_utils.hpp>
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t RECORDS = 500'000;
+constexpr size_t BATCH_SIZE = 64;
+constexpr size_t FLUSH_EVERY = 64 * 1024;
+
+void bench(std::string_view name, std::unique_ptr<slog::sinks::ISink> sink)
+{
+    std::string line = "2024-01-01 12:00:00.000000 [INFO] bench: request 123456 served by worker-03 in 12.5us\n";
+    std::vector<double> latencies;
+    Clock::time_point begin = Clock::now();
+
+    latencies.reserve(RECORDS / BATCH_SIZE);
+    for (size_t i = 0; i < RECORDS; i += BATCH_SIZE) {
+        Clock::time_point batch_begin = Clock::now();
+
+        for (size_t j = 0; j < BATCH_SIZE; j++) {
+            sink->log(line);
+        }
+        if ((i + BATCH_SIZE) % FLUSH_EVERY == 0) {
+            sink->flush();
+        }
+        latencies.push_back(std::chrono::duration<double, std::nano>(Clock::now() - batch_begin).count());
+    }
+    sink.reset();
+
+    double seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+
+    std::sort(latencies.begin(), latencies.end());
+
+    double p99 = latencies[static_cast<size_t>(0.99 * static_cast<double>(latencies.size() - 1))];
+
+    std::printf("%-46.*s %8.1f MB/s  batch p50 %7.0f ns  p99 %8.0f ns  max %10.0f ns\n",
+                static_cast<int>(name.size()), name.data(),
+                static_cast<double>(RECORDS * line.size()) / seconds / 1e6, latencies[latencies.size() / 2],
+                p99, latencies.back());
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::vector<std::filesystem::path> directories;
+
+    for (int i = 1; i < argc; i++) {
+        directories.emplace_back(argv[i]);
+    }
+    if (directories.empty()) {
+        directories = {"/dev/shm", std::filesystem::current_path()};
+    }
+
+    for (const std::filesystem::path& directory : directories) {
+        std::error_code error;
+        std::string path = (directory / "slog_bench_file_sinks.log").string();
+
+        if (!std::filesystem::is_directory(directory, error)) {
+            std::printf("\n%s: not a directory, skipped\n", directory.string().c_str());
+            continue;
+        }
+        slog::bench::print_header(directory.string() + ", " + std::to_string(RECORDS) + " lines in batches of " +
+                                  std::to_string(BATCH_SIZE) + ", flush every " + std::to_string(FLUSH_EVERY));
+        bench("FileSink", std::make_unique<slog::sinks::FileSink>("file", path));
+
+        auto uring = std::make_unique<slog::sinks::UringFileSink>("uring", path);
+        std::string name = "UringFileSink [" + std::string(slog::sinks::to_string(uring->get_backend())) + "]";
+
+        bench(name, std::move(uring));
+        bench("UringFileSink [pwrite]",
+              std::make_unique<slog::sinks::UringFileSink>(
+                  "uring", path, slog::sinks::UringFileOptions{.io_uring = false}));
+        std::filesystem::remove(path, error);
+    }
+    return 0;
+}
@@ -0,0 +1,132 @@
+///
+/// @file idle_strategy/main.cpp
+/// @brief Wake-up latency, producer cost and CPU use of the worker idle strategies.
+///
+/// Records are sparse: the worker runs out of records between them and waits with its idle
+/// strategy. Latency is push to sink write. Producer cost is the mean push of bursts reaching
+/// an idle worker. CPU is the process CPU time over the wall time of the run (100% is one core).
+/// Spinning needs a core of its own, on a single core machine it competes with the producer.
+///
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <slog/async/worker.hpp>
+
+#include <common/bench_utils.hpp>
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t SAMPLES = 2000;
+constexpr size_t BURSTS = 500;
+constexpr size_t BURST_SIZE = 32;
+constexpr auto GAP = std::chrono::microseconds(200);
+
+std::atomic<Clock::rep> pushed_at{0};
+std::atomic<uint64_t> written{0};
+std::vector<double> latencies;
+
+// Measures the delay since the last push, written by the worker thread only
+class LatencySink : public slog::sinks::ISink
+{
+public:
+    explicit LatencySink(std::string_view name) : ISink(name) {}
+
+    void flush() override {}
+
+private:
+    void _write(std::string_view) override
+    {
+        Clock::rep now = Clock::now().time_since_epoch().count();
+
+        latencies.push_back(static_cast<double>(now - pushed_at.load(std::memory_order_relaxed)));
+        written.fetch_add(1, std::memory_order_release);
+    }
+};
+
+slog::LogRecord make_record()
+{
+    slog::LogRecord record;
+
+    record.level = slog::LogLevel::INFO;
+    record.thread_id = 0;
+    record.format_str = "sparse record";
+    return record;
+}
+
+double percentile(std::vector<double> values, double p)
+{
+    std::sort(values.begin(), values.end());
+    return values[static_cast<size_t>(p * static_cast<double>(values.size() - 1))];
+}
+
+void bench(std::string_view name, slog::async::IdleStrategy idle)
+{
+    auto manager = std::make_shared<slog::sinks::SinkManager>(std::make_shared<LatencySink>("latency"));
+    slog::async::Worker worker(idle);
+    slog::async::ManagerHandle handle = worker.attach(manager);
+
+    manager->set_pattern("%v");
+    latencies.clear();
+    latencies.reserve(SAMPLES + BURSTS * BURST_SIZE);
+    written.store(0);
+
+    std::clock_t cpu_begin = std::clock();
+    Clock::time_point wall_begin = Clock::now();
+
+    // Push to write latency, one record at a time
+    for (size_t i = 0; i < SAMPLES; i++) {
+        pushed_at.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+        worker.push(slog::async::AsyncOp{make_record(), handle});
+        while (written.load(std::memory_order_acquire) < i + 1) {
+            std::this_thread::yield();
+        }
+        std::this_thread::sleep_for(GAP);
+    }
+    std::vector<double> sparse = latencies;
+
+    // Producer side of bursts, the first push of each burst finds the worker idle
+    double push_ns = 0.0;
+    for (size_t b = 0; b < BURSTS; b++) {
+        Clock::time_point begin = Clock::now();
+
+        for (size_t i = 0; i < BURST_SIZE; i++) {
+            worker.push(slog::async::AsyncOp{make_record(), handle});
+        }
+        push_ns += std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+        std::this_thread::sleep_for(GAP);
+    }
+    while (worker.dispatched() < SAMPLES + BURSTS * BURST_SIZE) {
+        std::this_thread::yield();
+    }
+
+    double wall = std::chrono::duration<double>(Clock::now() - wall_begin).count();
+    double cpu = static_cast<double>(std::clock() - cpu_begin) / CLOCKS_PER_SEC;
+
+    std::printf("%-24.*s p50 %8.0f ns  p99 %9.0f ns  push %6.1f ns  cpu %5.1f%%\n",
+                static_cast<int>(name.size()), name.data(), percentile(sparse, 0.5),
+                percentile(sparse, 0.99), push_ns / (BURSTS * BURST_SIZE), 100.0 * cpu / wall);
+}
+
+} // namespace
+
+int main()
+{
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    slog::bench::print_header("Sparse records, 200us apart");
+    bench("block", slog::async::IdleStrategy::block());
+    bench("backoff (default)", slog::async::IdleStrategy::backoff());
+    bench("backoff (64, 0)", slog::async::IdleStrategy::backoff(64, 0));
+    bench("spin", slog::async::IdleStrategy::spin());
+    return 0;
+}
@@ -0,0 +1,223 @@
+///
+/// @file mpsc_layout/main.cpp
+/// @brief Cache misses per record of the MPSC queue slot layouts.
+///
+/// Producers push records shaped like the ones built by a log call while the calling thread
+/// pops them, once with the split layout (sequence on its own cacheline after the record) and
+/// once with the packed one (sequence in the record's first line, slots prefetched ahead).
+/// Hardware counters are read through perf_event_open for the whole process, user space only,
+/// like `perf stat -e cache-misses,L1-dcache-load-misses`. Where they are not available
+/// (other OS, VM without a PMU, perf_event_paranoid > 2) only the throughput is printed.
+///
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+#include <slog/async/async_op.hpp>
+#include <slog/async/mpsc_queue.hpp>
+#include <slog/async/policies.hpp>
+#include <slog/fmt/deferred_format.hpp>
+
+#include <common/bench_utils.hpp>
+
+namespace
+{
+
+constexpr size_t RECORDS_PER_PRODUCER = 500'000;
+constexpr size_t MPSC_SLOTS = 8192;
+
+template<slog::async::SlotLayout Layout>
+using Queue = slog::async::MPSCQueue<slog::async::AsyncOp, MPSC_SLOTS, slog::async::BlockOnFull, Layout>;
+
+// One hardware counter, inherited by the threads created while it is enabled. Their counts
+// are added to it when they exit.
+class PerfCounter
+{
+public:
+    PerfCounter(uint32_t type, uint64_t config)
+    {
+#ifdef __linux__
+        perf_event_attr attr{};
+
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        _fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+        (void)type;
+        (void)config;
+#endif
+    }
+
+    ~PerfCounter()
+    {
+#ifdef __linux__
+        if (_fd >= 0) {
+            ::close(_fd);
+        }
+#endif
+    }
+
+    PerfCounter(const PerfCounter&) = delete;
+    PerfCounter& operator=(const PerfCounter&) = delete;
+
+    [[nodiscard]] bool valid() const noexcept { return _fd >= 0; }
+
+    void start() noexcept
+    {
+#ifdef __linux__
+        if (valid()) {
+            ::ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+            ::ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    void stop() noexcept
+    {
+#ifdef __linux__
+        if (valid()) {
+            ::ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+#endif
+    }
+
+    [[nodiscard]] uint64_t value() const noexcept
+    {
+        uint64_t count = 0;
+
+#ifdef __linux__
+        if (valid() && ::read(_fd, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count))) {
+            count = 0;
+        }
+#endif
+        return count;
+    }
+
+private:
+    int _fd{-1};
+};
+
+#ifdef __linux__
+constexpr uint32_t HW = PERF_TYPE_HARDWARE;
+constexpr uint32_t HW_CACHE = PERF_TYPE_HW_CACHE;
+constexpr uint64_t CACHE_MISSES = PERF_COUNT_HW_CACHE_MISSES;
+constexpr uint64_t L1D_READ_MISSES =
+    PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+#else
+constexpr uint32_t HW = 0;
+constexpr uint32_t HW_CACHE = 0;
+constexpr uint64_t CACHE_MISSES = 0;
+constexpr uint64_t L1D_READ_MISSES = 0;
+#endif
+
+slog::async::AsyncOp make_op(size_t thread, size_t i)
+{
+    slog::async::AsyncOp op;
+
+    op.record.level = slog::LogLevel::INFO;
+    op.record.logger_name = "bench";
+    op.record.format_str = "request {} served by {} in {}us";
+    op.record.thread_id = thread;
+    op.record.format_fn = &slog::fmt::format_deferred<size_t, std::string_view, double>;
+    slog::fmt::store_args<size_t, std::string_view, double>(
+        op.record.stored_args, i, std::string_view("worker-03"), 12.5);
+    return op;
+}
+
+void print_misses(const PerfCounter& counter, double records)
+{
+    if (counter.valid()) {
+        std::printf("  %8.3f", static_cast<double>(counter.value()) / records);
+    }
+    else {
+        std::printf("  %8s", "n/a");
+    }
+}
+
+template<slog::async::SlotLayout Layout>
+void bench(std::string_view name, size_t producers)
+{
+    auto queue = std::make_unique<Queue<Layout>>();
+    PerfCounter cache_misses(HW, CACHE_MISSES);
+    PerfCounter l1d_misses(HW_CACHE, L1D_READ_MISSES);
+    std::atomic<bool> start{false};
+    std::vector<std::thread> threads;
+    size_t total = producers * RECORDS_PER_PRODUCER;
+    size_t consumed = 0;
+    slog::async::AsyncOp out;
+
+    // Enabled before the producers exist so they inherit the counters
+    cache_misses.start();
+    l1d_misses.start();
+    for (size_t t = 0; t < producers; t++) {
+        threads.emplace_back([&, t]() {
+            while (!start.load(std::memory_order_acquire));
+            for (size_t i = 0; i < RECORDS_PER_PRODUCER; i++) {
+                queue->push(make_op(t, i));
+            }
+        });
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+
+    start.store(true, std::memory_order_release);
+    while (consumed < total) {
+        if (queue->pop(out)) {
+            slog::bench::do_not_optimize(out.record.args());
+            consumed++;
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    for (auto& t : threads) {
+        t.join();
+    }
+    cache_misses.stop();
+    l1d_misses.stop();
+
+    auto records = static_cast<double>(total);
+    std::string label = std::string(name) + " [" + std::to_string(producers) + " producers]";
+
+    std::printf("%-28s %5zu B/slot %12.0f rec/s", label.c_str(), Queue<Layout>::slot_size(),
+                records / std::chrono::duration<double>(end - begin).count());
+    print_misses(cache_misses, records);
+    print_misses(l1d_misses, records);
+    std::printf("\n");
+}
+
+} // namespace
+
+int main()
+{
+    std::printf("sizeof(AsyncOp) = %zu, prefetch distance = %d slots\n", sizeof(slog::async::AsyncOp),
+                SLOG_MPSC_PREFETCH_DISTANCE);
+    slog::bench::print_header("MPSCQueue<AsyncOp> slot layouts, misses per record: cache-misses  L1D-load-misses");
+    for (size_t producers : {1, 4}) {
+        bench<slog::async::SlotLayout::SPLIT>("split", producers);
+        bench<slog::async::SlotLayout::PACKED>("packed", producers);
+    }
+    return 0;
+}
@@ -0,0 +1,181 @@
+///
+/// @file pattern_format/main.cpp
+/// @brief Two-phase PatternFormatter against step by step appending, for every built-in flag.
+///
+/// PatternFormatter sizes the output once and writes it through a cursor, literals live in one
+/// arena. The baseline is the previous formatter: a std::string per literal step and an
+/// append (capacity check, possible reallocation) per step.
+///
+
+#include <chrono>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <slog/fmt/pattern_formatter.hpp>
+
+#include <common/bench_utils.hpp>
+
+namespace
+{
+
+constexpr uint64_t ITERATIONS = 2'000'000;
+
+// Previous formatter, for reference: runs of literals and date/time flags up to the second are
+// re-rendered once per second into the literal of a step
+class AppendingFormatter
+{
+public:
+    explicit AppendingFormatter(std::string_view pattern)
+    {
+        std::vector<Step> parsed;
+        std::string literal;
+
+        for (size_t i = 0; i < pattern.size(); i++) {
+            if (pattern[i] == '%' && i + 1 < pattern.size() &&
+                slog::fmt::BUILTIN_FLAGS[static_cast<uint8_t>(pattern[i + 1])]) {
+                _flush(parsed, literal);
+                parsed.push_back({pattern[++i], {}, {}});
+            }
+            else {
+                literal.push_back(pattern[i]);
+            }
+        }
+        _flush(parsed, literal);
+
+        for (size_t i = 0; i < parsed.size();) {
+            size_t end = i;
+            bool has_time = false;
+
+            while (end < parsed.size() && (parsed[end].flag == '\0' || _is_time(parsed[end].flag))) {
+                has_time = has_time || parsed[end].flag != '\0';
+                end++;
+            }
+            if (!has_time) {
+                _steps.push_back(std::move(parsed[i++]));
+                continue;
+            }
+            _steps.push_back({'\0', {}, {parsed.begin() + i, parsed.begin() + end}});
+            i = end;
+        }
+    }
+
+    void format(const slog::LogRecord& record, std::string& dest) const
+    {
+        slog::fmt::FormatContext ctx(record, _time_cache);
+
+        if (_time_cache.second() != _rendered_second) {
+            for (Step& step : _steps) {
+                if (!step.segment.empty()) {
+                    step.literal.clear();
+                    _append(step.segment, ctx, step.literal);
+                }
+            }
+            _rendered_second = _time_cache.second();
+        }
+        _append(_steps, ctx, dest);
+    }
+
+private:
+    struct Step
+    {
+        char flag;
+        std::string literal;
+        std::vector<Step> segment;
+    };
+
+    static bool _is_time(char flag) { return std::string_view("YmdHMS").find(flag) != std::string_view::npos; }
+
+    static void _flush(std::vector<Step>& steps, std::string& literal)
+    {
+        if (!literal.empty()) {
+            steps.push_back({'\0', literal, {}});
+            literal.clear();
+        }
+    }
+
+    static void _append(const std::vector<Step>& steps, const slog::fmt::FormatContext& ctx,
+                        std::string& dest)
+    {
+        for (const Step& step : steps) {
+            if (step.flag == '\0') {
+                dest.append(step.literal);
+            }
+            else {
+                slog::fmt::BUILTIN_FLAGS[static_cast<uint8_t>(step.flag)](ctx, dest);
+            }
+        }
+    }
+
+    mutable std::vector<Step> _steps;
+    mutable slog::fmt::TimeCache _time_cache;
+    mutable int64_t _rendered_second{std::numeric_limits<int64_t>::min()};
+};
+
+slog::LogRecord make_record()
+{
+    slog::LogRecord record;
+
+    record.level = slog::LogLevel::INFO;
+    record.logger_name = "bench";
+    record.string_buffer = "request 42 served in 12.5us";
+    record.location = std::source_location::current();
+    record.thread_id = 1;
+    return record;
+}
+
+// `fresh`: a new string per record, as records moved through the queues
+template<typename Formatter>
+double format_ns(const Formatter& formatter, bool fresh)
+{
+    slog::LogRecord record = make_record();
+    auto base = std::chrono::system_clock::now();
+    std::string dest;
+
+    return slog::bench::measure_ns(ITERATIONS, [&](uint64_t i) {
+        // One new second every 1000 records
+        record.timestamp = base + std::chrono::milliseconds(i);
+        if (fresh) {
+            std::string message;
+            formatter.format(record, message);
+            slog::bench::do_not_optimize(message.data());
+            return;
+        }
+        dest.clear();
+        formatter.format(record, dest);
+        slog::bench::do_not_optimize(dest.data());
+    });
+}
+
+void bench(std::string_view name, std::string_view pattern, bool fresh)
+{
+    double appending = format_ns(AppendingFormatter(pattern), fresh);
+    double sized = format_ns(slog::fmt::PatternFormatter(pattern), fresh);
+
+    slog::bench::print_row(std::string(name) + (fresh ? " [new string]" : " [reused string]"), sized,
+                           appending / sized, "x faster than appending");
+}
+
+} // namespace
+
+int main()
+{
+    slog::bench::print_header("Every flag: \"[%l] [%X] %v\\n\"");
+    for (size_t c = 0; c < slog::fmt::BUILTIN_FLAGS.size(); c++) {
+        if (slog::fmt::BUILTIN_FLAGS[c]) {
+            std::string flag = std::string("%") + static_cast<char>(c);
+
+            for (bool fresh : {false, true}) {
+                bench(flag, "[%l] [" + flag + "] %v\n", fresh);
+            }
+        }
+    }
+
+    slog::bench::print_header("Full patterns");
+    for (bool fresh : {false, true}) {
+        bench("default", "[%Y-%m-%d %H:%M:%S.%e] [%l] %v\n", fresh);
+        bench("source location", "%H:%M:%S.%f [%L] [%n] [%t] %s:%# %! %v\n", fresh);
+    }
+    return 0;
+}
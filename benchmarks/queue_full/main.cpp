@@ -0,0 +1,108 @@
+///
+/// @file queue_full/main.cpp
+/// @brief Producer latency and lost records of the queue-full policies during a log storm.
+///
+/// A producer pushes records far faster than a slow sink writes them, so the queue stays full.
+/// One record in eight is a WARNING, the others are DEBUG. Push latency is measured per record,
+/// lost records are the ones the worker reports as dropped.
+///
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <slog/async/worker.hpp>
+
+#include <common/bench_utils.hpp>
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t RECORDS = 200000;
+constexpr auto WRITE_COST = std::chrono::microseconds(2);
+
+// Busy waits on every write, the worker can't keep up with the producer
+class SlowSink : public slog::sinks::ISink
+{
+public:
+    explicit SlowSink(std::string_view name) : ISink(name) {}
+
+    void flush() override {}
+
+private:
+    void _write(std::string_view) override
+    {
+        Clock::time_point end = Clock::now() + WRITE_COST;
+
+        while (Clock::now() < end) {
+        }
+    }
+};
+
+slog::LogRecord make_record(size_t i)
+{
+    slog::LogRecord record;
+
+    record.level = i % 8 == 0 ? slog::LogLevel::WARNING : slog::LogLevel::DEBUG;
+    record.thread_id = 0;
+    record.format_str = "storm record";
+    return record;
+}
+
+double percentile(std::vector<double>& values, double p)
+{
+    std::sort(values.begin(), values.end());
+    return values[static_cast<size_t>(p * static_cast<double>(values.size() - 1))];
+}
+
+void bench(std::string_view name, slog::async::QueueFullPolicy policy)
+{
+    auto manager = std::make_shared<slog::sinks::SinkManager>(std::make_shared<SlowSink>("slow"));
+    std::vector<double> latencies(RECORDS);
+    double total_ns = 0.0;
+    uint64_t dropped = 0;
+
+    manager->set_pattern("%v");
+    {
+        slog::async::Worker worker;
+        slog::async::ManagerHandle handle = worker.attach(manager, "storm");
+
+        worker.set_queue_full_policy(policy);
+        Clock::time_point begin = Clock::now();
+
+        for (size_t i = 0; i < RECORDS; i++) {
+            Clock::time_point push_begin = Clock::now();
+
+            worker.push(slog::async::AsyncOp{make_record(i), handle});
+            latencies[i] = std::chrono::duration<double, std::nano>(Clock::now() - push_begin).count();
+        }
+        total_ns = std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+        dropped = worker.dropped();
+    }
+
+    double max = *std::max_element(latencies.begin(), latencies.end());
+
+    std::printf("%-24.*s p50 %7.0f ns  p99 %9.0f ns  max %10.0f ns  total %7.1f ms  dropped %6.2f%%\n",
+                static_cast<int>(name.size()), name.data(), percentile(latencies, 0.5),
+                percentile(latencies, 0.99), max, total_ns / 1e6,
+                100.0 * static_cast<double>(dropped) / RECORDS);
+}
+
+} // namespace
+
+int main()
+{
+    slog::bench::print_header("Log storm, 200k records into a 2us/write sink");
+    bench("block", slog::async::QueueFullPolicy::block());
+    bench("discard", slog::async::QueueFullPolicy::discard());
+    bench("drop oldest", slog::async::QueueFullPolicy::drop_oldest());
+    bench("drop by level (75%)", slog::async::QueueFullPolicy::drop_by_level());
+    bench("wait 10us", slog::async::QueueFullPolicy::wait_for(std::chrono::microseconds(10)));
+    return 0;
+}
@@ -0,0 +1,119 @@
+///
+/// @file queue_memory/main.cpp
+/// @brief First burst latency of the async queues by page backing and prefault.
+///
+/// A fresh queue is filled once, the way the first log burst of a process fills it. Without
+/// prefault the pages of the byte ring are faulted in by the pushes, the MPSC ring already
+/// writes every slot when it is built. Huge pages fall back to regular ones when the system
+/// has none to give, the backing actually used is printed.
+///
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include <slog/async/async_op.hpp>
+#include <slog/async/byte_ring_queue.hpp>
+#include <slog/async/mpsc_queue.hpp>
+#include <slog/async/policies.hpp>
+#include <slog/async/queue_memory.hpp>
+
+#include <common/bench_utils.hpp>
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t MPSC_SLOTS = 1 << 16;
+constexpr size_t RING_BYTES = 1 << 26;
+constexpr size_t ENTRY_SIZE = 240; // a block of 256 bytes with its header
+
+using SlotQueue = slog::async::MPSCQueue<slog::async::AsyncOp, 8192, slog::async::DiscardOnFull>;
+using RingQueue = slog::async::ByteRingQueue<1 << 20, slog::async::DiscardOnFull>;
+
+struct Config
+{
+    std::string_view name;
+    bool huge_pages;
+    bool prefault;
+};
+
+constexpr Config CONFIGS[] = {
+    {"regular", false, false},
+    {"regular + prefault", false, true},
+    {"huge pages", true, false},
+    {"huge pages + prefault", true, true},
+};
+
+double elapsed_us(Clock::time_point begin)
+{
+    return std::chrono::duration<double, std::micro>(Clock::now() - begin).count();
+}
+
+void print_result(std::string_view name, double build_us, std::vector<double>& latencies,
+                  const slog::async::QueueMemory& memory)
+{
+    std::sort(latencies.begin(), latencies.end());
+
+    double p99 = latencies[static_cast<size_t>(0.99 * static_cast<double>(latencies.size() - 1))];
+    std::string_view backing = slog::async::to_string(memory.backing);
+
+    std::printf("%-24.*s build %9.0f us  push p50 %6.0f ns  p99 %7.0f ns  max %9.0f ns  %6zu KiB  %.*s\n",
+                static_cast<int>(name.size()), name.data(), build_us, latencies[latencies.size() / 2], p99,
+                latencies.back(), memory.bytes / 1024, static_cast<int>(backing.size()), backing.data());
+}
+
+void bench_slots(const Config& config)
+{
+    slog::async::QueueOptions options{.capacity = MPSC_SLOTS, .huge_pages = config.huge_pages, .prefault = config.prefault};
+    std::vector<double> latencies(MPSC_SLOTS);
+    Clock::time_point begin = Clock::now();
+    SlotQueue queue(options);
+    double build_us = elapsed_us(begin);
+
+    for (size_t i = 0; i < MPSC_SLOTS; i++) {
+        Clock::time_point push_begin = Clock::now();
+
+        queue.push(slog::async::AsyncOp{});
+        latencies[i] = std::chrono::duration<double, std::nano>(Clock::now() - push_begin).count();
+    }
+    print_result(config.name, build_us, latencies, queue.memory());
+}
+
+void bench_ring(const Config& config)
+{
+    constexpr size_t entries = RING_BYTES / (ENTRY_SIZE + RingQueue::HEADER_SIZE);
+    slog::async::QueueOptions options{.capacity = RING_BYTES, .huge_pages = config.huge_pages, .prefault = config.prefault};
+    std::vector<double> latencies(entries);
+    char payload[ENTRY_SIZE] = {};
+    Clock::time_point begin = Clock::now();
+    RingQueue queue(options);
+    double build_us = elapsed_us(begin);
+
+    for (size_t i = 0; i < entries; i++) {
+        Clock::time_point push_begin = Clock::now();
+
+        queue.push(ENTRY_SIZE, [&](std::byte* dst) { std::memcpy(dst, payload, ENTRY_SIZE); });
+        latencies[i] = std::chrono::duration<double, std::nano>(Clock::now() - push_begin).count();
+    }
+    print_result(config.name, build_us, latencies, queue.memory());
+}
+
+} // namespace
+
+int main()
+{
+    slog::bench::print_header("MPSCQueue<AsyncOp>, first fill of 65536 slots");
+    for (const Config& config : CONFIGS) {
+        bench_slots(config);
+    }
+    slog::bench::print_header("ByteRingQueue, first fill of 64 MiB in 256 byte entries");
+    for (const Config& config : CONFIGS) {
+        bench_ring(config);
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+///
+/// @file registry_lookup/main.cpp
+/// @brief Cost of looking up a logger by name with hundreds of loggers registered.
+///
+/// Registry::get_logger reads an immutable hashed index without locks, SLOG_GET_LOGGER caches
+/// the result per call site. The baseline is the previous lookup: a mutex and a linear scan.
+///
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <slog/slog.hpp>
+
+#include <common/bench_utils.hpp>
+
+namespace
+{
+
+constexpr size_t LOGGERS = 300;
+constexpr uint64_t ITERATIONS = 2'000'000;
+
+// Previous lookup, for reference
+class LinearRegistry
+{
+public:
+    explicit LinearRegistry(const std::vector<std::shared_ptr<slog::Logger>>& loggers)
+        : _loggers(loggers)
+    {
+    }
+
+    slog::Logger& get(std::string_view name)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        for (auto& logger : _loggers) {
+            if (logger->get_name() == name) {
+                return *logger;
+            }
+        }
+        return *_loggers.front();
+    }
+
+private:
+    std::vector<std::shared_ptr<slog::Logger>> _loggers;
+    std::mutex _mutex;
+};
+
+template<typename F>
+double threaded_rate(size_t threads, F&& lookup)
+{
+    std::vector<std::thread> workers;
+    auto begin = std::chrono::steady_clock::now();
+
+    for (size_t t = 0; t < threads; t++) {
+        workers.emplace_back([&]() {
+            for (uint64_t i = 0; i < ITERATIONS; i++) {
+                slog::bench::do_not_optimize(&lookup());
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    return static_cast<double>(threads * ITERATIONS) /
+           std::chrono::duration<double>(end - begin).count();
+}
+
+} // namespace
+
+int main()
+{
+    std::vector<std::shared_ptr<slog::Logger>> loggers;
+
+    for (size_t i = 0; i < LOGGERS; i++) {
+        loggers.push_back(slog::Registry::instance().create_logger("service_" + std::to_string(i)));
+    }
+
+    LinearRegistry linear(loggers);
+    auto mutex_scan = [&]() -> slog::Logger& { return linear.get("service_150"); };
+    auto hashed = []() -> slog::Logger& {
+        return slog::Registry::instance().get_logger("service_150");
+    };
+    auto cached = []() -> slog::Logger& { return SLOG_GET_LOGGER("service_150"); };
+
+    slog::bench::print_header("Lookup of a logger among " + std::to_string(LOGGERS));
+    double scan_ns = slog::bench::measure_ns(ITERATIONS, [&](uint64_t) {
+        slog::bench::do_not_optimize(&mutex_scan());
+    });
+    double hashed_ns = slog::bench::measure_ns(ITERATIONS, [&](uint64_t) {
+        slog::bench::do_not_optimize(&hashed());
+    });
+    double cached_ns = slog::bench::measure_ns(ITERATIONS, [&](uint64_t) {
+        slog::bench::do_not_optimize(&cached());
+    });
+
+    slog::bench::print_row("mutex + linear scan (previous)", scan_ns, 1.0, "x");
+    slog::bench::print_row("get_logger (hashed index)", hashed_ns, scan_ns / hashed_ns, "x faster");
+    slog::bench::print_row("SLOG_GET_LOGGER (call site cache)", cached_ns, scan_ns / cached_ns,
+                           "x faster");
+
+    slog::bench::print_header("Lookups from 4 threads");
+    std::printf("mutex + linear scan %14.0f lookups/s\n", threaded_rate(4, mutex_scan));
+    std::printf("hashed index        %14.0f lookups/s\n", threaded_rate(4, hashed));
+    std::printf("call site cache     %14.0f lookups/s\n", threaded_rate(4, cached));
+    return 0;
+}
@@ -0,0 +1,101 @@
+///
+/// @file sink_fanout/main.cpp
+/// @brief Dispatch of one logger record to several sinks.
+///
+/// Sinks are grouped by pattern and every group is rendered once per record: sinks sharing the
+/// logger pattern, sinks sharing a pattern of their own, one pattern per sink, and sinks whose
+/// level drops the record (nothing is rendered).
+///
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <slog/fmt/deferred_format.hpp>
+#include <slog/sinks/sink_manager.hpp>
+
+#include <common/bench_utils.hpp>
+
+namespace
+{
+
+constexpr uint64_t ITERATIONS = 2'000'000;
+constexpr std::string_view PATTERN = "[%Y-%m-%d %H:%M:%S.%e] [%l] [%n] [thread %t] %v";
+
+class NullSink : public slog::sinks::ISink
+{
+public:
+    explicit NullSink(std::string_view name) : ISink(name) {}
+
+    void flush() override {}
+
+private:
+    void _write(std::string_view message) override { slog::bench::do_not_optimize(message.size()); }
+};
+
+enum class Setup
+{
+    LOGGER_PATTERN,
+    SHARED_SINK_PATTERN,
+    PATTERN_PER_SINK,
+    FILTERED
+};
+
+double bench(size_t sinks, Setup setup)
+{
+    slog::sinks::SinkManager manager;
+    std::vector<std::shared_ptr<slog::sinks::ISink>> owned;
+
+    manager.set_pattern(PATTERN);
+    for (size_t i = 0; i < sinks; i++) {
+        owned.push_back(std::make_shared<NullSink>("null_" + std::to_string(i)));
+        switch (setup) {
+        case Setup::LOGGER_PATTERN:
+            owned.back()->set_pattern(PATTERN);
+            break;
+        case Setup::SHARED_SINK_PATTERN:
+            owned.back()->set_pattern("[%H:%M:%S.%e] [%l] %v");
+            break;
+        case Setup::PATTERN_PER_SINK:
+            owned.back()->set_pattern("[%H:%M:%S.%e] [%l] " + std::to_string(i) + " %v");
+            break;
+        case Setup::FILTERED:
+            owned.back()->set_level(slog::LogLevel::WARNING);
+            break;
+        }
+        manager.add_sink(owned.back());
+    }
+
+    slog::LogRecord record;
+    record.level = slog::LogLevel::INFO;
+    record.logger_name = "bench";
+    record.format_str = "request {} served";
+    record.format_fn = &slog::fmt::format_deferred<uint64_t>;
+
+    return slog::bench::measure_ns(ITERATIONS, [&](uint64_t i) {
+        slog::fmt::store_args<uint64_t>(record.stored_args, i);
+        manager.dispatch(record);
+    });
+}
+
+} // namespace
+
+int main()
+{
+    slog::bench::print_header("Fan-out of one record, per record");
+    for (size_t sinks : {1, 4, 6}) {
+        std::string label = std::to_string(sinks) + " sinks";
+        double dispatch;
+
+        dispatch = bench(sinks, Setup::LOGGER_PATTERN);
+        slog::bench::print_row(label + ", logger pattern", dispatch, dispatch / sinks, "ns/sink");
+        dispatch = bench(sinks, Setup::SHARED_SINK_PATTERN);
+        slog::bench::print_row(label + ", one sink pattern", dispatch, dispatch / sinks, "ns/sink");
+        dispatch = bench(sinks, Setup::PATTERN_PER_SINK);
+        slog::bench::print_row(label + ", pattern per sink", dispatch, dispatch / sinks, "ns/sink");
+        dispatch = bench(sinks, Setup::FILTERED);
+        slog::bench::print_row(label + ", level filtered", dispatch, dispatch / sinks, "ns/sink");
+    }
+    return 0;
+}
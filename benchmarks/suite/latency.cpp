@@ -0,0 +1,67 @@
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <slog/slog.hpp>
+
+#include "suite.hpp"
+
+namespace slog::bench
+{
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+// Time spent by the calling thread in every call, the record is written (sync) or queued (async)
+template<typename Log>
+std::vector<double> measure(uint64_t calls, Log&& log)
+{
+    std::vector<double> latencies(calls);
+
+    for (uint64_t i = 0; i < calls; i++) {
+        Clock::time_point begin = Clock::now();
+
+        log(i);
+        latencies[i] = std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+    }
+    return latencies;
+}
+
+std::shared_ptr<slog::Logger> make_logger(const std::string& name)
+{
+    std::shared_ptr<slog::Logger> logger = slog::Registry::instance().create_logger(name);
+
+    logger->add_sink(std::make_shared<NullSink>("null"));
+    return logger;
+}
+
+} // namespace
+
+void run_latency(const Options& options, Report& report)
+{
+    const uint64_t calls = 20'000 * options.scale;
+
+    {
+        std::shared_ptr<slog::Logger> logger = make_logger("bench_latency_format");
+        std::vector<double> latencies = measure(calls, [&](uint64_t i) {
+            logger->info("request {} served by {} in {}us", i, "worker-03", 12.5);
+        });
+
+        report.add({"latency", "format syntax, null sink", latency_metrics(latencies)});
+        wait_drained();
+    }
+    {
+        std::shared_ptr<slog::Logger> logger = make_logger("bench_latency_stream");
+        std::vector<double> latencies = measure(calls, [&](uint64_t i) {
+            SLOG_INFO_L(logger) << "request " << i << " served by " << "worker-03" << " in " << 12.5 << "us";
+        });
+
+        report.add({"latency", "stream syntax, null sink", latency_metrics(latencies)});
+        wait_drained();
+    }
+}
+
+} // namespace slog::bench
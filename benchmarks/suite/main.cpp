@@ -0,0 +1,119 @@
+///
+/// @file suite/main.cpp
+/// @brief Logging benchmark suite: producer latency, end-to-end throughput, pattern flags and
+/// MPSC queue scaling, with the results written as JSON to compare runs.
+///
+/// The logging mode is a build choice: `slog_bench` measures the sync mode, `slog_bench_async`
+/// the async one, run both to compare them. Usage:
+///
+///     slog_bench [--json <file>|-] [--threads <n>] [--quick] [--filter <group>]
+///
+/// Groups: latency, throughput, pattern, queue.
+///
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "suite.hpp"
+
+namespace
+{
+
+void usage(const char* program)
+{
+    std::fprintf(stderr,
+                 "usage: %s [--json <file>|-] [--threads <n>] [--quick] [--filter <group>]\n"
+                 "  --json     write the results as JSON to <file>, '-' for stdout\n"
+                 "  --threads  highest thread count of the scaling runs (default: cores, up to 8)\n"
+                 "  --quick    ten times fewer records\n"
+                 "  --filter   run only the groups containing <group>: latency, throughput, pattern, queue\n",
+                 program);
+}
+
+bool write_json(const std::string& path, const std::string& json)
+{
+    if (path == "-") {
+        std::fputs(json.c_str(), stdout);
+        return true;
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "w");
+
+    if (!file) {
+        return false;
+    }
+
+    bool written = std::fwrite(json.data(), 1, json.size(), file) == json.size();
+
+    return std::fclose(file) == 0 && written;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    slog::bench::Options options;
+    std::string json_path;
+
+    options.max_threads = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, 8);
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg = argv[i];
+        bool has_value = i + 1 < argc;
+
+        if (arg == "--json" && has_value) {
+            json_path = argv[++i];
+        }
+        else if (arg == "--threads" && has_value) {
+            options.max_threads = std::max<size_t>(std::strtoul(argv[++i], nullptr, 10), 1);
+        }
+        else if (arg == "--quick") {
+            options.scale = 1;
+        }
+        else if (arg == "--filter" && has_value) {
+            options.filter = argv[++i];
+        }
+        else {
+            usage(argv[0]);
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+#ifdef SLOG_ASYNC_ENABLED
+    constexpr std::string_view mode = "async";
+#else
+    constexpr std::string_view mode = "sync";
+#endif
+    slog::bench::Report report;
+    auto selected = [&](std::string_view group) {
+        return options.filter.empty() || group.find(options.filter) != std::string_view::npos;
+    };
+
+    if (selected("latency")) {
+        slog::bench::run_latency(options, report);
+    }
+    if (selected("throughput")) {
+        slog::bench::run_throughput(options, report);
+    }
+    if (selected("pattern")) {
+        slog::bench::run_pattern(options, report);
+    }
+    if (selected("queue")) {
+        slog::bench::run_queue(options, report);
+    }
+
+    // Left out when the JSON goes to stdout
+    if (json_path != "-") {
+        std::printf("mode: %.*s\n", static_cast<int>(mode.size()), mode.data());
+        report.print_table();
+    }
+    if (!json_path.empty() && !write_json(json_path, report.to_json(mode))) {
+        std::fprintf(stderr, "failed to write %s\n", json_path.c_str());
+        return 1;
+    }
+    return 0;
+}
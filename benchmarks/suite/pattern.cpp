@@ -0,0 +1,57 @@
+#include <chrono>
+#include <source_location>
+#include <string>
+#include <string_view>
+
+#include <slog/fmt/format_flags.hpp>
+#include <slog/fmt/pattern_formatter.hpp>
+
+#include "suite.hpp"
+
+namespace slog::bench
+{
+
+namespace
+{
+
+constexpr std::string_view DEFAULT_PATTERN = "[%Y-%m-%d %H:%M:%S.%e] [%l] %v\n";
+
+double format_ns(std::string_view pattern, uint64_t iterations)
+{
+    slog::fmt::PatternFormatter formatter(pattern);
+    slog::LogRecord record;
+    auto base = std::chrono::system_clock::now();
+    std::string dest;
+
+    record.level = slog::LogLevel::INFO;
+    record.logger_name = "bench";
+    record.string_buffer = "request 42 served in 12.5us";
+    record.location = std::source_location::current();
+    record.thread_id = 1;
+    return measure_ns(iterations, [&](uint64_t i) {
+        // One new second every 1000 records
+        record.timestamp = base + std::chrono::milliseconds(i);
+        dest.clear();
+        formatter.format(record, dest);
+        do_not_optimize(dest.data());
+    });
+}
+
+} // namespace
+
+// PatternFormatter::format of a pattern made of the flag alone, then of the default pattern
+void run_pattern(const Options& options, Report& report)
+{
+    const uint64_t iterations = 100'000 * options.scale;
+
+    for (size_t c = 0; c < slog::fmt::BUILTIN_FLAGS.size(); c++) {
+        if (slog::fmt::BUILTIN_FLAGS[c]) {
+            std::string flag = std::string("%") + static_cast<char>(c);
+
+            report.add({"pattern", flag, {{"ns_per_record", format_ns(flag, iterations)}}});
+        }
+    }
+    report.add({"pattern", "default pattern", {{"ns_per_record", format_ns(DEFAULT_PATTERN, iterations)}}});
+}
+
+} // namespace slog::bench
@@ -0,0 +1,95 @@
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <slog/async/async_op.hpp>
+#include <slog/async/mpsc_queue.hpp>
+#include <slog/async/policies.hpp>
+#include <slog/fmt/deferred_format.hpp>
+
+#include "suite.hpp"
+
+namespace slog::bench
+{
+
+namespace
+{
+
+using Queue = slog::async::MPSCQueue<slog::async::AsyncOp, SLOG_MPSC_QUEUE_SIZE, slog::async::BlockOnFull>;
+
+slog::async::AsyncOp make_op(size_t thread, uint64_t i)
+{
+    slog::async::AsyncOp op;
+
+    op.record.level = slog::LogLevel::INFO;
+    op.record.logger_name = "bench";
+    op.record.format_str = "request {} served by {} in {}us";
+    op.record.thread_id = thread;
+    op.record.format_fn = &slog::fmt::format_deferred<uint64_t, std::string_view, double>;
+    slog::fmt::store_args<uint64_t, std::string_view, double>(op.record.stored_args, i,
+                                                              std::string_view("worker-03"), 12.5);
+    return op;
+}
+
+// `producers` threads push, the calling thread pops like a worker would
+double records_per_second(size_t producers, uint64_t records)
+{
+    auto queue = std::make_unique<Queue>();
+    std::atomic<bool> start{false};
+    std::vector<std::thread> threads;
+    uint64_t per_producer = records / producers;
+    uint64_t total = per_producer * producers;
+    uint64_t consumed = 0;
+    slog::async::AsyncOp out;
+
+    for (size_t t = 0; t < producers; t++) {
+        threads.emplace_back([&, t]() {
+            while (!start.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (uint64_t i = 0; i < per_producer; i++) {
+                queue->push(make_op(t, i));
+            }
+        });
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+
+    start.store(true, std::memory_order_release);
+    while (consumed < total) {
+        if (queue->pop(out)) {
+            do_not_optimize(out.record.args());
+            consumed++;
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return static_cast<double>(total) / seconds;
+}
+
+} // namespace
+
+void run_queue(const Options& options, Report& report)
+{
+    const uint64_t records = 50'000 * options.scale;
+
+    for (size_t producers : thread_counts(options.max_threads)) {
+        std::string name = "MPSCQueue push/pop, " + std::to_string(producers) +
+                           (producers == 1 ? " producer" : " producers");
+
+        report.add({"queue", name, {{"records_per_sec", records_per_second(producers, records)}}});
+    }
+}
+
+} // namespace slog::bench
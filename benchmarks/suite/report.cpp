@@ -0,0 +1,109 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <format>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include "suite.hpp"
+
+namespace slog::bench
+{
+
+namespace
+{
+
+void append_string(std::string& out, std::string_view text)
+{
+    out.push_back('"');
+    for (char c : text) {
+        switch (c) {
+        case '"': out.append("\\\""); break;
+        case '\\': out.append("\\\\"); break;
+        case '\n': out.append("\\n"); break;
+        case '\t': out.append("\\t"); break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                std::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<unsigned>(c));
+            }
+            else {
+                out.push_back(c);
+            }
+        }
+    }
+    out.push_back('"');
+}
+
+std::string_view compiler() noexcept
+{
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc";
+#else
+    return "unknown";
+#endif
+}
+
+} // namespace
+
+void Report::add(Result result)
+{
+    _results.push_back(std::move(result));
+}
+
+void Report::print_table() const
+{
+    std::string_view group;
+
+    for (const Result& result : _results) {
+        if (result.group != group) {
+            group = result.group;
+            print_header(group);
+        }
+        std::printf("%-36s", result.name.c_str());
+        for (const Metric& metric : result.metrics) {
+            std::printf("  %s %.1f", metric.name.c_str(), metric.value);
+        }
+        std::printf("\n");
+    }
+}
+
+std::string Report::to_json(std::string_view mode) const
+{
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    std::string out = "{\n  \"suite\": \"slog_bench\",\n  \"mode\": ";
+
+    append_string(out, mode);
+    out.append(",\n  \"compiler\": ");
+    append_string(out, compiler());
+    std::format_to(std::back_inserter(out), ",\n  \"timestamp\": {},\n  \"results\": [",
+                   std::chrono::duration_cast<std::chrono::seconds>(now).count());
+    for (size_t i = 0; i < _results.size(); i++) {
+        const Result& result = _results[i];
+
+        out.append(i == 0 ? "\n    {\"group\": " : ",\n    {\"group\": ");
+        append_string(out, result.group);
+        out.append(", \"name\": ");
+        append_string(out, result.name);
+        for (const Metric& metric : result.metrics) {
+            out.append(", ");
+            append_string(out, metric.name);
+            // JSON has no nan or infinity (e.g. a rate over a zero duration)
+            if (std::isfinite(metric.value)) {
+                std::format_to(std::back_inserter(out), ": {:.3f}", metric.value);
+            }
+            else {
+                out.append(": null");
+            }
+        }
+        out.push_back('}');
+    }
+    out.append("\n  ]\n}\n");
+    return out;
+}
+
+} // namespace slog::bench
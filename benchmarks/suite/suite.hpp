@@ -0,0 +1,121 @@
+#ifndef SLOG_BENCH_SUITE_HPP
+#define SLOG_BENCH_SUITE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <slog/sinks/isink.hpp>
+#include <slog/slog.hpp>
+
+#include <common/bench_utils.hpp>
+
+namespace slog::bench
+{
+
+struct Options
+{
+    size_t max_threads{4};  // throughput and queue scaling go 1, 2, 4 ... up to it
+    uint64_t scale{10};     // record counts are multiplied by it, 1 for a quick run
+    std::string filter;     // runs only the groups containing it
+};
+
+struct Metric
+{
+    std::string name;
+    double value;
+};
+
+// One measured case, `group` is the scenario it belongs to
+struct Result
+{
+    std::string group;
+    std::string name;
+    std::vector<Metric> metrics;
+};
+
+class Report
+{
+public:
+    void add(Result result);
+
+    void print_table() const;
+
+    // Stable layout, one result per line: runs can be diffed as text or loaded as JSON
+    [[nodiscard]] std::string to_json(std::string_view mode) const;
+
+private:
+    std::vector<Result> _results;
+};
+
+// Discards every message, only the formatting and dispatch are measured
+class NullSink : public slog::sinks::ISink
+{
+public:
+    explicit NullSink(std::string_view name) : ISink(name) {}
+
+    void flush() override {}
+
+private:
+    void _write(std::string_view message) override { do_not_optimize(message.size()); }
+};
+
+// p50, p99, p99.9, max and mean of `values`, sorts them
+inline std::vector<Metric> latency_metrics(std::vector<double>& values)
+{
+    std::sort(values.begin(), values.end());
+
+    auto at = [&](double p) { return values[static_cast<size_t>(p * static_cast<double>(values.size() - 1))]; };
+    double sum = 0.0;
+
+    for (double value : values) {
+        sum += value;
+    }
+    return {{"p50_ns", at(0.5)},
+            {"p99_ns", at(0.99)},
+            {"p999_ns", at(0.999)},
+            {"max_ns", values.back()},
+            {"mean_ns", sum / static_cast<double>(values.size())}};
+}
+
+// Async: waits for the workers to dispatch every record pushed so far. Sync: returns at once.
+inline void wait_drained()
+{
+    auto drained = [] {
+        for (const slog::async::WorkerStats& stats : slog::Registry::instance().get_worker_stats()) {
+            if (stats.dequeued + stats.dropped < stats.enqueued) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    while (!drained()) {
+        std::this_thread::yield();
+    }
+}
+
+// Thread counts 1, 2, 4 ... up to `max`, `max` included
+inline std::vector<size_t> thread_counts(size_t max)
+{
+    std::vector<size_t> counts;
+
+    for (size_t n = 1; n < max; n *= 2) {
+        counts.push_back(n);
+    }
+    counts.push_back(max);
+    return counts;
+}
+
+void run_latency(const Options& options, Report& report);
+void run_throughput(const Options& options, Report& report);
+void run_pattern(const Options& options, Report& report);
+void run_queue(const Options& options, Report& report);
+
+} // namespace slog::bench
+
+#endif // SLOG_BENCH_SUITE_HPP
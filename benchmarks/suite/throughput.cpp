@@ -0,0 +1,106 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <slog/sinks/console_sink.hpp>
+#include <slog/sinks/file_sink.hpp>
+#include <slog/sinks/mmap_file_sink.hpp>
+#include <slog/slog.hpp>
+
+#include "suite.hpp"
+
+namespace slog::bench
+{
+
+namespace
+{
+
+#ifdef _WIN32
+constexpr const char* NULL_DEVICE = "NUL";
+#else
+constexpr const char* NULL_DEVICE = "/dev/null";
+#endif
+
+// From the first call until every record is written and the sinks are flushed
+double records_per_second(slog::Logger& logger, size_t threads, uint64_t records)
+{
+    std::atomic<bool> start{false};
+    std::vector<std::thread> producers;
+    uint64_t per_thread = records / threads;
+
+    for (size_t t = 0; t < threads; t++) {
+        producers.emplace_back([&]() {
+            while (!start.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (uint64_t i = 0; i < per_thread; i++) {
+                logger.info("request {} served by {} in {}us", i, "worker-03", 12.5);
+            }
+        });
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+
+    start.store(true, std::memory_order_release);
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    wait_drained();
+    logger.flush();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    return static_cast<double>(per_thread * threads) / seconds;
+}
+
+void run_sink(const Options& options, Report& report, std::string_view kind,
+              const std::shared_ptr<slog::sinks::ISink>& sink)
+{
+    const uint64_t records = 20'000 * options.scale;
+
+    for (size_t threads : thread_counts(options.max_threads)) {
+        std::string name = std::string(kind) + " sink, " + std::to_string(threads) +
+                           (threads == 1 ? " thread" : " threads");
+        std::shared_ptr<slog::Logger> logger =
+            slog::Registry::instance().create_logger("bench_throughput_" + std::string(kind) + "_" +
+                                                     std::to_string(threads));
+
+        logger->add_sink(sink);
+        report.add({"throughput", name, {{"records_per_sec", records_per_second(*logger, threads, records)}}});
+        logger->remove_sink(sink->get_name());
+    }
+}
+
+} // namespace
+
+void run_throughput(const Options& options, Report& report)
+{
+    run_sink(options, report, "null", std::make_shared<NullSink>("null"));
+
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "slog_bench_throughput.log";
+    std::error_code error;
+
+    run_sink(options, report, "file", std::make_shared<slog::sinks::FileSink>("file", path.string()));
+    std::filesystem::remove(path, error);
+#if defined(__unix__) || defined(__APPLE__)
+    run_sink(options, report, "mmap", std::make_shared<slog::sinks::MmapFileSink>("mmap", path.string()));
+    std::filesystem::remove(path, error);
+#endif
+
+    // The console sink writes to a FILE*, the null device keeps the terminal out of the measure
+    std::FILE* null_device = std::fopen(NULL_DEVICE, "w");
+
+    if (null_device) {
+        run_sink(options, report, "console", std::make_shared<slog::sinks::ConsoleSink>("console", null_device));
+        std::fclose(null_device);
+    }
+}
+
+} // namespace slog::bench
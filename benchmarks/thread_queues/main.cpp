@@ -0,0 +1,161 @@
+///
+/// @file thread_queues/main.cpp
+/// @brief Producer scaling of the shared MPSC queue against per-thread SPSC rings.
+///
+/// N producers push records while a single consumer drains the queue. Reports the total
+/// throughput and the producer side push latency (mean and p99), which is where the
+/// contention on the shared MPSC head shows up.
+///
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <slog/async/async_op.hpp>
+#include <slog/async/mpsc_queue.hpp>
+#include <slog/async/policies.hpp>
+#include <slog/async/thread_queues.hpp>
+#include <slog/fmt/deferred_format.hpp>
+
+#include <common/bench_utils.hpp>
+
+namespace
+{
+
+constexpr size_t TOTAL_RECORDS = 2'000'000;
+
+using SharedQueue =
+    slog::async::MPSCQueue<slog::async::AsyncOp, SLOG_MPSC_QUEUE_SIZE, slog::async::BlockOnFull>;
+using PerThreadQueues =
+    slog::async::ThreadQueues<slog::async::AsyncOp, SLOG_SPSC_QUEUE_SIZE, slog::async::BlockOnFull>;
+
+struct Result
+{
+    double records_per_sec;
+    double mean_ns;
+    double p99_ns;
+};
+
+slog::async::AsyncOp make_op(size_t thread, size_t i)
+{
+    slog::async::AsyncOp op;
+
+    op.record.level = slog::LogLevel::INFO;
+    op.record.format_str = "request {} served by thread {}";
+    op.record.thread_id = thread;
+    op.record.timestamp = std::chrono::system_clock::now();
+    op.record.format_fn = &slog::fmt::format_deferred<size_t, size_t>;
+    slog::fmt::store_args<size_t, size_t>(op.record.stored_args, i, thread);
+    return op;
+}
+
+template<typename Push, typename Pop>
+Result run(size_t producers, Push&& push, Pop&& pop)
+{
+    size_t per_producer = TOTAL_RECORDS / producers;
+    size_t total = per_producer * producers;
+    std::vector<std::vector<double>> latencies(producers);
+    std::atomic<bool> start{false};
+    std::vector<std::thread> threads;
+    size_t consumed = 0;
+
+    for (size_t t = 0; t < producers; t++) {
+        latencies[t].resize(per_producer);
+        threads.emplace_back([&, t]() {
+            while (!start.load(std::memory_order_acquire));
+            for (size_t i = 0; i < per_producer; i++) {
+                slog::async::AsyncOp op = make_op(t, i);
+                auto begin = std::chrono::steady_clock::now();
+
+                push(std::move(op));
+                latencies[t][i] = std::chrono::duration<double, std::nano>(
+                                      std::chrono::steady_clock::now() - begin)
+                                      .count();
+            }
+        });
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    while (consumed < total) {
+        if (pop()) {
+            consumed++;
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    std::vector<double> all;
+    double sum = 0.0;
+
+    all.reserve(total);
+    for (auto& l : latencies) {
+        all.insert(all.end(), l.begin(), l.end());
+    }
+    for (double ns : all) {
+        sum += ns;
+    }
+    std::nth_element(all.begin(), all.begin() + static_cast<long>(total * 99 / 100), all.end());
+
+    return {static_cast<double>(total) / std::chrono::duration<double>(end - begin).count(),
+            sum / static_cast<double>(total), all[total * 99 / 100]};
+}
+
+void print_result(std::string_view name, size_t producers, const Result& r)
+{
+    std::printf("%-24.*s %4zu producers  %12.0f rec/s  mean %8.1f ns  p99 %10.1f ns\n",
+                static_cast<int>(name.size()), name.data(), producers, r.records_per_sec,
+                r.mean_ns, r.p99_ns);
+}
+
+void bench(size_t producers)
+{
+    {
+        auto queue = std::make_unique<SharedQueue>();
+        slog::async::AsyncOp out;
+        Result r = run(
+            producers, [&](slog::async::AsyncOp&& op) { queue->push(std::move(op)); },
+            [&]() { return queue->pop(out); });
+
+        print_result("MPSCQueue", producers, r);
+    }
+    {
+        auto queues = std::make_unique<PerThreadQueues>();
+        slog::async::AsyncOp out;
+        Result r = run(
+            producers, [&](slog::async::AsyncOp&& op) { queues->push(std::move(op)); },
+            [&]() {
+                return queues->pop(out, [](const slog::async::AsyncOp& op) {
+                    return op.record.timestamp;
+                });
+            });
+
+        print_result("ThreadQueues", producers, r);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    size_t max_producers = std::max<size_t>(4, std::thread::hardware_concurrency());
+
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    slog::bench::print_header("Producer scaling");
+    for (size_t producers = 1; producers <= max_producers; producers *= 2) {
+        bench(producers);
+    }
+    return 0;
+}
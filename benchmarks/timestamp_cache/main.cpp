@@ -0,0 +1,94 @@
+///
+/// @file timestamp_cache/main.cpp
+/// @brief Cost of the default pattern with and without a cached timestamp prefix.
+///
+/// PatternFormatter renders the date/time prefix once per second and only patches the
+/// sub-second field per record. Moving every record to a new second forces a localtime call
+/// and the full prefix rendering each time, which is what every record used to pay.
+/// With several threads (sync mode, one formatter each) localtime also contends on the tz lock.
+///
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <slog/fmt/pattern_formatter.hpp>
+
+#include <common/bench_utils.hpp>
+
+namespace
+{
+
+constexpr uint64_t ITERATIONS = 1'000'000;
+
+slog::LogRecord make_record()
+{
+    slog::LogRecord record;
+
+    record.level = slog::LogLevel::INFO;
+    record.logger_name = "bench";
+    record.thread_id = 1;
+    record.string_buffer = "request 42 served in 12.5us";
+    record.timestamp = std::chrono::system_clock::now();
+    return record;
+}
+
+// Mean ns per record, `step` is added to the timestamp after every record
+double format_ns(std::chrono::system_clock::duration step)
+{
+    slog::fmt::PatternFormatter formatter;
+    slog::LogRecord record = make_record();
+    std::string dest;
+
+    return slog::bench::measure_ns(ITERATIONS, [&](uint64_t) {
+        dest.clear();
+        formatter.format(record, dest);
+        slog::bench::do_not_optimize(dest);
+        record.timestamp += step;
+    });
+}
+
+// Records per second over `threads` threads, each with its own formatter
+double threaded_rate(size_t threads, std::chrono::system_clock::duration step)
+{
+    std::vector<std::thread> workers;
+    auto begin = std::chrono::steady_clock::now();
+
+    for (size_t t = 0; t < threads; t++) {
+        workers.emplace_back([step]() { format_ns(step); });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    return static_cast<double>(threads * ITERATIONS) /
+           std::chrono::duration<double>(end - begin).count();
+}
+
+} // namespace
+
+int main()
+{
+    constexpr auto SAME_SECOND = std::chrono::nanoseconds{100};
+    constexpr auto NEW_SECOND = std::chrono::seconds{1};
+
+    slog::bench::print_header("Default pattern \"[%Y-%m-%d %H:%M:%S.%e] [%l] %v\\n\"");
+    double miss = format_ns(NEW_SECOND);
+    double hit = format_ns(SAME_SECOND);
+
+    slog::bench::print_row("new second every record", miss, 1.0, "x");
+    slog::bench::print_row("same second (cached prefix)", hit, miss / hit, "x faster");
+
+    slog::bench::print_header("Formatter per thread");
+    for (size_t threads : {1, 4}) {
+        double miss_rate = threaded_rate(threads, NEW_SECOND);
+        double hit_rate = threaded_rate(threads, SAME_SECOND);
+
+        std::printf("%2zu threads  new second %12.0f rec/s  cached %12.0f rec/s  %5.2fx\n",
+                    threads, miss_rate, hit_rate, hit_rate / miss_rate);
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+///
+/// @file worker_pool/main.cpp
+/// @brief Throughput scaling of the async backend with the number of workers.
+///
+/// Every logger writes to its own sink and is pinned to its own worker, one producer thread
+/// per logger. Formatting and sink I/O then run in parallel, so the throughput should grow
+/// close to linearly with the workers until the cores run out.
+///
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <slog/async/worker_pool.hpp>
+#include <slog/slog.hpp>
+
+#include <common/bench_utils.hpp>
+
+namespace
+{
+
+constexpr size_t RECORDS_PER_LOGGER = 300'000;
+
+// Formats like a real sink, then throws the text away
+class NullSink : public slog::sinks::ISink
+{
+public:
+    NullSink(std::string_view name) : ISink(name) {}
+
+    void flush() override {}
+
+protected:
+    void _write(std::string_view message) override { slog::bench::do_not_optimize(message); }
+};
+
+double run(size_t workers)
+{
+    slog::async::WorkerPool pool(workers);
+    std::vector<std::shared_ptr<slog::async::Worker>> assigned;
+    std::vector<slog::async::ManagerHandle> handles;
+    std::atomic<bool> start{false};
+    std::vector<std::thread> producers;
+
+    for (size_t i = 0; i < workers; i++) {
+        auto manager = std::make_shared<slog::sinks::SinkManager>(
+            std::make_shared<NullSink>("null_" + std::to_string(i)));
+
+        manager->set_pattern("[%T] [%l] [%n] %v");
+        assigned.push_back(pool.pin(i));
+        handles.push_back(assigned.back()->attach(manager));
+    }
+    for (size_t i = 0; i < workers; i++) {
+        producers.emplace_back([&, i]() {
+            while (!start.load(std::memory_order_acquire));
+            for (size_t n = 0; n < RECORDS_PER_LOGGER; n++) {
+                slog::LogRecord record;
+
+                record.level = slog::LogLevel::INFO;
+                record.logger_name = "bench";
+                record.timestamp = std::chrono::system_clock::now();
+                record.format_str = "order {} filled at {} for client {}";
+                record.format_fn = &slog::fmt::format_deferred<size_t, double, std::string_view>;
+                slog::fmt::store_args<size_t, double, std::string_view>(
+                    record.stored_args, n, 101.25, std::string_view("acme"));
+                assigned[i]->push(slog::async::AsyncOp{std::move(record), handles[i]});
+            }
+        });
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    for (auto& p : producers) {
+        p.join();
+    }
+    for (auto& worker : assigned) {
+        while (worker->dispatched() < RECORDS_PER_LOGGER) {
+            std::this_thread::yield();
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    return static_cast<double>(workers * RECORDS_PER_LOGGER) /
+           std::chrono::duration<double>(end - begin).count();
+}
+
+} // namespace
+
+int main()
+{
+    size_t max_workers = std::max<size_t>(4, std::thread::hardware_concurrency() / 2);
+    double baseline = 0.0;
+
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    slog::bench::print_header("Independent loggers, one worker each");
+    for (size_t workers = 1; workers <= max_workers; workers *= 2) {
+        double rate = run(workers);
+
+        if (workers == 1) {
+            baseline = rate;
+        }
+        std::printf("%4zu workers  %12.0f rec/s  speedup %5.2fx\n", workers, rate,
+                    rate / baseline);
+    }
+    return 0;
+}
@@ -1,15 +1,22 @@
 #ifndef SLOG_ASYNC_ASYNC_OP_HPP
 #define SLOG_ASYNC_ASYNC_OP_HPP
 
+#include <cstdint>
+
 #include <slog/core/log_record.hpp>
-#include <slog/sinks/sink_manager.hpp>
 
 namespace slog::async
 {
+
+// Index of a sink manager in the ManagerTable of the worker the record is pushed to
+using ManagerHandle = uint32_t;
+
 struct AsyncOp
 {
     slog::LogRecord record;
-    std::shared_ptr<slog::sinks::SinkManager> sink_manager;
+    ManagerHandle manager{0};
+    // ManagerTable epoch read by the producer before pushing, see ManagerTable
+    uint64_t epoch{0};
 };
 } // namespace slog::async
 
@@ -0,0 +1,282 @@
+#ifndef SLOG_ASYNC_BYTE_RING_QUEUE_HPP
+#define SLOG_ASYNC_BYTE_RING_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <thread>
+
+#include <slog/async/common.hpp>
+#include <slog/async/queue_memory.hpp>
+#include <slog/config_macros.hpp>
+#include <slog/details/macros.hpp>
+
+namespace slog::async
+{
+
+// Multi producer single consumer queue of variable-length entries stored back to back in a
+// contiguous byte ring. Every entry is a block header followed by the payload, an entry never
+// wraps around the end of the ring (a padding block is inserted instead).
+//
+// Producers serialize only the space claim (a few instructions under a spinlock), payloads
+// are written and committed concurrently. The consumer reads entries in place in FIFO order.
+template<size_t Size, typename Policy>
+class ByteRingQueue
+{
+    static_assert((Size != 0) && ((Size & (Size - 1)) == 0),
+                  "ByteRingQueue::Size must be a power of 2");
+
+    struct BlockHeader
+    {
+        std::atomic<uint32_t> state;
+        uint32_t block_size;   // header + aligned payload (+ padding blocks)
+        uint32_t payload_size; // bytes requested by the producer
+    };
+
+    static constexpr uint32_t READY = 0;
+    static constexpr uint32_t BUSY = 1;
+    static constexpr uint32_t PADDING = 2;
+
+public:
+    static constexpr size_t ALIGNMENT = alignof(std::max_align_t);
+    static constexpr size_t HEADER_SIZE = (sizeof(BlockHeader) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    static constexpr size_t MIN_SIZE = 4 * HEADER_SIZE;
+
+    static_assert(Size >= MIN_SIZE, "ByteRingQueue::Size is too small");
+
+    ByteRingQueue() : ByteRingQueue(QueueOptions{}) {}
+
+    // Size is the capacity (bytes) unless `options.capacity` is set
+    explicit ByteRingQueue(const QueueOptions& options)
+        : _size(detail::ring_capacity(options.capacity, Size, MIN_SIZE)),
+          _mask(_size - 1),
+          _memory(_size, options),
+          _buffer(static_cast<std::byte*>(_memory.data()))
+    {
+    }
+
+    ByteRingQueue(const ByteRingQueue&) = delete;
+    ByteRingQueue& operator=(const ByteRingQueue&) = delete;
+
+    // `write(std::byte*)` fills the `size` bytes reserved for the entry
+    template<typename Writer>
+    SLOG_ALWAYS_INLINE bool push(size_t size, Writer&& write)
+    {
+        return Policy::push(*this, size, std::forward<Writer>(write));
+    }
+
+    // Pushes with another policy than the queue's one (e.g. chosen at runtime)
+    template<typename Writer, typename P>
+    SLOG_ALWAYS_INLINE bool push(size_t size, Writer&& write, const P& policy)
+    {
+        return policy.push(*this, size, std::forward<Writer>(write));
+    }
+
+    // `consume(std::byte* data, size_t size)` is called in place on the oldest committed entry
+    template<typename F>
+    bool pop(F&& consume)
+    {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+
+        while (true) {
+            if (tail == _consumer_head) {
+                // Only touch the producers' cacheline once the known entries are drained
+                _consumer_head = _head.load(std::memory_order_acquire);
+                if (tail == _consumer_head) {
+                    return false;
+                }
+            }
+            BlockHeader* header = _header(tail);
+            uint32_t state = header->state.load(std::memory_order_acquire);
+
+            if (state == BUSY) {
+                // Keep FIFO order, the entry is still being written
+                return false;
+            }
+            if (state == READY) {
+                consume(reinterpret_cast<std::byte*>(header) + HEADER_SIZE,
+                        static_cast<size_t>(header->payload_size));
+            }
+            tail += header->block_size;
+            _tail.store(tail, std::memory_order_release);
+            if (state == READY) {
+                return true;
+            }
+        }
+    }
+
+    // Consumer side: true only if every reserved entry has been consumed
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_relaxed);
+    }
+
+    // Calls `visit(std::byte* data, size_t size)` on up to `max` committed entries in FIFO order
+    // without releasing them, returns the number of entries visited. The entries stay valid
+    // until release().
+    template<typename F>
+    size_t peek(size_t max, F&& visit)
+    {
+        size_t position = _tail.load(std::memory_order_relaxed);
+        size_t count = 0;
+
+        while (count < max) {
+            if (position == _consumer_head) {
+                _consumer_head = _head.load(std::memory_order_acquire);
+                if (position == _consumer_head) {
+                    break;
+                }
+            }
+
+            BlockHeader* header = _header(position);
+            uint32_t state = header->state.load(std::memory_order_acquire);
+
+            if (state == BUSY) {
+                break;
+            }
+            if (state == READY) {
+                visit(reinterpret_cast<std::byte*>(header) + HEADER_SIZE,
+                      static_cast<size_t>(header->payload_size));
+                count++;
+            }
+            position += header->block_size;
+        }
+        _peek_end = position;
+        return count;
+    }
+
+    // Gives back to the producers the entries visited by the last peek()
+    void release() noexcept { _tail.store(_peek_end, std::memory_order_release); }
+
+    [[nodiscard]] bool try_reserve(Reservation& r, size_t size)
+    {
+        size_t block_size = HEADER_SIZE + _align(size);
+
+        if (size > max_payload()) [[unlikely]] {
+            return false;
+        }
+
+        _lock();
+
+        size_t head = _head.load(std::memory_order_relaxed);
+        size_t offset = head & _mask;
+
+        if (offset + block_size > _size) {
+            size_t padding = _size - offset;
+
+            if (!_has_space(head, padding)) {
+                _unlock();
+                return false;
+            }
+            // The padding block is published even if the entry doesn't fit yet, the consumer
+            // just skips it
+            _write_header(head, PADDING, padding, 0);
+            head += padding;
+            _head.store(head, std::memory_order_release);
+        }
+        if (!_has_space(head, block_size)) {
+            _unlock();
+            return false;
+        }
+        _write_header(head, BUSY, block_size, size);
+        _head.store(head + block_size, std::memory_order_release);
+
+        _unlock();
+
+        r.index = head;
+        r.data = _buffer + (head & _mask) + HEADER_SIZE;
+        r.size = size;
+        return true;
+    }
+
+    // Waits for space, fails only if `size` can never fit
+    [[nodiscard]] bool reserve(Reservation& r, size_t size)
+    {
+        if (size > max_payload()) [[unlikely]] {
+            return false;
+        }
+        if (!try_reserve(r, size)) [[unlikely]] {
+            detail::WaitTimer timer;
+
+            while (!try_reserve(r, size)) {
+                std::this_thread::yield();
+            }
+        }
+        return true;
+    }
+
+    void commit(const Reservation& r) { _header(r.index)->state.store(READY, std::memory_order_release); }
+
+    // Bytes reserved and not released yet (headers and padding included), a snapshot
+    [[nodiscard]] size_t size_approx() const noexcept
+    {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+
+        return _head.load(std::memory_order_relaxed) - tail;
+    }
+
+    [[nodiscard]] size_t capacity() const noexcept { return _size; }
+
+    // Largest entry the ring can ever hold
+    [[nodiscard]] size_t max_payload() const noexcept { return _size - HEADER_SIZE; }
+
+    [[nodiscard]] const QueueMemory& memory() const noexcept { return _memory.memory(); }
+
+private:
+    SLOG_ALWAYS_INLINE static constexpr size_t _align(size_t size) noexcept
+    {
+        return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    }
+
+    SLOG_ALWAYS_INLINE BlockHeader* _header(size_t position) const noexcept
+    {
+        return std::launder(reinterpret_cast<BlockHeader*>(_buffer + (position & _mask)));
+    }
+
+    SLOG_ALWAYS_INLINE void _write_header(size_t position, uint32_t state, size_t block_size,
+                                          size_t payload_size) noexcept
+    {
+        BlockHeader* header = ::new (static_cast<void*>(_buffer + (position & _mask))) BlockHeader;
+
+        header->block_size = static_cast<uint32_t>(block_size);
+        header->payload_size = static_cast<uint32_t>(payload_size);
+        header->state.store(state, std::memory_order_relaxed);
+    }
+
+    // Called under the claim lock, `_tail` is reloaded only when the cached copy says full
+    SLOG_ALWAYS_INLINE bool _has_space(size_t head, size_t block_size) noexcept
+    {
+        if (head + block_size - _producer_tail <= _size) {
+            return true;
+        }
+        _producer_tail = _tail.load(std::memory_order_acquire);
+        return head + block_size - _producer_tail <= _size;
+    }
+
+    SLOG_ALWAYS_INLINE void _lock() noexcept
+    {
+        while (_claim_flag.test_and_set(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }
+
+    SLOG_ALWAYS_INLINE void _unlock() noexcept { _claim_flag.clear(std::memory_order_release); }
+
+    size_t _size;
+    size_t _mask;
+    QueueBuffer _memory;
+    std::byte* _buffer;
+    SLOG_DISABLE_PADDING_WARNING
+    alignas(SLOG_CACHELINE_SIZE) std::atomic_flag _claim_flag;
+    std::atomic<size_t> _head{0};
+    size_t _producer_tail{0};
+    alignas(SLOG_CACHELINE_SIZE) std::atomic<size_t> _tail{0};
+    size_t _consumer_head{0};
+    size_t _peek_end{0};
+    SLOG_RESTORE_PADDING_WARNING
+};
+
+} // namespace slog::async
+
+#endif // SLOG_ASYNC_BYTE_RING_QUEUE_HPP
@@ -1,14 +1,48 @@
 #ifndef SLOG_ASYNC_COMMON_HPP
 #define SLOG_ASYNC_COMMON_HPP
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
 namespace slog::async
 {
 
 struct Reservation
 {
     size_t index;
+    std::byte* data{nullptr}; // byte queues only: reserved payload
+    size_t size{0};           // byte queues only: reserved payload size
 };
 
+namespace detail
+{
+
+// Time the calling thread spent waiting for room in a queue, moved to the worker stats by push
+inline thread_local uint64_t producer_wait_ns = 0;
+
+// Adds its lifetime to producer_wait_ns, only built on the slow paths where a queue waits
+class WaitTimer
+{
+public:
+    WaitTimer() noexcept : _begin(std::chrono::steady_clock::now()) {}
+
+    WaitTimer(const WaitTimer&) = delete;
+    WaitTimer& operator=(const WaitTimer&) = delete;
+
+    ~WaitTimer()
+    {
+        producer_wait_ns += static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _begin)
+                .count());
+    }
+
+private:
+    std::chrono::steady_clock::time_point _begin;
+};
+
+} // namespace detail
+
 } // namespace slog::async
 
-#endif // SLOG_ASYNC_COMMON_HPP
\ No newline at end of file
+#endif // SLOG_ASYNC_COMMON_HPP
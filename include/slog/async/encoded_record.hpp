@@ -0,0 +1,125 @@
+#ifndef SLOG_ASYNC_ENCODED_RECORD_HPP
+#define SLOG_ASYNC_ENCODED_RECORD_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <source_location>
+#include <string>
+#include <string_view>
+
+#include <slog/async/async_op.hpp>
+#include <slog/core/log_level.hpp>
+#include <slog/core/log_record.hpp>
+#include <slog/fmt/arg_buffer.hpp>
+
+namespace slog::async
+{
+
+// Self-describing record written by producers into a byte queue: this header is directly
+// followed by the inline encoded arguments. Arguments that already spilled to the heap keep
+// their storage, so an entry is never bigger than `max_size()` bytes.
+struct EncodedRecord
+{
+    ManagerHandle manager;
+    uint64_t epoch;
+    std::unique_ptr<slog::fmt::ArgBuffer> spilled_args;
+    std::string string_buffer;
+    std::source_location location;
+    std::chrono::system_clock::time_point timestamp;
+    size_t thread_id;
+    const slog::details::ThreadContext* thread;
+    std::string_view logger_name;
+    std::string_view format_str;
+    slog::fmt::DeferredFormatFn format_fn;
+    slog::fmt::ArgBuffer::ManagerFn args_manager;
+    slog::LogLevel level;
+
+    [[nodiscard]] static constexpr size_t args_offset() noexcept
+    {
+        return slog::fmt::detail::align_up(sizeof(EncodedRecord), alignof(std::max_align_t));
+    }
+
+    [[nodiscard]] static constexpr size_t max_size() noexcept
+    {
+        return args_offset() + slog::fmt::ArgBuffer::INLINE_SIZE;
+    }
+
+    [[nodiscard]] static size_t encoded_size(const AsyncOp& op) noexcept
+    {
+        const slog::fmt::ArgBuffer& args = op.record.stored_args;
+
+        return args_offset() + (args.is_inline() ? args.size() : 0);
+    }
+
+    // Builds the entry in `dst` (encoded_size(op) bytes aligned to max_align_t) out of `op`
+    static EncodedRecord* encode(std::byte* dst, AsyncOp&& op)
+    {
+        slog::LogRecord& record = op.record;
+        EncodedRecord* enc = ::new (static_cast<void*>(dst)) EncodedRecord{
+            op.manager,
+            op.epoch,
+            nullptr,
+            std::move(record.string_buffer),
+            record.location,
+            record.timestamp,
+            record.thread_id,
+            record.thread,
+            record.logger_name,
+            record.format_str,
+            record.format_fn,
+            nullptr,
+            record.level};
+
+        if (record.stored_args.is_inline()) {
+            enc->args_manager = record.stored_args.relocate_to(dst + args_offset());
+        }
+        else {
+            enc->spilled_args = std::make_unique<slog::fmt::ArgBuffer>(std::move(record.stored_args));
+        }
+        return enc;
+    }
+
+    [[nodiscard]] static EncodedRecord* from(std::byte* data) noexcept
+    {
+        return std::launder(reinterpret_cast<EncodedRecord*>(data));
+    }
+
+    // Points `record` to this entry, arguments are decoded in place by the sink manager.
+    // `record` must not be used after `destroy()`.
+    void decode(slog::LogRecord& record)
+    {
+        record.level = level;
+        record.logger_name = logger_name;
+        record.location = location;
+        record.timestamp = timestamp;
+        record.thread_id = thread_id;
+        record.thread = thread;
+        record.format_str = format_str;
+        record.format_fn = format_fn;
+        record.encoded_args = spilled_args ? spilled_args->data() : _inline_args();
+        if (!format_fn) {
+            record.string_buffer.swap(string_buffer);
+        }
+    }
+
+    // Releases the arguments and the entry itself
+    void destroy() noexcept
+    {
+        if (args_manager) {
+            args_manager(slog::fmt::ArgBuffer::ManagerOp::DESTROY, _inline_args(), nullptr);
+        }
+        this->~EncodedRecord();
+    }
+
+private:
+    [[nodiscard]] std::byte* _inline_args() noexcept
+    {
+        return reinterpret_cast<std::byte*>(this) + args_offset();
+    }
+};
+
+} // namespace slog::async
+
+#endif // SLOG_ASYNC_ENCODED_RECORD_HPP
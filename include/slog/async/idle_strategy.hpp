@@ -0,0 +1,39 @@
+#ifndef SLOG_ASYNC_IDLE_STRATEGY_HPP
+#define SLOG_ASYNC_IDLE_STRATEGY_HPP
+
+#include <cstdint>
+
+#include <slog/config_macros.hpp>
+
+namespace slog::async
+{
+
+// How a worker waits for records once its queue is empty. While the worker polls, producers
+// find it awake and skip the wake up (no futex call on the logging path).
+struct IdleStrategy
+{
+    enum class Mode : uint8_t
+    {
+        BLOCK,   // parks right away, every record pushed to an idle worker wakes it
+        BACKOFF, // polls `spins` times with a CPU pause, then `yields` times yielding, then parks
+        SPIN     // polls with a CPU pause and never parks: lowest latency, a busy core
+    };
+
+    [[nodiscard]] static constexpr IdleStrategy block() noexcept { return {Mode::BLOCK, 0, 0}; }
+
+    [[nodiscard]] static constexpr IdleStrategy spin() noexcept { return {Mode::SPIN, 0, 0}; }
+
+    [[nodiscard]] static constexpr IdleStrategy backoff(uint32_t spins = SLOG_ASYNC_IDLE_SPINS,
+                                                        uint32_t yields = SLOG_ASYNC_IDLE_YIELDS) noexcept
+    {
+        return {Mode::BACKOFF, spins, yields};
+    }
+
+    Mode mode{Mode::BLOCK};
+    uint32_t spins{0};
+    uint32_t yields{0};
+};
+
+} // namespace slog::async
+
+#endif // SLOG_ASYNC_IDLE_STRATEGY_HPP
@@ -0,0 +1,187 @@
+#ifndef SLOG_ASYNC_MANAGER_TABLE_HPP
+#define SLOG_ASYNC_MANAGER_TABLE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <slog/async/async_op.hpp>
+#include <slog/config_macros.hpp>
+#include <slog/details/macros.hpp>
+#include <slog/sinks/sink_manager.hpp>
+
+namespace slog::async
+{
+
+// Sink managers of the loggers bound to a worker, referenced by the queued records through
+// a small integer handle so that pushing a record doesn't touch any reference count.
+//
+// A detached handle is retired with the next epoch and its manager kept alive until the
+// worker proves that no record can still reference it. Producers stamp every record with the
+// epoch read before pushing: once the worker consumed a record stamped with the retirement
+// epoch or a later one (or saw its queue empty after reading the epoch), every record pushed
+// before the detach has been consumed and the handle is reclaimed.
+class ManagerTable
+{
+public:
+    static constexpr size_t CAPACITY = SLOG_MAX_LOGGERS;
+
+    ManagerTable()
+        : _slots(new std::shared_ptr<slog::sinks::SinkManager>[CAPACITY]),
+          _names(new std::string[CAPACITY]),
+          _dropped(new std::atomic<uint64_t>[CAPACITY]())
+    {
+        _free.reserve(CAPACITY);
+        for (size_t i = CAPACITY; i > 0; i--) {
+            _free.push_back(static_cast<ManagerHandle>(i - 1));
+        }
+    }
+
+    ManagerTable(const ManagerTable&) = delete;
+    ManagerTable& operator=(const ManagerTable&) = delete;
+
+    // `name` is the logger name given to the records reporting drops
+    [[nodiscard]] ManagerHandle attach(std::shared_ptr<slog::sinks::SinkManager> manager,
+                                       std::string_view name = {})
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (_free.empty()) [[unlikely]] {
+            throw std::runtime_error("slog: too many loggers bound to the same worker.");
+        }
+
+        ManagerHandle handle = _free.back();
+
+        _free.pop_back();
+        _slots[handle] = std::move(manager);
+        _names[handle] = name;
+        return handle;
+    }
+
+    // Must be called once no more records will be pushed with `handle`
+    void detach(ManagerHandle handle)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        _retired.push_back({handle, _epoch.fetch_add(1, std::memory_order_acq_rel) + 1});
+        _has_retired.store(true, std::memory_order_release);
+    }
+
+    // Worker thread only, the handle is valid until its records are consumed
+    [[nodiscard]] SLOG_ALWAYS_INLINE slog::sinks::SinkManager* get(ManagerHandle handle) const noexcept
+    {
+        return _slots[handle].get();
+    }
+
+    [[nodiscard]] SLOG_ALWAYS_INLINE uint64_t epoch() const noexcept
+    {
+        return _epoch.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] SLOG_ALWAYS_INLINE bool has_retired() const noexcept
+    {
+        return _has_retired.load(std::memory_order_relaxed);
+    }
+
+    // Producers: a record pushed with `handle` has been dropped
+    void count_drop(ManagerHandle handle) noexcept
+    {
+        _dropped[handle].fetch_add(1, std::memory_order_seq_cst);
+        if (!_has_dropped.load(std::memory_order_seq_cst)) {
+            _has_dropped.store(true, std::memory_order_seq_cst);
+        }
+    }
+
+    [[nodiscard]] SLOG_ALWAYS_INLINE bool has_dropped() const noexcept
+    {
+        return _has_dropped.load(std::memory_order_relaxed);
+    }
+
+    // Worker thread only: resets the drop counts, calls
+    // `report(slog::sinks::SinkManager&, std::string_view name, uint64_t count)` for the non zero ones
+    template<typename F>
+    void collect_drops(F&& report)
+    {
+        // Lowered before the counts are read, a drop counted meanwhile raises it again
+        _has_dropped.store(false, std::memory_order_seq_cst);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            for (size_t i = 0; i < CAPACITY; i++) {
+                if (_dropped[i].load(std::memory_order_seq_cst) == 0) {
+                    continue;
+                }
+
+                uint64_t count = _dropped[i].exchange(0, std::memory_order_seq_cst);
+
+                if (_slots[i]) {
+                    _drops.push_back({_slots[i], _names[i], count});
+                }
+            }
+        }
+        // Sinks are written out of the lock
+        for (Drop& drop : _drops) {
+            report(*drop.manager, std::string_view(drop.name), drop.count);
+        }
+        _drops.clear();
+    }
+
+    // Worker thread only: no record stamped before `epoch` is left in the queue
+    void reclaim(uint64_t epoch)
+    {
+        std::vector<std::shared_ptr<slog::sinks::SinkManager>> released;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            for (size_t i = 0; i < _retired.size();) {
+                if (_retired[i].epoch > epoch) {
+                    i++;
+                    continue;
+                }
+                released.push_back(std::move(_slots[_retired[i].handle]));
+                _dropped[_retired[i].handle].store(0, std::memory_order_relaxed);
+                _free.push_back(_retired[i].handle);
+                _retired[i] = _retired.back();
+                _retired.pop_back();
+            }
+            _has_retired.store(!_retired.empty(), std::memory_order_relaxed);
+        }
+        // Sinks may flush or close files on destruction, keep it out of the lock
+    }
+
+private:
+    struct Retired
+    {
+        ManagerHandle handle;
+        uint64_t epoch;
+    };
+
+    struct Drop
+    {
+        std::shared_ptr<slog::sinks::SinkManager> manager;
+        std::string name;
+        uint64_t count;
+    };
+
+    std::unique_ptr<std::shared_ptr<slog::sinks::SinkManager>[]> _slots;
+    std::unique_ptr<std::string[]> _names;
+    std::unique_ptr<std::atomic<uint64_t>[]> _dropped; // written by producers
+    std::mutex _mutex;
+    std::vector<ManagerHandle> _free;
+    std::vector<Retired> _retired;
+    std::vector<Drop> _drops; // worker thread only
+    std::atomic<uint64_t> _epoch{0};
+    std::atomic<bool> _has_retired{false};
+    std::atomic<bool> _has_dropped{false};
+};
+
+} // namespace slog::async
+
+#endif // SLOG_ASYNC_MANAGER_TABLE_HPP
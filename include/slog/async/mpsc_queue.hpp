@@ -2,59 +2,123 @@
 #define SLOG_ASYNC_MPSC_QUEUE_HPP
 
 #include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
 #include <thread>
 
 #include <slog/async/common.hpp>
+#include <slog/async/queue_memory.hpp>
 #include <slog/config_macros.hpp>
 #include <slog/details/macros.hpp>
 
 namespace slog::async
 {
 
-template<typename T, size_t Size, typename Policy>
+// Where a slot keeps its sequence number
+enum class SlotLayout : uint8_t
+{
+    SPLIT, // after the item, on a cacheline of its own
+    PACKED // in the first cacheline of the item, the consumer prefetches the slots ahead
+};
+
+#ifdef SLOG_MPSC_PACKED_SLOTS
+inline constexpr SlotLayout DEFAULT_SLOT_LAYOUT = SlotLayout::PACKED;
+#else
+inline constexpr SlotLayout DEFAULT_SLOT_LAYOUT = SlotLayout::SPLIT;
+#endif
+
+namespace detail
+{
+
+template<typename T, SlotLayout Layout>
+struct MPSCNode;
+
+SLOG_DISABLE_PADDING_WARNING
+template<typename T>
+struct MPSCNode<T, SlotLayout::SPLIT>
+{
+    T data;
+    alignas(SLOG_CACHELINE_SIZE) std::atomic<size_t> seq;
+};
+
+// Slots start on a cacheline, so producers committing neighbour slots never share one. The
+// consumer reads the sequence and the record header from the same line.
+template<typename T>
+struct alignas(SLOG_CACHELINE_SIZE) MPSCNode<T, SlotLayout::PACKED>
+{
+    std::atomic<size_t> seq;
+    T data;
+};
+SLOG_RESTORE_PADDING_WARNING
+
+} // namespace detail
+
+template<typename T, size_t Size, typename Policy, SlotLayout Layout = DEFAULT_SLOT_LAYOUT>
 class MPSCQueue
 {
     static_assert((Size != 0) && ((Size & (Size - 1)) == 0),
                   "MPSCQueue::Size must be a power of 2");
 
-    SLOG_DISABLE_PADDING_WARNING
-    struct Node
-    {
-        T data;
-        alignas(SLOG_CACHELINE_SIZE) std::atomic<size_t> seq;
-    };
-    SLOG_RESTORE_PADDING_WARNING
+    using Node = detail::MPSCNode<T, Layout>;
 
 public:
-    MPSCQueue() : _size(Size), _mask(Size - 1), _buffer(new Node[Size])
+    MPSCQueue() : MPSCQueue(QueueOptions{}) {}
+
+    // Size is the capacity unless `options.capacity` is set. Writing the slot sequences faults
+    // in every page of the ring here, not during the first burst.
+    explicit MPSCQueue(const QueueOptions& options)
+        : _size(detail::ring_capacity(options.capacity, Size, 2)),
+          _mask(_size - 1),
+          _memory(_size * sizeof(Node), options),
+          _buffer(static_cast<Node*>(_memory.data()))
     {
         for (size_t i = 0; i < _size; i++) {
+            ::new (static_cast<void*>(_buffer + i)) Node{};
             _buffer[i].seq.store(i, std::memory_order_relaxed);
         }
     }
-    ~MPSCQueue() { delete[] _buffer; }
+    ~MPSCQueue() { std::destroy_n(_buffer, _size); }
 
     MPSCQueue(const MPSCQueue&) = delete;
     MPSCQueue& operator=(const MPSCQueue&) = delete;
 
     SLOG_ALWAYS_INLINE bool push(T&& item) { return Policy::push(*this, std::move(item)); }
 
-    bool pop(T& item)
+    // Pushes with another policy than the queue's one (e.g. chosen at runtime)
+    template<typename P>
+    SLOG_ALWAYS_INLINE bool push(T&& item, const P& policy)
     {
-        size_t tail = _tail.load(std::memory_order_relaxed);
-        Node& node = _buffer[tail & _mask];
+        return policy.push(*this, std::move(item));
+    }
 
-        if (node.seq.load(std::memory_order_acquire) != tail + 1) {
-            return false;
-        }
+    bool pop(T& item) { return _take(item); }
+
+    // Producer side: moves the oldest committed item out to make room (DropOldestOnFull).
+    // Fails if the queue is empty or its oldest slot is not committed yet.
+    bool try_evict(T& item) { return _take(item); }
+
+    // Consumer side: true only if every reserved slot has been consumed
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_relaxed);
+    }
+
+    // Reserved slots not consumed yet, a snapshot
+    [[nodiscard]] size_t size_approx() const noexcept
+    {
+        size_t tail = _tail.load(std::memory_order_relaxed);
 
-        item = std::move(node.data);
-        node.seq.store(tail + _size, std::memory_order_release);
-        // _tail is relaxed, seq's acquire/release enforces visibility
-        _tail.store(tail + 1, std::memory_order_relaxed);
-        return true;
+        return _head.load(std::memory_order_relaxed) - tail;
     }
 
+    [[nodiscard]] size_t capacity() const noexcept { return _size; }
+
+    [[nodiscard]] const QueueMemory& memory() const noexcept { return _memory.memory(); }
+
+    // Bytes taken by a slot in the ring
+    [[nodiscard]] static constexpr size_t slot_size() noexcept { return sizeof(Node); }
+
     [[nodiscard]] bool try_reserve(Reservation& r)
     {
         size_t head = _head.load(std::memory_order_relaxed);
@@ -81,8 +145,13 @@ public:
     {
         Node& node = _buffer[r.index & _mask];
 
-        while (node.seq.load(std::memory_order_acquire) != r.index) {
-            std::this_thread::yield();
+        if (node.seq.load(std::memory_order_acquire) != r.index) [[unlikely]] {
+            // The slot is still held by the record pushed one lap earlier
+            detail::WaitTimer timer;
+
+            while (node.seq.load(std::memory_order_acquire) != r.index) {
+                std::this_thread::yield();
+            }
         }
 
         node.data = std::move(item);
@@ -90,8 +159,44 @@ public:
     }
 
 private:
+    // The consumer and evicting producers both claim the oldest slot by moving _tail
+    bool _take(T& item)
+    {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+
+        while (true) {
+            Node& node = _buffer[tail & _mask];
+
+            if (node.seq.load(std::memory_order_acquire) != tail + 1) {
+                return false;
+            }
+            if (_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed)) {
+                if constexpr (Layout == SlotLayout::PACKED && PREFETCH_DISTANCE != 0) {
+                    _prefetch(tail + PREFETCH_DISTANCE);
+                }
+                // The slot can't be reserved again before seq is moved past it
+                item = std::move(node.data);
+                node.seq.store(tail + _size, std::memory_order_release);
+                return true;
+            }
+        }
+    }
+
+    static constexpr size_t PREFETCH_DISTANCE = SLOG_MPSC_PREFETCH_DISTANCE;
+
+    // Every line of the slot: its sequence is read then written, its record moved out
+    SLOG_ALWAYS_INLINE void _prefetch(size_t index) const noexcept
+    {
+        const auto* slot = reinterpret_cast<const char*>(_buffer + (index & _mask));
+
+        for (size_t offset = 0; offset < sizeof(Node); offset += SLOG_CACHELINE_SIZE) {
+            SLOG_PREFETCH(slot + offset);
+        }
+    }
+
     size_t _size;
     size_t _mask;
+    QueueBuffer _memory;
     Node* _buffer;
     SLOG_DISABLE_PADDING_WARNING
     alignas(SLOG_CACHELINE_SIZE) std::atomic<size_t> _head{0};
@@ -1,7 +1,15 @@
 #ifndef SLOG_ASYNC_POLICIES_HPP
 #define SLOG_ASYNC_POLICIES_HPP
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
 #include <slog/async/common.hpp>
+#include <slog/core/log_level.hpp>
 
 namespace slog::async
 {
@@ -19,6 +27,20 @@ struct DiscardOnFull
         }
         return false;
     }
+
+    // Byte queues: `write` fills the `size` reserved bytes
+    template<typename Queue, typename Writer>
+    static bool push(Queue& q, size_t size, Writer&& write)
+    {
+        Reservation r;
+
+        if (q.try_reserve(r, size)) {
+            write(r.data);
+            q.commit(r);
+            return true;
+        }
+        return false;
+    }
 };
 
 struct BlockOnFull
@@ -31,8 +53,167 @@ struct BlockOnFull
         q.commit(r, std::move(item));
         return true;
     }
+
+    // Byte queues: `write` fills the `size` reserved bytes
+    template<typename Queue, typename Writer>
+    static bool push(Queue& q, size_t size, Writer&& write)
+    {
+        Reservation r;
+
+        if (!q.reserve(r, size)) {
+            return false;
+        }
+        write(r.data);
+        q.commit(r);
+        return true;
+    }
+};
+
+struct IgnoreEvicted
+{
+    template<typename T>
+    void operator()(T&) const noexcept
+    {
+    }
+};
+
+// Makes room by evicting the oldest items, `on_evict` is called with each of them. Queues
+// whose consumer reads the entries in place (byte ring, SPSC) can't evict, the new item is
+// dropped instead.
+template<typename OnEvict = IgnoreEvicted>
+struct DropOldestOnFull
+{
+    OnEvict on_evict{};
+
+    template<typename T, typename Queue>
+    bool push(Queue& q, T&& item) const
+    {
+        Reservation r;
+
+        while (!q.try_reserve(r)) {
+            if constexpr (requires(std::remove_cvref_t<T>& victim) { q.try_evict(victim); }) {
+                std::remove_cvref_t<T> victim;
+
+                if (q.try_evict(victim)) {
+                    on_evict(victim);
+                }
+                else {
+                    // The oldest slot is reserved but not committed yet
+                    detail::WaitTimer timer;
+
+                    std::this_thread::yield();
+                }
+            }
+            else {
+                return false;
+            }
+        }
+        q.commit(r, std::move(item));
+        return true;
+    }
+
+    template<typename Queue, typename Writer>
+    bool push(Queue& q, size_t size, Writer&& write) const
+    {
+        return DiscardOnFull::push(q, size, std::forward<Writer>(write));
+    }
+};
+
+// Waits for room up to `timeout`, then drops the new item
+struct WaitOnFull
+{
+    std::chrono::nanoseconds timeout{0};
+
+    template<typename T, typename Queue>
+    bool push(Queue& q, T&& item) const
+    {
+        Reservation r;
+
+        if (!_wait([&]() { return q.try_reserve(r); })) {
+            return false;
+        }
+        q.commit(r, std::move(item));
+        return true;
+    }
+
+    template<typename Queue, typename Writer>
+    bool push(Queue& q, size_t size, Writer&& write) const
+    {
+        Reservation r;
+
+        if (size > q.max_payload() || !_wait([&]() { return q.try_reserve(r, size); })) {
+            return false;
+        }
+        write(r.data);
+        q.commit(r);
+        return true;
+    }
+
+private:
+    template<typename TryReserve>
+    bool _wait(TryReserve&& try_reserve) const
+    {
+        if (try_reserve()) [[likely]] {
+            return true;
+        }
+
+        detail::WaitTimer timer;
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+
+        do {
+            std::this_thread::yield();
+            if (try_reserve()) {
+                return true;
+            }
+        } while (std::chrono::steady_clock::now() < deadline);
+        return false;
+    }
+};
+
+// What a worker does with a record pushed while its queue is full, chosen at runtime
+// (Registry::set_queue_full_policy). Dropped records are counted per logger and reported
+// by the worker as a single "N messages dropped" warning.
+struct QueueFullPolicy
+{
+    enum class Mode : uint8_t
+    {
+        BLOCK,         // waits for room, nothing is lost
+        DISCARD,       // drops the new record
+        DROP_OLDEST,   // drops the oldest queued records (MPSC queue, the others drop the new one)
+        DROP_BY_LEVEL, // past `watermark` occupancy drops records less severe than `keep`
+        WAIT           // waits up to `timeout`, then drops the new record
+    };
+
+    [[nodiscard]] static constexpr QueueFullPolicy block() noexcept { return {}; }
+
+    [[nodiscard]] static constexpr QueueFullPolicy discard() noexcept
+    {
+        return {Mode::DISCARD, LogLevel::OFF, 1.0, {}};
+    }
+
+    [[nodiscard]] static constexpr QueueFullPolicy drop_oldest() noexcept
+    {
+        return {Mode::DROP_OLDEST, LogLevel::OFF, 1.0, {}};
+    }
+
+    // Records at `keep` or more severe are never dropped, they wait for room
+    [[nodiscard]] static constexpr QueueFullPolicy drop_by_level(LogLevel keep = LogLevel::WARNING,
+                                                                 double watermark = 0.75) noexcept
+    {
+        return {Mode::DROP_BY_LEVEL, keep, watermark, {}};
+    }
+
+    [[nodiscard]] static constexpr QueueFullPolicy wait_for(std::chrono::nanoseconds timeout) noexcept
+    {
+        return {Mode::WAIT, LogLevel::OFF, 1.0, timeout};
+    }
+
+    Mode mode{Mode::BLOCK};
+    LogLevel keep{LogLevel::OFF};
+    double watermark{1.0}; // fraction of the queue capacity
+    std::chrono::nanoseconds timeout{0};
 };
 
 } // namespace slog::async
 
-#endif // SLOG_ASYNC_POLICIES_HPP
\ No newline at end of file
+#endif // SLOG_ASYNC_POLICIES_HPP
@@ -0,0 +1,189 @@
+#ifndef SLOG_ASYNC_QUEUE_MEMORY_HPP
+#define SLOG_ASYNC_QUEUE_MEMORY_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string_view>
+
+#ifdef __linux__
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+namespace slog::async
+{
+
+// Size and memory of a queue ring, chosen when the queue is built
+struct QueueOptions
+{
+    size_t capacity{0};     // slots of the MPSC queue, bytes of the byte ring, rounded up to a power of 2.
+                            // 0 keeps the compile time size (SLOG_MPSC_QUEUE_SIZE, SLOG_BYTE_QUEUE_SIZE)
+    bool huge_pages{false}; // MAP_HUGETLB, else transparent huge pages advised with madvise
+    bool prefault{false};   // every page is touched when the queue is built rather than by the first burst
+};
+
+enum class PageBacking : uint8_t
+{
+    REGULAR,
+    TRANSPARENT_HUGE, // advised only, the kernel may still back some of it with regular pages
+    HUGETLB
+};
+
+[[nodiscard]] constexpr std::string_view to_string(PageBacking backing) noexcept
+{
+    switch (backing) {
+    case PageBacking::REGULAR: return "regular pages";
+    case PageBacking::TRANSPARENT_HUGE: return "transparent huge pages";
+    case PageBacking::HUGETLB: return "huge pages";
+    }
+    return "unknown";
+}
+
+// Memory held by the ring of a queue
+struct QueueMemory
+{
+    size_t bytes{0}; // allocated, rounded up to the page size
+    PageBacking backing{PageBacking::REGULAR};
+    bool prefaulted{false};
+};
+
+namespace detail
+{
+
+// `requested` rounded up to a power of 2 and at least `minimum`, `fallback` if 0
+[[nodiscard]] constexpr size_t ring_capacity(size_t requested, size_t fallback, size_t minimum) noexcept
+{
+    if (requested == 0) {
+        return fallback;
+    }
+    return std::bit_ceil(requested < minimum ? minimum : requested);
+}
+
+} // namespace detail
+
+// Page aligned buffer of a queue ring. Huge pages are tried in order: MAP_HUGETLB (needs pages
+// reserved in /proc/sys/vm/nr_hugepages), then a 2 MiB aligned mapping advised with
+// MADV_HUGEPAGE. Elsewhere than on Linux the buffer always comes from operator new.
+class QueueBuffer
+{
+public:
+    static constexpr size_t HUGE_PAGE_SIZE = size_t{2} << 20;
+
+    QueueBuffer(size_t bytes, const QueueOptions& options)
+    {
+#ifdef __linux__
+        if (options.huge_pages) {
+            _map_hugetlb(bytes);
+            if (!_data) {
+                _map_transparent(bytes);
+            }
+        }
+        if (!_data) {
+            _map(bytes);
+        }
+#else
+        _memory.bytes = _round_up(bytes, BASE_PAGE_SIZE);
+        _data = ::operator new(_memory.bytes, std::align_val_t{BASE_PAGE_SIZE});
+#endif
+        if (options.prefault) {
+            _prefault();
+        }
+    }
+
+    ~QueueBuffer()
+    {
+#ifdef __linux__
+        ::munmap(_data, _memory.bytes);
+#else
+        ::operator delete(_data, std::align_val_t{BASE_PAGE_SIZE});
+#endif
+    }
+
+    QueueBuffer(const QueueBuffer&) = delete;
+    QueueBuffer& operator=(const QueueBuffer&) = delete;
+
+    [[nodiscard]] void* data() const noexcept { return _data; }
+
+    [[nodiscard]] const QueueMemory& memory() const noexcept { return _memory; }
+
+private:
+    static constexpr size_t BASE_PAGE_SIZE = 4096;
+
+    [[nodiscard]] static constexpr size_t _round_up(size_t bytes, size_t page) noexcept
+    {
+        return (bytes + page - 1) & ~(page - 1);
+    }
+
+#ifdef __linux__
+    void _map_hugetlb(size_t bytes) noexcept
+    {
+        size_t size = _round_up(bytes, HUGE_PAGE_SIZE);
+        void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+        if (data != MAP_FAILED) {
+            _data = data;
+            _memory.bytes = size;
+            _memory.backing = PageBacking::HUGETLB;
+        }
+    }
+
+    // THP only backs the huge page aligned part of a mapping: one extra huge page is mapped
+    // to align the start, the head and tail around the aligned range are unmapped
+    void _map_transparent(size_t bytes) noexcept
+    {
+        size_t size = _round_up(bytes, HUGE_PAGE_SIZE);
+        void* data = ::mmap(nullptr, size + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (data == MAP_FAILED) {
+            return;
+        }
+
+        auto begin = reinterpret_cast<uintptr_t>(data);
+        uintptr_t aligned = _round_up(begin, HUGE_PAGE_SIZE);
+        size_t head = aligned - begin;
+
+        if (head != 0) {
+            ::munmap(data, head);
+        }
+        ::munmap(reinterpret_cast<void*>(aligned + size), HUGE_PAGE_SIZE - head);
+        _data = reinterpret_cast<void*>(aligned);
+        _memory.bytes = size;
+        _memory.backing = ::madvise(_data, size, MADV_HUGEPAGE) == 0 ? PageBacking::TRANSPARENT_HUGE
+                                                                     : PageBacking::REGULAR;
+    }
+
+    void _map(size_t bytes)
+    {
+        size_t size = _round_up(bytes, static_cast<size_t>(::sysconf(_SC_PAGESIZE)));
+        void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (data == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        _data = data;
+        _memory.bytes = size;
+    }
+#endif
+
+    // Nothing lives in the buffer yet, writing zeroes over it is harmless
+    void _prefault() noexcept
+    {
+        volatile auto* bytes = static_cast<volatile unsigned char*>(_data);
+
+        for (size_t i = 0; i < _memory.bytes; i += BASE_PAGE_SIZE) {
+            bytes[i] = 0;
+        }
+        _memory.prefaulted = true;
+    }
+
+    void* _data{nullptr};
+    QueueMemory _memory;
+};
+
+} // namespace slog::async
+
+#endif // SLOG_ASYNC_QUEUE_MEMORY_HPP
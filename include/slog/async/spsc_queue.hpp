@@ -0,0 +1,124 @@
+#ifndef SLOG_ASYNC_SPSC_QUEUE_HPP
+#define SLOG_ASYNC_SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+#include <slog/async/common.hpp>
+#include <slog/config_macros.hpp>
+#include <slog/details/macros.hpp>
+
+namespace slog::async
+{
+
+// Single producer single consumer ring. Each side keeps a private copy of the other side's
+// index and only reloads the shared one when the copy says full (producer) or empty
+// (consumer), so in steady state the two sides never touch each other's cachelines.
+template<typename T, size_t Size, typename Policy>
+class SPSCQueue
+{
+    static_assert((Size != 0) && ((Size & (Size - 1)) == 0),
+                  "SPSCQueue::Size must be a power of 2");
+
+public:
+    SPSCQueue() : _buffer(new T[Size]) {}
+    ~SPSCQueue() { delete[] _buffer; }
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    SLOG_ALWAYS_INLINE bool push(T&& item) { return Policy::push(*this, std::move(item)); }
+
+    // Pushes with another policy than the queue's one (e.g. chosen at runtime)
+    template<typename P>
+    SLOG_ALWAYS_INLINE bool push(T&& item, const P& policy)
+    {
+        return policy.push(*this, std::move(item));
+    }
+
+    // Oldest item or nullptr if the queue is empty, the item stays valid until pop()
+    [[nodiscard]] T* front() noexcept
+    {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+
+        if (tail == _consumer_head) {
+            _consumer_head = _head.load(std::memory_order_acquire);
+            if (tail == _consumer_head) {
+                return nullptr;
+            }
+        }
+        return &_buffer[tail & MASK];
+    }
+
+    bool pop(T& item)
+    {
+        T* slot = front();
+
+        if (!slot) {
+            return false;
+        }
+        item = std::move(*slot);
+        _tail.store(_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        return true;
+    }
+
+    [[nodiscard]] bool try_reserve(Reservation& r) noexcept
+    {
+        size_t head = _head.load(std::memory_order_relaxed);
+
+        if (head - _producer_tail >= Size) {
+            _producer_tail = _tail.load(std::memory_order_acquire);
+            if (head - _producer_tail >= Size) {
+                return false;
+            }
+        }
+        r.index = head;
+        return true;
+    }
+
+    [[nodiscard]] Reservation reserve() noexcept
+    {
+        Reservation r;
+
+        if (!try_reserve(r)) [[unlikely]] {
+            detail::WaitTimer timer;
+
+            while (!try_reserve(r)) {
+                std::this_thread::yield();
+            }
+        }
+        return r;
+    }
+
+    void commit(const Reservation& r, T&& item)
+    {
+        _buffer[r.index & MASK] = std::move(item);
+        _head.store(r.index + 1, std::memory_order_release);
+    }
+
+    // Items pushed and not popped yet, a snapshot
+    [[nodiscard]] size_t size_approx() const noexcept
+    {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+
+        return _head.load(std::memory_order_relaxed) - tail;
+    }
+
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return Size; }
+
+private:
+    static constexpr size_t MASK = Size - 1;
+
+    T* _buffer;
+    SLOG_DISABLE_PADDING_WARNING
+    alignas(SLOG_CACHELINE_SIZE) std::atomic<size_t> _head{0};
+    size_t _producer_tail{0};
+    alignas(SLOG_CACHELINE_SIZE) std::atomic<size_t> _tail{0};
+    size_t _consumer_head{0};
+    SLOG_RESTORE_PADDING_WARNING
+};
+
+} // namespace slog::async
+
+#endif // SLOG_ASYNC_SPSC_QUEUE_HPP
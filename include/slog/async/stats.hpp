@@ -0,0 +1,96 @@
+#ifndef SLOG_ASYNC_STATS_HPP
+#define SLOG_ASYNC_STATS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <slog/async/queue_memory.hpp>
+#include <slog/config_macros.hpp>
+#include <slog/details/macros.hpp>
+
+namespace slog::async
+{
+
+// Snapshot of a worker and its queue, the counters are cumulative since the worker started
+struct WorkerStats
+{
+    uint64_t enqueued{0};   // records accepted by the queue
+    uint64_t dequeued{0};   // records dispatched by the worker
+    uint64_t dropped{0};    // records rejected on a full queue or evicted from it
+    uint64_t depth{0};      // records queued and not dispatched yet
+    uint64_t high_water{0}; // highest occupancy seen by the worker, same unit as `capacity`
+    uint64_t capacity{0};   // records, bytes with SLOG_ASYNC_BYTE_QUEUE, per thread with SLOG_ASYNC_THREAD_QUEUES
+    std::chrono::nanoseconds producer_wait{0}; // time producers waited for room
+    std::chrono::nanoseconds busy{0};          // time the worker spent draining its queue
+    std::chrono::nanoseconds idle{0};          // time the worker spent polling or parked
+    uint64_t wakeups{0};                       // times the worker found records after idling
+    QueueMemory memory;                        // ring of the queue, every per-thread ring with SLOG_ASYNC_THREAD_QUEUES
+
+    [[nodiscard]] double records_per_wakeup() const noexcept
+    {
+        return wakeups ? static_cast<double>(dequeued) / static_cast<double>(wakeups) : 0.0;
+    }
+};
+
+// Producer side counters of a worker. A thread always updates the same shard, shards sit on
+// their own cachelines so producers on different threads don't share one.
+class ProducerStats
+{
+public:
+    static constexpr size_t SHARDS = SLOG_ASYNC_STATS_SHARDS;
+
+    static_assert((SHARDS != 0) && ((SHARDS & (SHARDS - 1)) == 0),
+                  "SLOG_ASYNC_STATS_SHARDS must be a power of 2");
+
+    SLOG_DISABLE_PADDING_WARNING
+    struct alignas(SLOG_CACHELINE_SIZE) Shard
+    {
+        std::atomic<uint64_t> enqueued{0};
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<uint64_t> evicted{0}; // dropped after being enqueued
+        std::atomic<uint64_t> wait_ns{0};
+    };
+    SLOG_RESTORE_PADDING_WARNING
+
+    [[nodiscard]] SLOG_ALWAYS_INLINE Shard& local() noexcept { return _shards[_thread_index() & (SHARDS - 1)]; }
+
+    // Adds the shards up into `stats`
+    void collect(WorkerStats& stats, uint64_t& evicted) const noexcept
+    {
+        for (const Shard& shard : _shards) {
+            stats.enqueued += shard.enqueued.load(std::memory_order_relaxed);
+            stats.dropped += shard.dropped.load(std::memory_order_relaxed);
+            stats.producer_wait += std::chrono::nanoseconds(shard.wait_ns.load(std::memory_order_relaxed));
+            evicted += shard.evicted.load(std::memory_order_relaxed);
+        }
+    }
+
+    [[nodiscard]] uint64_t dropped() const noexcept
+    {
+        uint64_t dropped = 0;
+
+        for (const Shard& shard : _shards) {
+            dropped += shard.dropped.load(std::memory_order_relaxed);
+        }
+        return dropped;
+    }
+
+private:
+    // Threads take consecutive indexes, the first SHARDS threads never share a shard
+    [[nodiscard]] SLOG_ALWAYS_INLINE static size_t _thread_index() noexcept
+    {
+        static std::atomic<size_t> next{0};
+        static thread_local size_t index = next.fetch_add(1, std::memory_order_relaxed);
+
+        return index;
+    }
+
+    std::array<Shard, SHARDS> _shards;
+};
+
+} // namespace slog::async
+
+#endif // SLOG_ASYNC_STATS_HPP
@@ -0,0 +1,231 @@
+#ifndef SLOG_ASYNC_THREAD_QUEUES_HPP
+#define SLOG_ASYNC_THREAD_QUEUES_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <slog/async/queue_memory.hpp>
+#include <slog/async/spsc_queue.hpp>
+#include <slog/details/macros.hpp>
+
+namespace slog::async
+{
+
+// Set of SPSC rings, one per producing thread, drained by a single consumer.
+//
+// A thread gets its ring lazily on its first push and registers it under a mutex, after
+// that pushing never touches memory shared with other producers. When the thread exits its
+// rings are marked as retired and dropped by the consumer once drained.
+// The consumer merges the rings by picking, every pop, the oldest front item according
+// to `key` (e.g. the record timestamp).
+template<typename T, size_t Size, typename Policy>
+class ThreadQueues
+{
+public:
+    using Queue = SPSCQueue<T, Size, Policy>;
+
+    ThreadQueues() : _id(_next_id.fetch_add(1, std::memory_order_relaxed)) {}
+
+    // The rings are built on the first push of every thread, always with Size slots from the
+    // heap: the options don't apply to them
+    explicit ThreadQueues(const QueueOptions&) : ThreadQueues() {}
+
+    ThreadQueues(const ThreadQueues&) = delete;
+    ThreadQueues& operator=(const ThreadQueues&) = delete;
+
+    SLOG_ALWAYS_INLINE bool push(T&& item) { return _local().push(std::move(item)); }
+
+    template<typename P>
+    SLOG_ALWAYS_INLINE bool push(T&& item, const P& policy)
+    {
+        return _local().push(std::move(item), policy);
+    }
+
+    // Producer side: items in the ring of the calling thread
+    [[nodiscard]] size_t size_approx() { return _local().size_approx(); }
+
+    // Of every ring
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return Size; }
+
+    // Slots of the rings alive, retired ones included until drained
+    [[nodiscard]] QueueMemory memory() const noexcept
+    {
+        return QueueMemory{.bytes = _ring_count.load(std::memory_order_relaxed) * Size * sizeof(T)};
+    }
+
+    // Moves the oldest item among the rings into `item`, returns false if all are empty
+    template<typename Key>
+    bool pop(T& item, Key&& key)
+    {
+        Ring* oldest = nullptr;
+        T* oldest_front = nullptr;
+
+        if (_has_pending.load(std::memory_order_acquire)) {
+            _adopt_pending();
+        }
+        for (size_t i = 0; i < _rings.size();) {
+            Ring* ring = _rings[i].get();
+            T* front = ring->queue.front();
+
+            if (!front) {
+                // The last push happens before `retired` is set, re-check before dropping
+                if (ring->retired.load(std::memory_order_acquire) && !ring->queue.front()) {
+                    _rings[i] = std::move(_rings.back());
+                    _rings.pop_back();
+                    _ring_count.fetch_sub(1, std::memory_order_relaxed);
+                    continue;
+                }
+                i++;
+                continue;
+            }
+            if (!oldest || key(*front) < key(*oldest_front)) {
+                oldest = ring;
+                oldest_front = front;
+            }
+            i++;
+        }
+        return oldest ? oldest->queue.pop(item) : false;
+    }
+
+    // Consumer side: true only if all the rings, including the ones not adopted yet, are empty
+    [[nodiscard]] bool empty()
+    {
+        if (_has_pending.load(std::memory_order_acquire)) {
+            _adopt_pending();
+        }
+        for (auto& ring : _rings) {
+            if (ring->queue.front()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Consumer side: the smallest `key` among the front items of the rings, including the ones
+    // not adopted yet, or `bound` if all are empty
+    template<typename K, typename Key>
+    [[nodiscard]] K min_front(K bound, Key&& key)
+    {
+        if (_has_pending.load(std::memory_order_acquire)) {
+            _adopt_pending();
+        }
+        for (auto& ring : _rings) {
+            if (T* front = ring->queue.front()) {
+                bound = std::min<K>(bound, key(*front));
+            }
+        }
+        return bound;
+    }
+
+    // Consumer side: items in the rings adopted so far, a snapshot
+    [[nodiscard]] size_t pending() const noexcept
+    {
+        size_t pending = 0;
+
+        for (const auto& ring : _rings) {
+            pending += ring->queue.size_approx();
+        }
+        return pending;
+    }
+
+    // Rings registered to the consumer (including retired ones not drained yet)
+    [[nodiscard]] size_t size() const noexcept { return _rings.size(); }
+
+private:
+    struct Ring
+    {
+        Queue queue;
+        std::atomic<bool> retired{false};
+    };
+
+    // Thread side handle: one ring per instance the thread pushed to (e.g. one per worker),
+    // all retired when the thread exits
+    struct LocalRings
+    {
+        struct Entry
+        {
+            uint64_t owner;
+            std::shared_ptr<Ring> ring;
+        };
+
+        std::vector<Entry> entries;
+        uint64_t last_owner{0};
+        Queue* last_queue{nullptr};
+
+        ~LocalRings()
+        {
+            for (Entry& entry : entries) {
+                entry.ring->retired.store(true, std::memory_order_release);
+            }
+        }
+    };
+
+    SLOG_ALWAYS_INLINE Queue& _local()
+    {
+        static thread_local LocalRings local;
+
+        if (local.last_owner != _id) [[unlikely]] {
+            _switch(local);
+        }
+        return *local.last_queue;
+    }
+
+    void _switch(LocalRings& local)
+    {
+        typename LocalRings::Entry* found = nullptr;
+
+        // Rings only referenced by the thread belong to destroyed instances
+        std::erase_if(local.entries, [](const auto& entry) { return entry.ring.use_count() == 1; });
+        for (auto& entry : local.entries) {
+            if (entry.owner == _id) {
+                found = &entry;
+                break;
+            }
+        }
+        if (!found) {
+            auto ring = std::make_shared<Ring>();
+
+            _ring_count.fetch_add(1, std::memory_order_relaxed);
+
+            {
+                std::lock_guard<std::mutex> lock(_pending_mutex);
+                _pending.push_back(ring);
+                _has_pending.store(true, std::memory_order_release);
+            }
+            local.entries.push_back({_id, std::move(ring)});
+            found = &local.entries.back();
+        }
+        local.last_owner = _id;
+        local.last_queue = &found->ring->queue;
+    }
+
+    void _adopt_pending()
+    {
+        std::lock_guard<std::mutex> lock(_pending_mutex);
+
+        for (auto& ring : _pending) {
+            _rings.push_back(std::move(ring));
+        }
+        _pending.clear();
+        _has_pending.store(false, std::memory_order_relaxed);
+    }
+
+    // Ids start at 1, 0 marks a thread that never pushed
+    static inline std::atomic<uint64_t> _next_id{1};
+
+    uint64_t _id;
+    std::vector<std::shared_ptr<Ring>> _rings; // consumer only
+    std::mutex _pending_mutex;
+    std::vector<std::shared_ptr<Ring>> _pending;
+    std::atomic<bool> _has_pending{false};
+    std::atomic<size_t> _ring_count{0};
+};
+
+} // namespace slog::async
+
+#endif // SLOG_ASYNC_THREAD_QUEUES_HPP
@@ -3,24 +3,54 @@
 
 #ifdef SLOG_ASYNC_ENABLED
 
+    #include <algorithm>
+    #include <array>
     #include <atomic>
+    #include <chrono>
+    #include <cstdint>
+    #include <format>
+    #include <iterator>
+    #include <memory>
+    #include <mutex>
     #include <new>
+    #include <span>
+    #include <string>
+    #include <string_view>
     #include <thread>
 
     #include <slog/async/async_op.hpp>
+    #include <slog/async/byte_ring_queue.hpp>
+    #include <slog/async/encoded_record.hpp>
+    #include <slog/async/idle_strategy.hpp>
+    #include <slog/async/manager_table.hpp>
     #include <slog/async/mpsc_queue.hpp>
     #include <slog/async/policies.hpp>
+    #include <slog/async/queue_memory.hpp>
+    #include <slog/async/stats.hpp>
+    #include <slog/async/thread_queues.hpp>
     #include <slog/config_macros.hpp>
+    #include <slog/details/clock.hpp>
     #include <slog/details/macros.hpp>
+    #include <slog/details/thread_context.hpp>
     #include <slog/sinks/sink_manager.hpp>
 
+    #if defined(SLOG_ASYNC_BYTE_QUEUE) && defined(SLOG_ASYNC_THREAD_QUEUES)
+        #error "SLOG_ASYNC_BYTE_QUEUE and SLOG_ASYNC_THREAD_QUEUES are mutually exclusive"
+    #endif
+
 namespace slog::async
 {
 
 class Worker
 {
 public:
-    Worker() : _running(true), _worker_thread(&Worker::_loop, this) {}
+    // `queue` sizes and backs the ring, see QueueOptions
+    explicit Worker(IdleStrategy idle = IdleStrategy::block(), const QueueOptions& queue = {})
+        : _queue(queue), _running(true)
+    {
+        set_idle_strategy(idle);
+        _worker_thread = std::thread(&Worker::_loop, this);
+    }
 
     Worker(const Worker&) = delete;
     Worker(Worker&&) = delete;
@@ -34,23 +64,47 @@ public:
         join();
     }
 
+    // Returns false if the record has been dropped (queue full, see QueueFullPolicy)
     SLOG_ALWAYS_INLINE bool push(AsyncOp&& op)
     {
-        bool ret = _queue.push(std::move(op));
+        ManagerHandle handle = op.manager;
+        const slog::details::ThreadContext* thread = op.record.thread;
 
-        if (ret && !_flag.exchange(true, std::memory_order_release)) {
-            _flag.notify_one();
+        op.epoch = _managers_table.epoch();
+        // Released by the worker once the record is consumed
+        if (thread) {
+            thread->retain();
+        }
+
+        QueueFullPolicy::Mode mode = _full_mode.load(std::memory_order_relaxed);
+        bool ret = mode == QueueFullPolicy::Mode::BLOCK ? _push(op, BlockOnFull{})
+                                                        : _push_with(mode, op);
+        ProducerStats::Shard& shard = _producer_stats.local();
+
+        if (ret) {
+            shard.enqueued.fetch_add(1, std::memory_order_relaxed);
+            _wake();
+        }
+        else {
+            if (thread) {
+                thread->release();
+            }
+            _count_drop(handle, shard);
+        }
+        if (detail::producer_wait_ns != 0) [[unlikely]] {
+            shard.wait_ns.fetch_add(detail::producer_wait_ns, std::memory_order_relaxed);
+            detail::producer_wait_ns = 0;
         }
         return ret;
     }
 
     SLOG_ALWAYS_INLINE void stop()
     {
-        if (!_flag.load(std::memory_order_acquire)) {
-            _flag.store(true, std::memory_order_release);
-            _flag.notify_one();
-        }
-        _running.store(false, std::memory_order_release);
+        // `_running` must be cleared before raising the flag, the loop re-checks it after
+        // lowering the flag so the wake up can't get lost
+        _running.store(false, std::memory_order_seq_cst);
+        _flag.store(true, std::memory_order_seq_cst);
+        _flag.notify_one();
     }
 
     SLOG_ALWAYS_INLINE void join()
@@ -60,34 +114,549 @@ public:
         }
     }
 
+    // Binds a sink manager to the worker, the handle goes in the records pushed for it
+    [[nodiscard]] ManagerHandle attach(std::shared_ptr<slog::sinks::SinkManager> manager,
+                                       std::string_view logger_name = {})
+    {
+        return _managers_table.attach(std::move(manager), logger_name);
+    }
+
+    // The manager is released once the records already pushed with `handle` are consumed
+    void detach(ManagerHandle handle)
+    {
+        _managers_table.detach(handle);
+        _wake();
+    }
+
+    // Taken into account from the next time the queue is found empty
+    void set_idle_strategy(IdleStrategy idle) noexcept
+    {
+        _idle_spins.store(idle.spins, std::memory_order_relaxed);
+        _idle_yields.store(idle.yields, std::memory_order_relaxed);
+        _idle_mode.store(idle.mode, std::memory_order_relaxed);
+    }
+
+    // Taken into account by the next push
+    void set_queue_full_policy(QueueFullPolicy policy) noexcept
+    {
+        double watermark = policy.watermark < 0.0 ? 0.0 : (policy.watermark > 1.0 ? 1.0 : policy.watermark);
+
+        _keep_level.store(policy.keep, std::memory_order_relaxed);
+        _shed_size.store(static_cast<size_t>(watermark * static_cast<double>(_queue.capacity())),
+                         std::memory_order_relaxed);
+        _wait_timeout.store(policy.timeout.count(), std::memory_order_relaxed);
+        _full_mode.store(policy.mode, std::memory_order_relaxed);
+    }
+
+    // Records dropped so far, reported or not
+    [[nodiscard]] uint64_t dropped() const noexcept { return _producer_stats.dropped(); }
+
+    // Lock free, the counters are read one by one: the snapshot is not atomic as a whole
+    [[nodiscard]] WorkerStats stats() const noexcept
+    {
+        WorkerStats snapshot;
+        uint64_t evicted = 0;
+
+        // Dequeued first, it can only lag the producer counters read afterwards
+        snapshot.dequeued = dispatched();
+        _producer_stats.collect(snapshot, evicted);
+        snapshot.depth = snapshot.enqueued > evicted + snapshot.dequeued ? snapshot.enqueued - evicted - snapshot.dequeued : 0;
+        snapshot.high_water = _high_water.load(std::memory_order_relaxed);
+        snapshot.capacity = _queue.capacity();
+        snapshot.busy = std::chrono::nanoseconds(_busy_ns.load(std::memory_order_relaxed));
+        snapshot.idle = std::chrono::nanoseconds(_idle_ns.load(std::memory_order_relaxed));
+        snapshot.wakeups = _wakeups.load(std::memory_order_relaxed);
+        snapshot.memory = _queue.memory();
+        return snapshot;
+    }
+
+    // Every `interval` the worker dispatches its stats as an INFO record to `manager`, under
+    // `logger_name`. The record is emitted by a worker with records to process, an idle worker
+    // stays parked. A zero interval stops it.
+    void set_stats_reporting(std::shared_ptr<slog::sinks::SinkManager> manager, std::string_view logger_name,
+                             std::chrono::milliseconds interval)
+    {
+        std::lock_guard<std::mutex> lock(_stats_mutex);
+
+        _stats_manager = std::move(manager);
+        _stats_logger_name = logger_name;
+        _stats_interval_ns.store(_stats_manager ? std::chrono::nanoseconds(interval).count() : 0,
+                                 std::memory_order_relaxed);
+    }
+
+    // Records dispatched so far, written by the worker thread only
+    [[nodiscard]] SLOG_ALWAYS_INLINE uint64_t dispatched() const noexcept
+    {
+        return _dispatched.load(std::memory_order_relaxed);
+    }
+
 private:
-    void _loop()
+    #ifdef SLOG_ASYNC_BYTE_QUEUE
+    using Queue = ByteRingQueue<SLOG_BYTE_QUEUE_SIZE, BlockOnFull>;
+    #elif defined(SLOG_ASYNC_THREAD_QUEUES)
+    using Queue = ThreadQueues<AsyncOp, SLOG_SPSC_QUEUE_SIZE, BlockOnFull>;
+    #else
+    using Queue = MPSCQueue<AsyncOp, SLOG_MPSC_QUEUE_SIZE, BlockOnFull>;
+    #endif
+
+    template<typename P>
+    SLOG_ALWAYS_INLINE bool _push(AsyncOp& op, const P& policy)
     {
-        AsyncOp op;
+    #ifdef SLOG_ASYNC_BYTE_QUEUE
+        return _queue.push(
+            EncodedRecord::encoded_size(op),
+            [&op](std::byte* dst) { EncodedRecord::encode(dst, std::move(op)); }, policy);
+    #else
+        return _queue.push(std::move(op), policy);
+    #endif
+    }
 
+    // Policies other than BLOCK, kept out of the inlined push
+    bool _push_with(QueueFullPolicy::Mode mode, AsyncOp& op)
+    {
+        switch (mode) {
+        case QueueFullPolicy::Mode::DISCARD:
+            return _push(op, DiscardOnFull{});
+        case QueueFullPolicy::Mode::DROP_OLDEST:
+            return _push(op, DropOldestOnFull<EvictCounter>{EvictCounter{this}});
+        case QueueFullPolicy::Mode::DROP_BY_LEVEL:
+            if (op.record.level > _keep_level.load(std::memory_order_relaxed) &&
+                _queue.size_approx() >= _shed_size.load(std::memory_order_relaxed)) {
+                return false;
+            }
+            return _push(op, BlockOnFull{});
+        case QueueFullPolicy::Mode::WAIT:
+            return _push(op, WaitOnFull{std::chrono::nanoseconds(
+                                 _wait_timeout.load(std::memory_order_relaxed))});
+        case QueueFullPolicy::Mode::BLOCK:
+            break;
+        }
+        return _push(op, BlockOnFull{});
+    }
+
+    struct EvictCounter
+    {
+        Worker* worker;
+
+        void operator()(const AsyncOp& evicted) const noexcept
+        {
+            ProducerStats::Shard& shard = worker->_producer_stats.local();
+
+            shard.evicted.fetch_add(1, std::memory_order_relaxed);
+            worker->_count_drop(evicted.manager, shard);
+            if (evicted.record.thread) {
+                evicted.record.thread->release();
+            }
+        }
+    };
+
+    void _count_drop(ManagerHandle handle, ProducerStats::Shard& shard) noexcept
+    {
+        _managers_table.count_drop(handle);
+        shard.dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    SLOG_ALWAYS_INLINE void _wake()
+    {
+        // The pushed record must be visible before the flag is read, pairs with the loop
+        // lowering the flag and re-checking the queue. While the worker is awake, polling
+        // included, the flag is only read: producers neither bounce its cacheline nor notify.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!_flag.load(std::memory_order_relaxed) &&
+            !_flag.exchange(true, std::memory_order_release)) {
+            _flag.notify_one();
+        }
+    }
+
+    void _loop()
+    {
+        _drain_end = std::chrono::steady_clock::now();
         while (_running.load(std::memory_order_relaxed)) {
-            while (_queue.pop(op)) {
-                op.sink_manager->dispatch(op.record);
+            _drain();
+            if (_poll()) {
+                continue;
             }
 
-            _flag.store(false, std::memory_order_release);
-            if (!_queue.pop(op)) {
+            _flag.store(false, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!_drain()) {
+                _reclaim();
+                if (!_running.load(std::memory_order_seq_cst)) {
+                    break;
+                }
                 _flag.wait(false, std::memory_order_acquire);
             }
-            else {
-                op.sink_manager->dispatch(op.record);
+        }
+
+        _drain();
+    }
+
+    // Consumes until the queue is empty, returns false if it was already. The time since the
+    // previous drain is accounted as idle, the drain itself as busy: two clock reads per wakeup.
+    bool _drain()
+    {
+        _sample_occupancy();
+
+        size_t count = _collect();
+
+        if (count == 0) {
+            return false;
+        }
+
+        auto begin = std::chrono::steady_clock::now();
+
+        _idle_ns.store(_idle_ns.load(std::memory_order_relaxed) + _nanoseconds(begin - _drain_end),
+                       std::memory_order_relaxed);
+        _wakeups.store(_wakeups.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        _process(count);
+        while (_consume()) {
+        }
+        _report_drops();
+        _drain_end = std::chrono::steady_clock::now();
+        _busy_ns.store(_busy_ns.load(std::memory_order_relaxed) + _nanoseconds(_drain_end - begin),
+                       std::memory_order_relaxed);
+        if (_stats_interval_ns.load(std::memory_order_relaxed) != 0) {
+            _report_stats(_drain_end);
+        }
+        return true;
+    }
+
+    [[nodiscard]] SLOG_ALWAYS_INLINE static uint64_t _nanoseconds(std::chrono::steady_clock::duration d) noexcept
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+    }
+
+    // One read of the producers' index per batch. Blocked producers reserve past the capacity,
+    // they are not counted.
+    SLOG_ALWAYS_INLINE void _sample_occupancy() noexcept
+    {
+    #ifdef SLOG_ASYNC_THREAD_QUEUES
+        uint64_t occupancy = std::min<uint64_t>(_queue.pending(), _queue.capacity());
+    #else
+        uint64_t occupancy = std::min<uint64_t>(_queue.size_approx(), _queue.capacity());
+    #endif
+
+        if (occupancy > _high_water.load(std::memory_order_relaxed)) {
+            _high_water.store(occupancy, std::memory_order_relaxed);
+        }
+    }
+
+    // Waits for records with the flag still raised, returns false when the worker has to park
+    bool _poll()
+    {
+        IdleStrategy::Mode mode = _idle_mode.load(std::memory_order_relaxed);
+
+        if (mode == IdleStrategy::Mode::BLOCK) {
+            return false;
+        }
+        if (mode == IdleStrategy::Mode::SPIN) {
+            while (_running.load(std::memory_order_relaxed)) {
+                if (!_queue.empty()) {
+                    return true;
+                }
+                _reclaim();
+                SLOG_CPU_PAUSE();
+            }
+            return false;
+        }
+
+        uint32_t spins = _idle_spins.load(std::memory_order_relaxed);
+        uint32_t yields = _idle_yields.load(std::memory_order_relaxed);
+
+        for (uint32_t i = 0; i < spins; i++) {
+            if (!_queue.empty()) {
+                return true;
+            }
+            _reclaim();
+            SLOG_CPU_PAUSE();
+        }
+        for (uint32_t i = 0; i < yields; i++) {
+            if (!_queue.empty()) {
+                return true;
+            }
+            _reclaim();
+            std::this_thread::yield();
+        }
+        return false;
+    }
+
+    // Frees the managers no queued record can reference anymore. Called after every batch and
+    // while idle, a busy queue doesn't hold them back: the records consumed tell how far the
+    // producers are.
+    void _reclaim()
+    {
+        if (!_managers_table.has_retired()) {
+            return;
+        }
+
+        uint64_t epoch = _managers_table.epoch();
+
+    #ifdef SLOG_ASYNC_THREAD_QUEUES
+        // Rings are merged by timestamp, but every ring is pushed by a single thread and so
+        // stamped in increasing epochs: only the fronts can hold records of a retired handle
+        epoch = _queue.min_front(epoch, [](const AsyncOp& o) { return o.epoch; });
+    #else
+        // FIFO queue: a record stamped with the retirement epoch has been pushed after all the
+        // records of the handle
+        if (!_queue.empty()) {
+            epoch = _consumed_epoch;
+        }
+    #endif
+        _managers_table.reclaim(epoch);
+    }
+
+    // Dispatches up to SLOG_ASYNC_BATCH_SIZE records, returns false if the queue is empty
+    bool _consume()
+    {
+        _sample_occupancy();
+
+        size_t count = _collect();
+
+        if (count == 0) {
+            return false;
+        }
+        _process(count);
+        // A queue that never drains still reports, the clock is only read when there is something to
+        if ((_managers_table.has_dropped() || _stats_interval_ns.load(std::memory_order_relaxed) != 0)) [[unlikely]] {
+            auto now = std::chrono::steady_clock::now();
+
+            if (_managers_table.has_dropped() && now - _last_report >= DROP_REPORT_INTERVAL) {
+                _report_drops();
+            }
+            _report_stats(now);
+        }
+        return true;
+    }
+
+    SLOG_ALWAYS_INLINE void _process(size_t count)
+    {
+        uint64_t epoch = _batch_epoch(count);
+
+        _dispatch(count);
+        _release_threads(count);
+        _release(count);
+        _dispatched.store(_dispatched.load(std::memory_order_relaxed) + count,
+                          std::memory_order_relaxed);
+        if (epoch > _consumed_epoch) {
+            _consumed_epoch = epoch;
+        }
+        _reclaim();
+    }
+
+    // Latest epoch the records of the batch were stamped with, they aren't pushed in epoch order
+    [[nodiscard]] SLOG_ALWAYS_INLINE uint64_t _batch_epoch(size_t count) const noexcept
+    {
+        uint64_t epoch = 0;
+
+        for (size_t i = 0; i < count; i++) {
+    #ifdef SLOG_ASYNC_BYTE_QUEUE
+            epoch = std::max(epoch, _encoded[i]->epoch);
+    #else
+            epoch = std::max(epoch, _batch[i].epoch);
+    #endif
+        }
+        return epoch;
+    }
+
+    // Dispatches the stats record once the interval has elapsed since the last one
+    void _report_stats(std::chrono::steady_clock::time_point now)
+    {
+        auto interval = std::chrono::nanoseconds(_stats_interval_ns.load(std::memory_order_relaxed));
+
+        if (interval.count() == 0 || now - _last_stats < interval) {
+            return;
+        }
+        _last_stats = now;
+
+        std::shared_ptr<slog::sinks::SinkManager> manager;
+        std::string logger_name;
+
+        {
+            std::lock_guard<std::mutex> lock(_stats_mutex);
+
+            manager = _stats_manager;
+            logger_name = _stats_logger_name;
+        }
+        if (!manager) {
+            return;
+        }
+
+        const slog::details::ThreadContext& thread = slog::details::ThreadContext::current();
+        WorkerStats snapshot = stats();
+        LogRecord record;
+
+        record.level = LogLevel::INFO;
+        record.logger_name = logger_name;
+        record.timestamp = slog::details::Clock::now();
+        record.thread_id = thread.id();
+        record.thread = &thread;
+        std::format_to(std::back_inserter(record.string_buffer),
+                       "async stats: enqueued {} dequeued {} dropped {} depth {} high water {}/{} "
+                       "producer wait {}us busy {}us idle {}us wakeups {} ({:.1f} records per wakeup) "
+                       "queue memory {}KiB ({})",
+                       snapshot.enqueued, snapshot.dequeued, snapshot.dropped, snapshot.depth, snapshot.high_water,
+                       snapshot.capacity, snapshot.producer_wait.count() / 1000, snapshot.busy.count() / 1000,
+                       snapshot.idle.count() / 1000, snapshot.wakeups, snapshot.records_per_wakeup(),
+                       snapshot.memory.bytes / 1024, to_string(snapshot.memory.backing));
+        manager->dispatch(record);
+    }
+
+    // Dispatches one "N messages dropped" warning per logger that lost records since the last call
+    void _report_drops()
+    {
+        if (!_managers_table.has_dropped()) {
+            return;
+        }
+        _last_report = std::chrono::steady_clock::now();
+        _managers_table.collect_drops(
+            [](slog::sinks::SinkManager& manager, std::string_view logger_name, uint64_t count) {
+                const slog::details::ThreadContext& thread = slog::details::ThreadContext::current();
+                LogRecord record;
+
+                record.level = LogLevel::WARNING;
+                record.logger_name = logger_name;
+                record.timestamp = slog::details::Clock::now();
+                record.thread_id = thread.id();
+                record.thread = &thread;
+                record.string_buffer = std::to_string(count);
+                record.string_buffer.append(count == 1 ? " message dropped" : " messages dropped");
+                manager.dispatch(record);
+            });
+    }
+
+    // Fills `_records`/`_managers` with the oldest records
+    SLOG_ALWAYS_INLINE size_t _collect()
+    {
+        size_t count = 0;
+
+    #ifdef SLOG_ASYNC_BYTE_QUEUE
+        // Records are decoded in place and stay in the ring until _release()
+        count = _queue.peek(BATCH_SIZE, [&](std::byte* data, size_t) {
+            EncodedRecord* enc = EncodedRecord::from(data);
+
+            enc->decode(_batch[count]);
+            _encoded[count] = enc;
+            _records[count] = &_batch[count];
+            _managers[count] = _managers_table.get(enc->manager);
+            count++;
+        });
+    #else
+        while (count < BATCH_SIZE && _pop(_batch[count])) {
+            _records[count] = &_batch[count].record;
+            _managers[count] = _managers_table.get(_batch[count].manager);
+            count++;
+        }
+    #endif
+        return count;
+    }
+
+    #ifndef SLOG_ASYNC_BYTE_QUEUE
+    SLOG_ALWAYS_INLINE bool _pop(AsyncOp& op)
+    {
+        #ifdef SLOG_ASYNC_THREAD_QUEUES
+        // Per-thread rings are merged in timestamp order
+        return _queue.pop(op, [](const AsyncOp& o) { return o.record.timestamp; });
+        #else
+        return _queue.pop(op);
+        #endif
+    }
+    #endif
+
+    // Groups the batch by sink manager, keeping the push order inside every group
+    void _dispatch(size_t count)
+    {
+        for (size_t i = 0; i < count; i++) {
+            slog::sinks::SinkManager* manager = _managers[i];
+            size_t group_size = 0;
+
+            if (!manager) {
+                continue;
+            }
+            for (size_t j = i; j < count; j++) {
+                if (_managers[j] == manager) {
+                    _group[group_size++] = _records[j];
+                    _managers[j] = nullptr;
+                }
             }
+            manager->dispatch(std::span<LogRecord* const>(_group.data(), group_size));
         }
+    }
+
+    // Drops the references of the batch to the contexts of the logging threads, one call per
+    // run of records of the same thread
+    SLOG_ALWAYS_INLINE void _release_threads(size_t count) noexcept
+    {
+        const slog::details::ThreadContext* thread = nullptr;
+        size_t run = 0;
+
+        for (size_t i = 0; i < count; i++) {
+            if (_records[i]->thread != thread) {
+                if (thread) {
+                    thread->release(run);
+                }
+                thread = _records[i]->thread;
+                run = 0;
+            }
+            run++;
+        }
+        if (thread) {
+            thread->release(run);
+        }
+    }
 
-        while (_queue.pop(op)) {
-            op.sink_manager->dispatch(op.record);
+    SLOG_ALWAYS_INLINE void _release(size_t count)
+    {
+    #ifdef SLOG_ASYNC_BYTE_QUEUE
+        for (size_t i = 0; i < count; i++) {
+            _encoded[i]->destroy();
         }
+        _queue.release();
+    #else
+        (void)count;
+    #endif
     }
 
-    MPSCQueue<AsyncOp, SLOG_MPSC_QUEUE_SIZE, BlockOnFull> _queue;
+    static constexpr size_t BATCH_SIZE = SLOG_ASYNC_BATCH_SIZE;
+    static constexpr std::chrono::milliseconds DROP_REPORT_INTERVAL{SLOG_ASYNC_DROP_REPORT_MS};
+
+    ManagerTable _managers_table;
+    Queue _queue;
+    #ifdef SLOG_ASYNC_BYTE_QUEUE
+    // Records only keep the string capacity around, the arguments are read from the ring
+    std::array<LogRecord, BATCH_SIZE> _batch;
+    std::array<EncodedRecord*, BATCH_SIZE> _encoded;
+    #else
+    std::array<AsyncOp, BATCH_SIZE> _batch;
+    #endif
+    std::array<LogRecord*, BATCH_SIZE> _records;
+    std::array<slog::sinks::SinkManager*, BATCH_SIZE> _managers;
+    std::array<LogRecord*, BATCH_SIZE> _group;
+    uint64_t _consumed_epoch{0};
+    std::atomic<IdleStrategy::Mode> _idle_mode{IdleStrategy::Mode::BLOCK};
+    std::atomic<uint32_t> _idle_spins{0};
+    std::atomic<uint32_t> _idle_yields{0};
+    std::chrono::steady_clock::time_point _last_report{std::chrono::steady_clock::now()};
+    std::chrono::steady_clock::time_point _last_stats{std::chrono::steady_clock::now()};
+    std::chrono::steady_clock::time_point _drain_end{};
+    std::mutex _stats_mutex;
+    std::shared_ptr<slog::sinks::SinkManager> _stats_manager;
+    std::string _stats_logger_name;
     SLOG_DISABLE_PADDING_WARNING
+    // Read by every push, written only by set_queue_full_policy()
+    alignas(SLOG_CACHELINE_SIZE) std::atomic<QueueFullPolicy::Mode> _full_mode{QueueFullPolicy::Mode::BLOCK};
+    std::atomic<LogLevel> _keep_level{LogLevel::OFF};
+    std::atomic<size_t> _shed_size{0};
+    std::atomic<int64_t> _wait_timeout{0};
+    std::atomic<int64_t> _stats_interval_ns{0};
+    ProducerStats _producer_stats;
     alignas(SLOG_CACHELINE_SIZE) std::atomic<bool> _running;
     alignas(SLOG_CACHELINE_SIZE) std::atomic<bool> _flag{true};
+    // Worker written stats, one cacheline for all of them
+    alignas(SLOG_CACHELINE_SIZE) std::atomic<uint64_t> _dispatched{0};
+    std::atomic<uint64_t> _high_water{0};
+    std::atomic<uint64_t> _busy_ns{0};
+    std::atomic<uint64_t> _idle_ns{0};
+    std::atomic<uint64_t> _wakeups{0};
     SLOG_RESTORE_PADDING_WARNING
     std::thread _worker_thread;
 };
@@ -0,0 +1,158 @@
+#ifndef SLOG_ASYNC_WORKER_POOL_HPP
+#define SLOG_ASYNC_WORKER_POOL_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <slog/async/idle_strategy.hpp>
+#include <slog/async/policies.hpp>
+#include <slog/async/queue_memory.hpp>
+#include <slog/async/stats.hpp>
+#include <slog/async/worker.hpp>
+#include <slog/config_macros.hpp>
+
+namespace slog::async
+{
+
+// How a logger is assigned to a worker when it is not pinned explicitly
+enum class Sharding : uint8_t
+{
+    HASH,        // hash of the logger name, stable across runs
+    LEAST_LOADED // worker with the fewest loggers, then the fewest dispatched records
+};
+
+struct WorkerCounters
+{
+    size_t loggers{0};
+    uint64_t dispatched{0};
+    uint64_t dropped{0};
+};
+
+} // namespace slog::async
+
+#ifdef SLOG_ASYNC_ENABLED
+
+    #include <functional>
+
+namespace slog::async
+{
+
+// Fixed set of workers. A logger is bound to a single worker for its whole life, so the
+// records of a logger are always consumed by the same thread in push order.
+// Not thread safe: the registry calls it under its own lock.
+class WorkerPool
+{
+public:
+    // Every worker builds its queue with `queue`
+    explicit WorkerPool(size_t size, const QueueOptions& queue = {})
+    {
+        size = size ? size : 1;
+        _workers.reserve(size);
+        _loggers.resize(size, 0);
+        for (size_t i = 0; i < size; i++) {
+            _workers.push_back(std::make_shared<Worker>(IdleStrategy::block(), queue));
+        }
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    [[nodiscard]] std::shared_ptr<Worker> assign(std::string_view logger_name, Sharding sharding)
+    {
+        size_t index = 0;
+
+        if (sharding == Sharding::HASH) {
+            index = std::hash<std::string_view>{}(logger_name) % _workers.size();
+        }
+        else {
+            for (size_t i = 1; i < _workers.size(); i++) {
+                if (_loggers[i] < _loggers[index] ||
+                    (_loggers[i] == _loggers[index] &&
+                     _workers[i]->dispatched() < _workers[index]->dispatched())) {
+                    index = i;
+                }
+            }
+        }
+        return pin(index);
+    }
+
+    // Out of range indexes wrap around
+    [[nodiscard]] std::shared_ptr<Worker> pin(size_t index)
+    {
+        index %= _workers.size();
+        _loggers[index]++;
+        return _workers[index];
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return _workers.size(); }
+
+    void set_idle_strategy(IdleStrategy idle) noexcept
+    {
+        for (const std::shared_ptr<Worker>& worker : _workers) {
+            worker->set_idle_strategy(idle);
+        }
+    }
+
+    void set_queue_full_policy(QueueFullPolicy policy) noexcept
+    {
+        for (const std::shared_ptr<Worker>& worker : _workers) {
+            worker->set_queue_full_policy(policy);
+        }
+    }
+
+    // Reported by every worker, each through its own dispatch of the record
+    void set_stats_reporting(std::shared_ptr<slog::sinks::SinkManager> manager, std::string_view logger_name,
+                             std::chrono::milliseconds interval)
+    {
+        for (const std::shared_ptr<Worker>& worker : _workers) {
+            worker->set_stats_reporting(manager, logger_name, interval);
+        }
+    }
+
+    [[nodiscard]] std::vector<WorkerStats> stats() const
+    {
+        std::vector<WorkerStats> stats;
+
+        stats.reserve(_workers.size());
+        for (const std::shared_ptr<Worker>& worker : _workers) {
+            stats.push_back(worker->stats());
+        }
+        return stats;
+    }
+
+    [[nodiscard]] std::vector<WorkerCounters> counters() const
+    {
+        std::vector<WorkerCounters> counters(_workers.size());
+
+        for (size_t i = 0; i < _workers.size(); i++) {
+            counters[i].loggers = _loggers[i];
+            counters[i].dispatched = _workers[i]->dispatched();
+            counters[i].dropped = _workers[i]->dropped();
+        }
+        return counters;
+    }
+
+private:
+    std::vector<std::shared_ptr<Worker>> _workers;
+    std::vector<size_t> _loggers;
+};
+
+} // namespace slog::async
+
+#else
+
+namespace slog::async
+{
+struct WorkerPool
+{
+    explicit WorkerPool(size_t, const QueueOptions& = {}) {}
+};
+}
+
+#endif // SLOG_ASYNC_ENABLED
+
+#endif // SLOG_ASYNC_WORKER_POOL_HPP
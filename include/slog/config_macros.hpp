@@ -25,6 +25,98 @@
     #define SLOG_MPSC_QUEUE_SIZE 8192
 #endif
 
+// ----------------------------------------
+// MPSC slots prefetched ahead by the consumer with SLOG_MPSC_PACKED_SLOTS, 0 disables it
+// ----------------------------------------
+
+#ifndef SLOG_MPSC_PREFETCH_DISTANCE
+    #define SLOG_MPSC_PREFETCH_DISTANCE 2
+#endif
+
+// ----------------------------------------
+// Byte Queue Size (bytes), used with SLOG_ASYNC_BYTE_QUEUE
+// ----------------------------------------
+
+#ifndef SLOG_BYTE_QUEUE_SIZE
+    #define SLOG_BYTE_QUEUE_SIZE (1 << 20)
+#endif
+
+// ----------------------------------------
+// Per-thread SPSC Queue Size, used with SLOG_ASYNC_THREAD_QUEUES
+// ----------------------------------------
+
+#ifndef SLOG_SPSC_QUEUE_SIZE
+    #define SLOG_SPSC_QUEUE_SIZE 1024
+#endif
+
+// ----------------------------------------
+// Default number of async workers, Registry::set_worker_count overrides it
+// ----------------------------------------
+
+#ifndef SLOG_ASYNC_WORKERS
+    #define SLOG_ASYNC_WORKERS 1
+#endif
+
+// ----------------------------------------
+// Records dequeued by a worker per batch
+// ----------------------------------------
+
+#ifndef SLOG_ASYNC_BATCH_SIZE
+    #define SLOG_ASYNC_BATCH_SIZE 64
+#endif
+
+// ----------------------------------------
+// Worker idle polling budgets (IdleStrategy::backoff)
+// ----------------------------------------
+
+#ifndef SLOG_ASYNC_IDLE_SPINS
+    #define SLOG_ASYNC_IDLE_SPINS 2048
+#endif
+
+#ifndef SLOG_ASYNC_IDLE_YIELDS
+    #define SLOG_ASYNC_IDLE_YIELDS 64
+#endif
+
+// ----------------------------------------
+// Longest delay before the records dropped on a full queue are reported, in milliseconds
+// ----------------------------------------
+
+#ifndef SLOG_ASYNC_DROP_REPORT_MS
+    #define SLOG_ASYNC_DROP_REPORT_MS 1000
+#endif
+
+// ----------------------------------------
+// Producer counter shards of a worker (async stats), power of 2
+// ----------------------------------------
+
+#ifndef SLOG_ASYNC_STATS_SHARDS
+    #define SLOG_ASYNC_STATS_SHARDS 16
+#endif
+
+// ----------------------------------------
+// Maximum number of loggers bound to a worker
+// ----------------------------------------
+
+#ifndef SLOG_MAX_LOGGERS
+    #define SLOG_MAX_LOGGERS 1024
+#endif
+
+// ----------------------------------------
+// TSC clock re-anchoring period (SLOG_CLOCK_TSC)
+// ----------------------------------------
+
+#ifndef SLOG_TSC_CALIBRATION_MS
+    #define SLOG_TSC_CALIBRATION_MS 1000
+#endif
+
+// ----------------------------------------
+// Inline format arguments buffer size (bytes)
+// ----------------------------------------
+
+#ifndef SLOG_ARG_BUFFER_SIZE
+    #define SLOG_ARG_BUFFER_SIZE 128
+#endif
+
 // ----------------------------------------
 // Default and Inactive loggers and sinks name
 // ----------------------------------------
@@ -53,12 +145,17 @@
 // Async mode macros
 // ----------------------------------------
 
-#ifdef SLOG_ASYNC_ENABLED
-    #define SLOG_SINK_MUTEX_MEMBER(name)
-    #define SLOG_SINK_LOCK(name)
+// A single worker is the only writer of every sink, with more workers (a runtime choice) a
+// sink can be shared by loggers assigned to different workers: async sinks lock only when
+// `condition` holds
+#if defined(SLOG_ASYNC_ENABLED) && defined(SLOG_TSAFE_ENABLED)
+    #define SLOG_SINK_LOCK_IF(name, condition)                                                   \
+        std::unique_lock<std::mutex> lock(name, std::defer_lock);                                \
+        if (condition) {                                                                         \
+            lock.lock();                                                                         \
+        }
 #else
-    #define SLOG_SINK_MUTEX_MEMBER(name) SLOG_MUTEX_MEMBER(name)
-    #define SLOG_SINK_LOCK(name) SLOG_LOCK(name)
+    #define SLOG_SINK_LOCK_IF(name, condition) SLOG_LOCK(name)
 #endif
 
 
@@ -80,7 +80,7 @@ public:
     {
         _record.format_str = fmt.get();
         _record.format_fn = &slog::fmt::format_deferred<std::decay_t<Args>...>;
-        _record.stored_args.emplace<std::tuple<std::decay_t<Args>...>>(std::forward<Args>(args)...);
+        slog::fmt::store_args<std::decay_t<Args>...>(_record.stored_args, std::forward<Args>(args)...);
         return *this;
     }
 
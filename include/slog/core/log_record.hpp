@@ -1,13 +1,14 @@
 #ifndef SLOG_CORE_LOG_RECORD_HPP
 #define SLOG_CORE_LOG_RECORD_HPP
 
-#include <any>
 #include <chrono>
 #include <iosfwd>
 #include <source_location>
 #include <string_view>
 
 #include <slog/core/log_level.hpp>
+#include <slog/details/thread_context.hpp>
+#include <slog/fmt/arg_buffer.hpp>
 
 namespace slog
 {
@@ -19,11 +20,13 @@ struct LogRecord
     std::string message; // pattern formatted message
     std::string string_buffer; // raw buffer
     std::source_location location;
-    std::chrono::system_clock::time_point timestamp;
+    std::chrono::system_clock::time_point timestamp; // raw ticks with SLOG_CLOCK_TSC until dispatched
     size_t thread_id;
-    std::any stored_args;
+    const slog::details::ThreadContext* thread{nullptr}; // logging thread, when known
+    slog::fmt::ArgBuffer stored_args; // encoded format arguments
+    const std::byte* encoded_args{nullptr}; // when set, arguments are decoded from here instead
     std::string_view format_str;
-    void (*format_fn)(std::string_view, std::any&, std::string&){nullptr};
+    slog::fmt::DeferredFormatFn format_fn{nullptr};
 
     LogRecord() : level(LogLevel::INFO) {}
     LogRecord(LogRecord&&) noexcept = default;
@@ -32,6 +35,11 @@ struct LogRecord
 
     LogRecord& operator=(LogRecord&&) noexcept = default;
     LogRecord& operator=(const LogRecord&) = default;
+
+    [[nodiscard]] const std::byte* args() const noexcept
+    {
+        return encoded_args ? encoded_args : stored_args.data();
+    }
 };
 
 } // namespace slog
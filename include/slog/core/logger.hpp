@@ -10,8 +10,9 @@
 #include <slog/core/log_level.hpp>
 #include <slog/core/log_proxy.hpp>
 #include <slog/core/log_record.hpp>
+#include <slog/details/clock.hpp>
 #include <slog/details/macros.hpp>
-#include <slog/details/thread_id.hpp>
+#include <slog/details/thread_context.hpp>
 #include <slog/fmt/deferred_format.hpp>
 #include <slog/fmt/format_with_location.hpp>
 #include <slog/sinks/isink.hpp>
@@ -36,7 +37,7 @@ namespace slog
 class SLOG_API Logger
 {
 public:
-    ~Logger() = default;
+    ~Logger();
 
 #ifdef SLOG_STREAM_ENABLED
     template<LogLevel level>
@@ -66,11 +67,14 @@ public:
         record.level = level;
         record.logger_name = _name;
         record.location = fmt.location;
-        record.timestamp = std::chrono::system_clock::now();
-        record.thread_id = slog::details::current_thread_id();
+        record.timestamp = slog::details::Clock::now();
+        const slog::details::ThreadContext& thread = slog::details::ThreadContext::current();
+
+        record.thread_id = thread.id();
+        record.thread = &thread;
         record.format_str = fmt.fmt.get();
         record.format_fn = &slog::fmt::format_deferred<std::decay_t<Args>...>;
-        record.stored_args.emplace<std::tuple<std::decay_t<Args>...>>(std::forward<Args>(args)...);
+        slog::fmt::store_args<std::decay_t<Args>...>(record.stored_args, std::forward<Args>(args)...);
         _submit(std::move(record));
     }
 
@@ -127,10 +131,9 @@ public:
 
     SLOG_ALWAYS_INLINE void set_log_level(const LogLevel level) noexcept { _log_level = level; }
 
-    SLOG_ALWAYS_INLINE void set_name(std::string_view name) noexcept { _name = name; }
-
     SLOG_ALWAYS_INLINE void set_pattern(std::string_view pattern);
 
+    // Fixed at construction: the registry index and the queued records refer to it
     [[nodiscard]] SLOG_ALWAYS_INLINE std::string_view get_name() const noexcept { return _name; }
 
 private:
@@ -155,6 +158,9 @@ private:
     LogLevel _log_level{LogLevel::TRACE};
     std::shared_ptr<slog::sinks::SinkManager> _sink_manager{nullptr};
     std::shared_ptr<slog::async::Worker> _worker;
+#ifdef SLOG_ASYNC_ENABLED
+    slog::async::ManagerHandle _manager_handle{0};
+#endif
 };
 
 } // namespace slog
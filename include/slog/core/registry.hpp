@@ -2,11 +2,19 @@
 #define SLOG_CORE_REGISTRY_HPP
 
 #include <slog/async/worker.hpp>
+#include <slog/async/worker_pool.hpp>
 #include <slog/config_macros.hpp>
 #include <slog/core/log_level.hpp>
 #include <slog/details/macros.hpp>
 
 #include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 // ------------------------
 // Forward declarations
@@ -23,29 +31,21 @@ namespace slog
 class SLOG_API Registry
 {
 public:
-    ~Registry()
-    {
-        if (_state.load(std::memory_order_relaxed) == RegistryState::ACTIVE) {
-            _state.store(RegistryState::INACTIVE);
-        }
-        _loggers.clear();
-    }
+    ~Registry();
 
     [[nodiscard]] std::shared_ptr<Logger> create_logger(std::string_view name);
 
+    // Async only: binds the new logger to the worker `worker_index` (modulo the worker count)
+    // instead of the sharding policy. An existing logger keeps its worker.
+    [[nodiscard]] std::shared_ptr<Logger> create_logger(std::string_view name, size_t worker_index);
+
     [[nodiscard]] static Registry& instance();
 
     void flush() const;
 
-    [[nodiscard]] SLOG_ALWAYS_INLINE Logger& get_default_logger() const noexcept
-    {
-        return this->_get_logger(_default_logger_name);
-    }
+    [[nodiscard]] Logger& get_default_logger() const noexcept;
 
-    [[nodiscard]] SLOG_ALWAYS_INLINE std::shared_ptr<Logger> get_default_logger_ptr() const noexcept
-    {
-        return this->_get_logger_ptr(_default_logger_name);
-    }
+    [[nodiscard]] std::shared_ptr<Logger> get_default_logger_ptr() const noexcept;
 
     // `get_logger` if the logger is not found it will return the default logger
     // this is done to guarantee no throws and no undefined behavior
@@ -64,19 +64,55 @@ public:
             return this->_get_logger_ptr(name);
         }
         if (_local_state == RegistryState::INACTIVE) [[unlikely]] {
-            return this->_get_logger_ptr(_default_logger_name);
+            return this->get_default_logger_ptr();
         }
         return nullptr;
     }
 
-    [[nodiscard]] SLOG_ALWAYS_INLINE LogLevel get_log_level() const noexcept { return _log_level; }
+    // `find_logger` returns nullptr if the logger doesn't exist, a found logger stays valid for
+    // the registry lifetime (see SLOG_GET_LOGGER per call site cache)
+    [[nodiscard]] Logger* find_logger(std::string_view name) const noexcept;
+
+    // Static so that SLOG_IS_OFF doesn't go through `instance()`
+    [[nodiscard]] SLOG_ALWAYS_INLINE static LogLevel get_log_level() noexcept { return _log_level; }
 
-    SLOG_ALWAYS_INLINE void set_log_level(const LogLevel level) noexcept { _log_level = level; }
+    SLOG_ALWAYS_INLINE static void set_log_level(const LogLevel level) noexcept { _log_level = level; }
 
     SLOG_ALWAYS_INLINE void set_pattern(std::string_view pattern) noexcept { _format_pattern = pattern; }
 
     bool set_default_logger_name(std::string_view name);
 
+    // Applies to the loggers created afterwards
+    void set_sharding(slog::async::Sharding sharding) noexcept;
+
+    // Applies to every worker, no effect in sync mode
+    void set_idle_strategy(slog::async::IdleStrategy idle) noexcept;
+
+    // Capacity and memory of the worker queues. They are built with the registry: the options
+    // must be set before the first `instance()`, afterwards they are ignored and false is
+    // returned. No effect in sync mode.
+    static bool set_queue_options(slog::async::QueueOptions options) noexcept;
+
+    // Number of async workers, SLOG_ASYNC_WORKERS by default (0 counts as 1). Like the queue
+    // options it must be set before the first `instance()`, afterwards it is ignored and false
+    // is returned. Sinks are locked only with more than one worker. No effect in sync mode.
+    static bool set_worker_count(size_t count) noexcept;
+
+    // What producers do when the queue of their worker is full, applies to every worker.
+    // No effect in sync mode.
+    void set_queue_full_policy(slog::async::QueueFullPolicy policy) noexcept;
+
+    // Every `interval` each worker logs its stats (slog::async::WorkerStats) as an INFO record
+    // through the logger `logger_name`, the default logger if empty. A zero interval stops it,
+    // so does an unknown logger. No effect in sync mode.
+    void set_stats_interval(std::chrono::milliseconds interval, std::string_view logger_name = {});
+
+    // All are empty in sync mode. The stats also report the memory held by every queue.
+    [[nodiscard]] size_t get_worker_count() const noexcept;
+    [[nodiscard]] std::vector<slog::async::WorkerCounters> get_worker_counters() const;
+    // Lock free snapshot of every worker, in worker index order
+    [[nodiscard]] std::vector<slog::async::WorkerStats> get_worker_stats() const;
+
 private:
     enum class RegistryState
     {
@@ -93,6 +129,27 @@ private:
         }
     }
 
+    // Immutable open addressing index of the loggers, readers consult it without locks.
+    // Every change publishes a new one, the old one is freed once no reader can still hold it.
+    struct LoggerIndex
+    {
+        struct Slot
+        {
+            size_t hash;
+            std::string name;
+            std::shared_ptr<Logger> logger;
+        };
+
+        LoggerIndex(const std::vector<std::shared_ptr<Logger>>& loggers,
+                    std::shared_ptr<Logger> default_logger);
+
+        [[nodiscard]] const std::shared_ptr<Logger>* find(std::string_view name) const noexcept;
+
+        std::vector<Slot> slots;
+        size_t mask;
+        std::shared_ptr<Logger> default_logger;
+    };
+
     Registry();
     Registry(const Registry&) = delete;
     Registry(Registry&&) = delete;
@@ -101,17 +158,30 @@ private:
     Registry& operator=(Registry&&) = delete;
 
     [[nodiscard]] Logger& _get_logger(std::string_view name) const noexcept;
+    void _publish_index();
     [[nodiscard]] std::shared_ptr<Logger> _get_logger_ptr(std::string_view name) const noexcept;
+    std::shared_ptr<Logger> _create_logger(std::string_view name,
+                                           std::optional<size_t> worker_index);
     std::shared_ptr<Logger> _make_logger(std::string_view name,
                                          std::shared_ptr<slog::async::Worker> worker);
+    std::shared_ptr<slog::async::Worker> _assign_worker(std::string_view name,
+                                                        std::optional<size_t> worker_index);
+    [[nodiscard]] static slog::async::QueueOptions _freeze_queue_options() noexcept;
+    [[nodiscard]] static size_t _freeze_worker_count() noexcept;
 
     std::string _default_logger_name;
     std::string_view _format_pattern;
     RegistryState _local_state;
-    std::vector<std::shared_ptr<Logger>> _loggers;
-    std::shared_ptr<slog::async::Worker> _worker{nullptr};
+    std::vector<std::shared_ptr<Logger>> _loggers; // written under _mutex
+    std::atomic<const LoggerIndex*> _index{nullptr};
+    std::vector<std::pair<const LoggerIndex*, uint64_t>> _retired_indexes; // with their epoch
+    slog::async::WorkerPool _workers{_freeze_worker_count(), _freeze_queue_options()};
+    slog::async::Sharding _sharding{slog::async::Sharding::LEAST_LOADED};
     static inline std::atomic<RegistryState> _state{RegistryState::ACTIVE};
     static inline LogLevel _log_level{LogLevel::TRACE};
+    static inline slog::async::QueueOptions _queue_options{};
+    static inline size_t _worker_count{SLOG_ASYNC_WORKERS};
+    static inline std::atomic<bool> _options_frozen{false}; // queue options and worker count
     SLOG_MUTEX_MEMBER(_mutex);
 };
 
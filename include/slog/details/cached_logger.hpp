@@ -0,0 +1,88 @@
+#ifndef SLOG_DETAILS_CACHED_LOGGER_HPP
+#define SLOG_DETAILS_CACHED_LOGGER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <string_view>
+
+#include <slog/core/registry.hpp>
+#include <slog/details/macros.hpp>
+
+namespace slog
+{
+class Logger;
+}
+
+namespace slog::details
+{
+
+// Per call site cache of a logger lookup by name, used by SLOG_GET_LOGGER.
+//
+// Only names given as const character arrays (string literals) are cached, keyed by their
+// address: a mutable buffer can hold another name at the next call.
+// The name and the logger are published together, as one immutable entry: once the logger
+// exists it is never removed, so a hit is a load of the entry. Until the logger is created
+// lookups fall back to the default logger and are not cached. The first name cached stays, a
+// call site passing other arrays looks them up at every call.
+class CachedLogger
+{
+public:
+    constexpr CachedLogger() noexcept = default;
+
+    template<size_t N>
+    [[nodiscard]] SLOG_ALWAYS_INLINE Logger& get(const char (&name)[N]) noexcept
+    {
+        const Entry* entry = _entry.load(std::memory_order_acquire);
+
+        if (entry && entry->name == name) [[likely]] {
+            return *entry->logger;
+        }
+        return _resolve(name, entry);
+    }
+
+    template<size_t N>
+    [[nodiscard]] SLOG_ALWAYS_INLINE Logger& get(char (&name)[N]) noexcept
+    {
+        return slog::Registry::instance().get_logger(name);
+    }
+
+    template<typename Name>
+    [[nodiscard]] SLOG_ALWAYS_INLINE Logger& get(const Name& name) noexcept
+    {
+        return slog::Registry::instance().get_logger(name);
+    }
+
+private:
+    struct Entry
+    {
+        const char* name;
+        Logger* logger;
+    };
+
+    Logger& _resolve(const char* name, const Entry* entry) noexcept
+    {
+        slog::Registry& registry = slog::Registry::instance();
+        Logger* logger = registry.find_logger(name);
+
+        if (!logger) {
+            return registry.get_default_logger();
+        }
+        if (!entry) {
+            // Lives as long as the logger, i.e. for good
+            auto* cached = new (std::nothrow) Entry{name, logger};
+
+            if (cached && !_entry.compare_exchange_strong(entry, cached, std::memory_order_release,
+                                                          std::memory_order_relaxed)) {
+                delete cached;
+            }
+        }
+        return *logger;
+    }
+
+    std::atomic<const Entry*> _entry{nullptr};
+};
+
+} // namespace slog::details
+
+#endif // SLOG_DETAILS_CACHED_LOGGER_HPP
@@ -0,0 +1,217 @@
+#ifndef SLOG_DETAILS_CLOCK_HPP
+#define SLOG_DETAILS_CLOCK_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+#endif
+
+#ifdef __linux__
+    #include <time.h>
+#endif
+
+#include <slog/config_macros.hpp>
+#include <slog/details/macros.hpp>
+
+#if defined(SLOG_CLOCK_COARSE) && defined(SLOG_CLOCK_TSC)
+    #error "SLOG_CLOCK_COARSE and SLOG_CLOCK_TSC are mutually exclusive"
+#endif
+
+namespace slog::details
+{
+
+using TimePoint = std::chrono::system_clock::time_point;
+
+// Clocks capture a timestamp on the producer with now(), resolve() turns it into wall time
+// right before formatting. Only the TSC clock stores something else than wall time.
+
+struct SystemClock
+{
+    [[nodiscard]] SLOG_ALWAYS_INLINE static TimePoint now() noexcept
+    {
+        return std::chrono::system_clock::now();
+    }
+
+    [[nodiscard]] SLOG_ALWAYS_INLINE static TimePoint resolve(TimePoint tp) noexcept { return tp; }
+};
+
+// CLOCK_REALTIME_COARSE: last tick of the kernel timer (1-4ms resolution), no hardware read
+struct CoarseClock
+{
+    [[nodiscard]] SLOG_ALWAYS_INLINE static TimePoint now() noexcept
+    {
+#ifdef CLOCK_REALTIME_COARSE
+        timespec ts;
+
+        ::clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+        return TimePoint(std::chrono::duration_cast<TimePoint::duration>(
+            std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec)));
+#else
+        return std::chrono::system_clock::now();
+#endif
+    }
+
+    [[nodiscard]] SLOG_ALWAYS_INLINE static TimePoint resolve(TimePoint tp) noexcept { return tp; }
+};
+
+// Raw cycle counter stored in the time point as ticks, converted to wall time by resolve()
+// with a ticks to ns mapping anchored on system_clock. The mapping is calibrated on first use
+// (spinning ~1ms) and re-anchored every SLOG_TSC_CALIBRATION_MS, which also follows wall clock
+// steps. Assumes an invariant TSC, synchronized across cores.
+class TscClock
+{
+public:
+    [[nodiscard]] SLOG_ALWAYS_INLINE static uint64_t ticks() noexcept
+    {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        uint64_t value;
+
+        asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+        return value;
+#else
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    [[nodiscard]] SLOG_ALWAYS_INLINE static TimePoint now() noexcept
+    {
+        return TimePoint(TimePoint::duration(static_cast<TimePoint::rep>(ticks())));
+    }
+
+    [[nodiscard]] static TimePoint resolve(TimePoint tp) noexcept
+    {
+        return instance().to_time_point(static_cast<uint64_t>(tp.time_since_epoch().count()));
+    }
+
+    [[nodiscard]] static TscClock& instance() noexcept
+    {
+        static TscClock clock;
+
+        return clock;
+    }
+
+    // Any thread, calibrations are published through a seqlock
+    [[nodiscard]] TimePoint to_time_point(uint64_t tsc) noexcept
+    {
+        uint32_t seq;
+        uint64_t base_tsc;
+        int64_t base_ns;
+        double ns_per_tick;
+
+        do {
+            seq = _seq.load(std::memory_order_acquire);
+            base_tsc = _base_tsc.load(std::memory_order_relaxed);
+            base_ns = _base_ns.load(std::memory_order_relaxed);
+            ns_per_tick = _ns_per_tick.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+        } while ((seq & 1) || seq != _seq.load(std::memory_order_relaxed));
+
+        if (tsc - base_tsc > _interval_ticks.load(std::memory_order_relaxed) &&
+            static_cast<int64_t>(tsc - base_tsc) > 0) [[unlikely]] {
+            _recalibrate();
+        }
+
+        // Signed: records captured before the latest calibration are behind the base
+        double delta = static_cast<double>(static_cast<int64_t>(tsc - base_tsc)) * ns_per_tick;
+
+        return TimePoint(std::chrono::duration_cast<TimePoint::duration>(
+            std::chrono::nanoseconds(base_ns + static_cast<int64_t>(delta))));
+    }
+
+    [[nodiscard]] double ns_per_tick() const noexcept
+    {
+        return _ns_per_tick.load(std::memory_order_relaxed);
+    }
+
+private:
+    TscClock()
+    {
+        auto [tsc_start, ns_start] = _sample();
+        auto [tsc_end, ns_end] = _sample();
+
+        while (ns_end - ns_start < 1'000'000 || tsc_end == tsc_start) {
+            std::tie(tsc_end, ns_end) = _sample();
+        }
+        _publish(tsc_end, ns_end, static_cast<double>(ns_end - ns_start) /
+                                      static_cast<double>(tsc_end - tsc_start));
+    }
+
+    // Reads both clocks as close to each other as possible
+    static std::pair<uint64_t, int64_t> _sample() noexcept
+    {
+        uint64_t tsc = ticks();
+        int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::system_clock::now().time_since_epoch())
+                         .count();
+
+        return {tsc, ns};
+    }
+
+    void _recalibrate() noexcept
+    {
+        if (_calibrating.test_and_set(std::memory_order_acquire)) {
+            return;
+        }
+
+        auto [tsc, ns] = _sample();
+        uint64_t base_tsc = _base_tsc.load(std::memory_order_relaxed);
+        int64_t base_ns = _base_ns.load(std::memory_order_relaxed);
+        double ns_per_tick = _ns_per_tick.load(std::memory_order_relaxed);
+
+        // A wall clock step would skew the rate, keep the previous one and only re-anchor
+        if (tsc > base_tsc && ns > base_ns) {
+            double rate = static_cast<double>(ns - base_ns) / static_cast<double>(tsc - base_tsc);
+
+            if (rate > ns_per_tick * 0.99 && rate < ns_per_tick * 1.01) {
+                ns_per_tick = rate;
+            }
+        }
+        _publish(tsc, ns, ns_per_tick);
+        _calibrating.clear(std::memory_order_release);
+    }
+
+    void _publish(uint64_t tsc, int64_t ns, double ns_per_tick) noexcept
+    {
+        uint32_t seq = _seq.load(std::memory_order_relaxed);
+
+        _seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        _base_tsc.store(tsc, std::memory_order_relaxed);
+        _base_ns.store(ns, std::memory_order_relaxed);
+        _ns_per_tick.store(ns_per_tick, std::memory_order_relaxed);
+        _interval_ticks.store(
+            static_cast<uint64_t>(SLOG_TSC_CALIBRATION_MS * 1'000'000.0 / ns_per_tick),
+            std::memory_order_relaxed);
+        _seq.store(seq + 2, std::memory_order_release);
+    }
+
+    std::atomic<uint32_t> _seq{0};
+    std::atomic<uint64_t> _base_tsc{0};
+    std::atomic<int64_t> _base_ns{0};
+    std::atomic<double> _ns_per_tick{1.0};
+    std::atomic<uint64_t> _interval_ticks{0};
+    std::atomic_flag _calibrating = ATOMIC_FLAG_INIT;
+};
+
+#if defined(SLOG_CLOCK_TSC)
+using Clock = TscClock;
+#elif defined(SLOG_CLOCK_COARSE)
+using Clock = CoarseClock;
+#else
+using Clock = SystemClock;
+#endif
+
+} // namespace slog::details
+
+#endif // SLOG_DETAILS_CLOCK_HPP
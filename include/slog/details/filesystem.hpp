@@ -5,6 +5,8 @@
 
 #include <string_view>
 
+#include <slog/details/macros.hpp>
+
 namespace slog::details
 {
 
@@ -0,0 +1,143 @@
+#ifndef SLOG_DETAILS_HELPER_THREAD_HPP
+#define SLOG_DETAILS_HELPER_THREAD_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace slog::details
+{
+
+// Thread taking the slow work of a sink off its writer: it runs the tasks the sink queues, in
+// order, and prepares the resource the writer moves to next (a mapped segment, an opened file)
+// ahead of it, so that the writer only waits for it when the helper fell behind.
+//
+// The tasks queued before stop() run, those queued before the helper starts included.
+template<typename Task, typename Next>
+class HelperThread
+{
+public:
+    // Runs `task` without the lock held, returns true when it prepared `next`
+    using RunFn = std::function<bool(Task& task, Next& next)>;
+
+    HelperThread() = default;
+    HelperThread(const HelperThread&) = delete;
+    HelperThread& operator=(const HelperThread&) = delete;
+
+    ~HelperThread() { stop(); }
+
+    void start(RunFn run) { _thread = std::thread(&HelperThread::_run, this, std::move(run)); }
+
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            _stop = true;
+        }
+        _helper_cv.notify_one();
+        if (_thread.joinable()) {
+            _thread.join();
+        }
+    }
+
+    void post(Task task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            _tasks.push_back(std::move(task));
+        }
+        _helper_cv.notify_one();
+    }
+
+    // Waits for the resource prepared ahead and calls `swap(next, tasks)` under the lock: it
+    // takes `next` over and queues the tasks of the swap
+    template<typename Swap>
+    void take(Swap&& swap)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+
+            if (!_ready) [[unlikely]] {
+                _waits++;
+                while (!_ready) {
+                    _writer_cv.wait_for(lock, std::chrono::milliseconds(10));
+                }
+            }
+            _ready = false;
+            swap(_next, _tasks);
+        }
+        _helper_cv.notify_one();
+    }
+
+    // Runs `func` under the lock, e.g. to read state only written by a swap
+    template<typename Func>
+    decltype(auto) locked(Func&& func)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        return func();
+    }
+
+    // The resource prepared ahead and not taken, once stopped
+    [[nodiscard]] Next& prepared() noexcept { return _next; }
+
+    // Times take() had to wait for the helper
+    [[nodiscard]] uint64_t waits()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        return _waits;
+    }
+
+private:
+    void _run(RunFn run)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        while (true) {
+            if (_tasks.empty()) {
+                if (_stop) {
+                    return;
+                }
+                _helper_cv.wait_for(lock, std::chrono::milliseconds(100));
+                continue;
+            }
+
+            Task task = std::move(_tasks.front());
+            Next next{};
+
+            _tasks.pop_front();
+            lock.unlock();
+
+            bool prepared = run(task, next);
+
+            lock.lock();
+            if (prepared) {
+                _next = std::move(next);
+                _ready = true;
+                _writer_cv.notify_one();
+            }
+        }
+    }
+
+    std::thread _thread;
+    std::mutex _mutex;
+    std::condition_variable _helper_cv;
+    std::condition_variable _writer_cv;
+    std::deque<Task> _tasks;
+    Next _next{};
+    bool _ready{false};
+    bool _stop{false};
+    uint64_t _waits{0};
+};
+
+} // namespace slog::details
+
+#endif // SLOG_DETAILS_HELPER_THREAD_HPP
@@ -39,6 +39,33 @@
     #define SLOG_INLINE inline
 #endif
 
+// ----------------------------------------
+// CPU hint for spin-wait loops
+// ----------------------------------------
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #define SLOG_CPU_PAUSE() _mm_pause()
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #define SLOG_CPU_PAUSE() __builtin_ia32_pause()
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__aarch64__) || defined(__arm__))
+    #define SLOG_CPU_PAUSE() __asm__ __volatile__("yield" ::: "memory")
+#else
+    #define SLOG_CPU_PAUSE() ((void)0)
+#endif
+
+// ----------------------------------------
+// Prefetch hint for a cacheline about to be written
+// ----------------------------------------
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #define SLOG_PREFETCH(address) _mm_prefetch(reinterpret_cast<const char*>(address), _MM_HINT_T0)
+#elif defined(__GNUC__) || defined(__clang__)
+    #define SLOG_PREFETCH(address) __builtin_prefetch((address), 1, 3)
+#else
+    #define SLOG_PREFETCH(address) ((void)(address))
+#endif
+
 // ----------------------------------------
 // Temporary disable padding warning for MSVC
 // ----------------------------------------
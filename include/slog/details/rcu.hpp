@@ -0,0 +1,124 @@
+#ifndef SLOG_DETAILS_RCU_HPP
+#define SLOG_DETAILS_RCU_HPP
+
+#include <atomic>
+#include <cstdint>
+
+#include <slog/config_macros.hpp>
+#include <slog/details/macros.hpp>
+
+namespace slog::details
+{
+
+// Epoch based reclamation for read-mostly data published through an atomic pointer.
+//
+// A reader pins the current epoch in its own slot for the lifetime of a ReadGuard: a store to
+// a cache line owned by the thread, no shared read-modify-write. A writer that swapped a
+// pointer calls advance() and retires the old object with the returned epoch, the object can be
+// freed once quiescent(epoch) holds, i.e. no reader pinned before the swap is still inside.
+//
+// Slots are never freed, a slot released by an exiting thread is reused by the next one.
+class Rcu
+{
+    struct alignas(SLOG_CACHELINE_SIZE) Slot
+    {
+        std::atomic<uint64_t> epoch{0}; // 0 when the owner is not reading
+        std::atomic<bool> owned{true};
+        uint32_t depth{0};              // nested guards, owner only
+        Slot* next{nullptr};
+    };
+
+public:
+    class ReadGuard
+    {
+    public:
+        ReadGuard() noexcept : _slot(_local())
+        {
+            if (_slot.depth++ == 0) {
+                // Ordered before the loads of the protected pointers
+                _slot.epoch.store(_epoch.load(std::memory_order_relaxed), std::memory_order_seq_cst);
+            }
+        }
+
+        ~ReadGuard()
+        {
+            if (--_slot.depth == 0) {
+                _slot.epoch.store(0, std::memory_order_release);
+            }
+        }
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+    private:
+        Slot& _slot;
+    };
+
+    // Writer side, after swapping the pointer: the epoch to retire the old object with
+    static uint64_t advance() noexcept { return _epoch.fetch_add(1, std::memory_order_seq_cst) + 1; }
+
+    // True once every reader that may still see an object retired at `epoch` has left
+    [[nodiscard]] static bool quiescent(uint64_t epoch) noexcept
+    {
+        for (Slot* slot = _slots.load(std::memory_order_acquire); slot; slot = slot->next) {
+            uint64_t pinned = slot->epoch.load(std::memory_order_seq_cst);
+
+            if (pinned != 0 && pinned < epoch) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    struct LocalSlot
+    {
+        Slot* slot{nullptr};
+
+        ~LocalSlot()
+        {
+            if (slot) {
+                slot->owned.store(false, std::memory_order_release);
+                slot = nullptr;
+            }
+        }
+    };
+
+    SLOG_ALWAYS_INLINE static Slot& _local() noexcept
+    {
+        static thread_local LocalSlot local;
+
+        if (!local.slot) [[unlikely]] {
+            local.slot = _acquire();
+        }
+        return *local.slot;
+    }
+
+    static Slot* _acquire() noexcept
+    {
+        for (Slot* slot = _slots.load(std::memory_order_acquire); slot; slot = slot->next) {
+            bool owned = false;
+
+            if (!slot->owned.load(std::memory_order_relaxed) &&
+                slot->owned.compare_exchange_strong(owned, true, std::memory_order_acquire)) {
+                return slot;
+            }
+        }
+
+        auto* slot = new Slot();
+
+        slot->next = _slots.load(std::memory_order_relaxed);
+        while (!_slots.compare_exchange_weak(slot->next, slot, std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+        }
+        return slot;
+    }
+
+    // Starts at 1, a pinned epoch is never 0
+    static inline std::atomic<uint64_t> _epoch{1};
+    static inline std::atomic<Slot*> _slots{nullptr};
+};
+
+} // namespace slog::details
+
+#endif // SLOG_DETAILS_RCU_HPP
@@ -0,0 +1,203 @@
+#ifndef SLOG_DETAILS_THREAD_CONTEXT_HPP
+#define SLOG_DETAILS_THREAD_CONTEXT_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+#if defined(__linux__) || defined(__APPLE__)
+    #include <pthread.h>
+#endif
+#ifdef __linux__
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#include <slog/details/macros.hpp>
+#include <slog/details/thread_id.hpp>
+
+namespace slog::details
+{
+
+// Identity of a thread computed once: OS id, its decimal rendering and the thread name.
+//
+// Records reference the context of the thread that logged them and may be formatted after the
+// thread exits: a record queued to a worker holds a reference (retain() before pushing, release()
+// once consumed). The thread holds one too, dropped when it exits or renames itself, the last
+// reference frees the context.
+class ThreadContext
+{
+public:
+    static constexpr size_t MAX_NAME = 16; // pthread limit, including the terminator
+
+    ThreadContext(size_t id, std::string_view name) noexcept : _id(id)
+    {
+        std::to_chars_result result = std::to_chars(_id_text, _id_text + sizeof(_id_text), id);
+
+        _id_size = static_cast<uint8_t>(result.ptr - _id_text);
+        _name_size = static_cast<uint8_t>(std::min(name.size(), MAX_NAME - 1));
+        std::copy_n(name.data(), _name_size, _name);
+    }
+
+    ThreadContext(const ThreadContext&) = delete;
+    ThreadContext& operator=(const ThreadContext&) = delete;
+
+    [[nodiscard]] SLOG_ALWAYS_INLINE size_t id() const noexcept { return _id; }
+
+    [[nodiscard]] SLOG_ALWAYS_INLINE std::string_view id_text() const noexcept
+    {
+        return {_id_text, _id_size};
+    }
+
+    // Falls back to the id when the thread has no name
+    [[nodiscard]] SLOG_ALWAYS_INLINE std::string_view name() const noexcept
+    {
+        return _name_size ? std::string_view(_name, _name_size) : id_text();
+    }
+
+    // Context of the calling thread, created on first use
+    [[nodiscard]] SLOG_ALWAYS_INLINE static const ThreadContext& current() noexcept
+    {
+        const ThreadContext* context = _local().context;
+
+        if (!context) [[unlikely]] {
+            context = _create(_os_name());
+        }
+        return *context;
+    }
+
+    // Keeps the context alive for a record that outlives the logging call
+    SLOG_ALWAYS_INLINE void retain() const noexcept { _refs.fetch_add(1, std::memory_order_relaxed); }
+
+    // Drops `count` references taken by retain(), the context must not be used afterwards
+    SLOG_ALWAYS_INLINE void release(size_t count = 1) const noexcept
+    {
+        if (_refs.fetch_sub(count, std::memory_order_acq_rel) == count) {
+            delete this;
+        }
+    }
+
+    // Renames the calling thread (OS name too, truncated to 15 chars). Records already logged
+    // keep the previous name.
+    static void rename(std::string_view name) noexcept
+    {
+#if defined(__linux__) || defined(__APPLE__)
+        char buf[MAX_NAME]{};
+
+        std::copy_n(name.data(), std::min(name.size(), MAX_NAME - 1), buf);
+    #ifdef __APPLE__
+        ::pthread_setname_np(buf);
+    #else
+        ::pthread_setname_np(::pthread_self(), buf);
+    #endif
+#endif
+        _create(name);
+    }
+
+private:
+    // Reference of the thread to its current context
+    struct LocalContext
+    {
+        const ThreadContext* context{nullptr};
+
+        ~LocalContext()
+        {
+            if (context) {
+                context->release();
+                context = nullptr;
+            }
+        }
+    };
+
+    SLOG_ALWAYS_INLINE static LocalContext& _local() noexcept
+    {
+        static thread_local LocalContext local;
+
+        return local;
+    }
+
+    static const ThreadContext* _create(std::string_view name) noexcept
+    {
+        LocalContext& local = _local();
+        const ThreadContext* previous = local.context;
+
+        local.context = new ThreadContext(current_thread_id(), name);
+        if (previous) {
+            previous->release();
+        }
+        return local.context;
+    }
+
+    static std::string_view _os_name() noexcept
+    {
+#if defined(__linux__) || defined(__APPLE__)
+        static thread_local char buf[MAX_NAME];
+
+        if (::pthread_getname_np(::pthread_self(), buf, sizeof(buf)) == 0) {
+    #ifdef __linux__
+            // Linux threads inherit the name of their creator, usually the process name: it
+            // doesn't tell threads apart, they count as unnamed
+            if (std::string_view(buf) == _process_name()) {
+                return {};
+            }
+    #endif
+            return buf;
+        }
+#endif
+        return {};
+    }
+
+#ifdef __linux__
+    // Read once, the main thread name as it was on first use
+    static std::string_view _process_name() noexcept
+    {
+        static const std::string_view name = []() noexcept {
+            static char comm[MAX_NAME + 1]{};
+            int fd = ::open("/proc/self/comm", O_RDONLY | O_CLOEXEC);
+
+            if (fd < 0) {
+                return std::string_view();
+            }
+
+            ssize_t size = ::read(fd, comm, MAX_NAME);
+
+            ::close(fd);
+            if (size <= 0) {
+                return std::string_view();
+            }
+
+            std::string_view text(comm, static_cast<size_t>(size));
+
+            return text.substr(0, text.find('\n'));
+        }();
+
+        return name;
+    }
+#endif
+
+    size_t _id;
+    mutable std::atomic<size_t> _refs{1};
+    uint8_t _id_size;
+    uint8_t _name_size;
+    char _id_text[std::numeric_limits<size_t>::digits10 + 1];
+    char _name[MAX_NAME];
+};
+
+} // namespace slog::details
+
+namespace slog
+{
+
+// Names the calling thread for the %N flag (and the OS, truncated to 15 characters)
+inline void set_thread_name(std::string_view name) noexcept
+{
+    slog::details::ThreadContext::rename(name);
+}
+
+} // namespace slog
+
+#endif // SLOG_DETAILS_THREAD_CONTEXT_HPP
@@ -0,0 +1,392 @@
+#ifndef SLOG_FMT_ARG_BUFFER_HPP
+#define SLOG_FMT_ARG_BUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <slog/config_macros.hpp>
+#include <slog/details/macros.hpp>
+
+namespace slog::fmt
+{
+
+// Byte storage for the arguments captured by a log call.
+// Payloads up to SLOG_ARG_BUFFER_SIZE bytes live inline in the record, bigger ones spill
+// to the heap. The layout is only known to the per-signature encode/decode functions
+// (see deferred_format.hpp), the buffer itself just owns the bytes.
+class ArgBuffer
+{
+public:
+    enum class ManagerOp : uint8_t
+    {
+        COPY,
+        MOVE,
+        DESTROY
+    };
+
+    // Set only when the encoded signature holds non trivially copyable arguments.
+    // COPY/MOVE construct the objects of `src` into `dst` (MOVE also destroys `src`),
+    // DESTROY destroys the objects in `dst`.
+    using ManagerFn = void (*)(ManagerOp op, std::byte* dst, std::byte* src);
+
+    static constexpr size_t INLINE_SIZE = SLOG_ARG_BUFFER_SIZE;
+
+    ArgBuffer() noexcept = default;
+
+    ArgBuffer(const ArgBuffer& other) { _copy_from(other); }
+
+    ArgBuffer(ArgBuffer&& other) noexcept { _move_from(other); }
+
+    ~ArgBuffer() { reset(); }
+
+    ArgBuffer& operator=(const ArgBuffer& other)
+    {
+        if (this != &other) {
+            reset();
+            _copy_from(other);
+        }
+        return *this;
+    }
+
+    ArgBuffer& operator=(ArgBuffer&& other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            _move_from(other);
+        }
+        return *this;
+    }
+
+    // Drops the current payload and returns `size` writable bytes aligned to max_align_t
+    [[nodiscard]] std::byte* allocate(size_t size)
+    {
+        reset();
+        if (size > INLINE_SIZE) [[unlikely]] {
+            _heap = new std::byte[size];
+        }
+        _size = size;
+        return data();
+    }
+
+    // Must be set only once all the objects of the payload have been constructed
+    SLOG_ALWAYS_INLINE void set_manager(ManagerFn manager) noexcept { _manager = manager; }
+
+    void reset() noexcept
+    {
+        if (_manager) {
+            _manager(ManagerOp::DESTROY, data(), nullptr);
+            _manager = nullptr;
+        }
+        delete[] _heap;
+        _heap = nullptr;
+        _size = 0;
+    }
+
+    // Moves an inline payload into `dst` (at least size() bytes aligned to max_align_t) and
+    // leaves the buffer empty. The returned manager, if any, must be used to destroy `dst`.
+    [[nodiscard]] ManagerFn relocate_to(std::byte* dst) noexcept
+    {
+        ManagerFn manager = _manager;
+
+        std::memcpy(dst, data(), _size);
+        if (manager) {
+            manager(ManagerOp::MOVE, dst, data());
+            _manager = nullptr;
+        }
+        reset();
+        return manager;
+    }
+
+    [[nodiscard]] SLOG_ALWAYS_INLINE std::byte* data() noexcept { return _heap ? _heap : _inline; }
+
+    [[nodiscard]] SLOG_ALWAYS_INLINE const std::byte* data() const noexcept
+    {
+        return _heap ? _heap : _inline;
+    }
+
+    [[nodiscard]] SLOG_ALWAYS_INLINE size_t size() const noexcept { return _size; }
+
+    [[nodiscard]] SLOG_ALWAYS_INLINE bool is_inline() const noexcept { return _heap == nullptr; }
+
+private:
+    void _copy_from(const ArgBuffer& other)
+    {
+        std::byte* dst = allocate(other._size);
+
+        if (other._size == 0) {
+            return;
+        }
+        std::memcpy(dst, other.data(), other._size);
+        if (other._manager) {
+            other._manager(ManagerOp::COPY, dst, const_cast<std::byte*>(other.data()));
+            _manager = other._manager;
+        }
+    }
+
+    void _move_from(ArgBuffer& other) noexcept
+    {
+        _size = other._size;
+        _manager = other._manager;
+        if (other._heap) {
+            // Heap payloads are stolen, objects never move
+            _heap = other._heap;
+            other._heap = nullptr;
+        }
+        else if (_size != 0) {
+            std::memcpy(_inline, other._inline, _size);
+            if (_manager) {
+                _manager(ManagerOp::MOVE, _inline, other._inline);
+            }
+        }
+        other._size = 0;
+        other._manager = nullptr;
+    }
+
+    alignas(std::max_align_t) std::byte _inline[INLINE_SIZE];
+    std::byte* _heap{nullptr};
+    size_t _size{0};
+    ManagerFn _manager{nullptr};
+};
+
+// What the format function of a record writes to `out`: the message, or the portable encoding
+// of the arguments (portable_args.hpp) for sinks storing them, e.g. BinaryFileSink
+enum class FormatMode : uint8_t
+{
+    MESSAGE,
+    PORTABLE_ARGS
+};
+
+// `format_deferred<Args...>` of the signature encoded in the record
+using DeferredFormatFn = void (*)(std::string_view format, const std::byte* args, std::string& out,
+                                  FormatMode mode);
+
+namespace detail
+{
+
+SLOG_ALWAYS_INLINE constexpr size_t align_up(size_t offset, size_t alignment) noexcept
+{
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+template<typename T>
+concept StringLike = std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> ||
+                     std::is_same_v<T, const char*> || std::is_same_v<T, char*>;
+
+// How a decayed argument type is laid out in the buffer:
+//  - STRING:  size_t length followed by the characters, decoded as std::string_view
+//  - TRIVIAL: memcpy of the object, decoded as const T&
+//  - BOXED:   copy constructed object, decoded as const T&, handled by the manager
+enum class ArgKind : uint8_t
+{
+    STRING,
+    TRIVIAL,
+    BOXED
+};
+
+template<typename T>
+inline constexpr ArgKind arg_kind_v = StringLike<T>                       ? ArgKind::STRING
+                                      : std::is_trivially_copyable_v<T> ? ArgKind::TRIVIAL
+                                                                        : ArgKind::BOXED;
+
+template<typename T>
+struct ArgCodec
+{
+    static constexpr ArgKind kind = arg_kind_v<T>;
+
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+                  "slog: over-aligned log arguments are not supported");
+
+    SLOG_ALWAYS_INLINE static std::string_view as_view(const T& value) noexcept
+        requires(kind == ArgKind::STRING)
+    {
+        if constexpr (std::is_pointer_v<T>) {
+            return value ? std::string_view(value) : std::string_view{};
+        }
+        else {
+            return std::string_view(value);
+        }
+    }
+
+    SLOG_ALWAYS_INLINE static size_t size(size_t offset, const T& value) noexcept
+    {
+        if constexpr (kind == ArgKind::STRING) {
+            return align_up(offset, alignof(size_t)) + sizeof(size_t) + as_view(value).size();
+        }
+        else {
+            return align_up(offset, alignof(T)) + sizeof(T);
+        }
+    }
+
+    template<typename U>
+    SLOG_ALWAYS_INLINE static size_t encode(std::byte* base, size_t offset, U&& value)
+    {
+        if constexpr (kind == ArgKind::STRING) {
+            std::string_view sv = as_view(value);
+            size_t len = sv.size();
+
+            offset = align_up(offset, alignof(size_t));
+            std::memcpy(base + offset, &len, sizeof(size_t));
+            offset += sizeof(size_t);
+            std::memcpy(base + offset, sv.data(), len);
+            return offset + len;
+        }
+        else if constexpr (kind == ArgKind::TRIVIAL) {
+            const T& decayed = value;
+
+            offset = align_up(offset, alignof(T));
+            std::memcpy(base + offset, &decayed, sizeof(T));
+            return offset + sizeof(T);
+        }
+        else {
+            offset = align_up(offset, alignof(T));
+            ::new (static_cast<void*>(base + offset)) T(std::forward<U>(value));
+            return offset + sizeof(T);
+        }
+    }
+
+    // Returns the offset following the argument, `out` receives the decoded view
+    template<typename V>
+    SLOG_ALWAYS_INLINE static size_t decode(const std::byte* base, size_t offset, V& out) noexcept
+    {
+        if constexpr (kind == ArgKind::STRING) {
+            size_t len;
+
+            offset = align_up(offset, alignof(size_t));
+            std::memcpy(&len, base + offset, sizeof(size_t));
+            offset += sizeof(size_t);
+            out = std::string_view(reinterpret_cast<const char*>(base + offset), len);
+            return offset + len;
+        }
+        else {
+            offset = align_up(offset, alignof(T));
+            out = std::launder(reinterpret_cast<const T*>(base + offset));
+            return offset + sizeof(T);
+        }
+    }
+
+    // Walks the argument running the manager operation, returns the next offset
+    static size_t manage(ArgBuffer::ManagerOp op, std::byte* dst, std::byte* src, size_t offset)
+    {
+        const std::byte* walk = src ? src : dst;
+
+        if constexpr (kind == ArgKind::STRING) {
+            size_t len;
+
+            offset = align_up(offset, alignof(size_t));
+            std::memcpy(&len, walk + offset, sizeof(size_t));
+            return offset + sizeof(size_t) + len;
+        }
+        else {
+            offset = align_up(offset, alignof(T));
+            if constexpr (kind == ArgKind::BOXED) {
+                T* src_obj = src ? std::launder(reinterpret_cast<T*>(src + offset)) : nullptr;
+                T* dst_obj = reinterpret_cast<T*>(dst + offset);
+
+                switch (op) {
+                case ArgBuffer::ManagerOp::COPY: ::new (static_cast<void*>(dst_obj)) T(*src_obj); break;
+                case ArgBuffer::ManagerOp::MOVE:
+                    ::new (static_cast<void*>(dst_obj)) T(std::move(*src_obj));
+                    src_obj->~T();
+                    break;
+                case ArgBuffer::ManagerOp::DESTROY: std::launder(dst_obj)->~T(); break;
+                }
+            }
+            return offset + sizeof(T);
+        }
+    }
+};
+
+// Decoded representation: string-like arguments as std::string_view, others as a pointer
+// into the buffer (dereferenced right before formatting)
+template<typename T>
+using decoded_t =
+    std::conditional_t<arg_kind_v<T> == ArgKind::STRING, std::string_view, const T*>;
+
+template<typename T>
+SLOG_ALWAYS_INLINE const auto& decoded_ref(const T& v) noexcept
+{
+    if constexpr (std::is_pointer_v<T>) {
+        return *v;
+    }
+    else {
+        return v;
+    }
+}
+
+template<typename... Args>
+void manage_args(ArgBuffer::ManagerOp op, std::byte* dst, std::byte* src)
+{
+    size_t offset = 0;
+
+    ((offset = ArgCodec<Args>::manage(op, dst, src, offset)), ...);
+}
+
+// Destroys the first `count` arguments of a payload whose encoding stopped on an exception
+template<typename... Args>
+void destroy_args(std::byte* base, size_t count) noexcept
+{
+    size_t offset = 0;
+    size_t index = 0;
+
+    ((offset = index++ < count ? ArgCodec<Args>::manage(ArgBuffer::ManagerOp::DESTROY, base, nullptr, offset)
+                               : offset),
+     ...);
+}
+
+// Until dismissed, drops the arguments already encoded when a copy constructor throws (the
+// manager is only set once every argument is built)
+template<typename... Args>
+struct EncodeGuard
+{
+    ~EncodeGuard()
+    {
+        if (built < sizeof...(Args)) {
+            destroy_args<Args...>(base, built);
+            buffer.reset();
+        }
+    }
+
+    ArgBuffer& buffer;
+    std::byte* base;
+    size_t built{0};
+};
+
+} // namespace detail
+
+// Encodes `args` into `buffer`. `Args` must be the decayed argument types the record will be
+// decoded with (i.e. the ones `format_deferred` is instantiated with).
+template<typename... Args, typename... Fwd>
+SLOG_ALWAYS_INLINE void store_args(ArgBuffer& buffer, Fwd&&... args)
+{
+    static_assert(sizeof...(Args) == sizeof...(Fwd));
+
+    if constexpr (sizeof...(Args) == 0) {
+        buffer.reset();
+    }
+    else {
+        size_t size = 0;
+        size_t offset = 0;
+        std::byte* base;
+
+        ((size = detail::ArgCodec<Args>::size(size, args)), ...);
+        base = buffer.allocate(size);
+        if constexpr (((detail::arg_kind_v<Args> == detail::ArgKind::BOXED) || ...)) {
+            detail::EncodeGuard<Args...> guard{buffer, base};
+
+            ((offset = detail::ArgCodec<Args>::encode(base, offset, std::forward<Fwd>(args)), guard.built++), ...);
+            buffer.set_manager(&detail::manage_args<Args...>);
+        }
+        else {
+            ((offset = detail::ArgCodec<Args>::encode(base, offset, std::forward<Fwd>(args))), ...);
+        }
+    }
+}
+
+} // namespace slog::fmt
+
+#endif // SLOG_FMT_ARG_BUFFER_HPP
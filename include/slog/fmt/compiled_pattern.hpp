@@ -0,0 +1,500 @@
+#ifndef SLOG_FMT_COMPILED_PATTERN_HPP
+#define SLOG_FMT_COMPILED_PATTERN_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <slog/core/log_level.hpp>
+#include <slog/core/log_record.hpp>
+#include <slog/details/filesystem.hpp>
+#include <slog/details/macros.hpp>
+#include <slog/fmt/digits.hpp>
+#include <slog/fmt/format_context.hpp>
+
+namespace slog::fmt
+{
+
+// String literal usable as a template argument: compiled_pattern<"[%l] %v\n">
+template<size_t N>
+struct PatternString
+{
+    constexpr PatternString(const char (&str)[N]) noexcept { std::copy_n(str, N, data); }
+
+    [[nodiscard]] constexpr std::string_view view() const noexcept { return {data, N - 1}; }
+
+    char data[N]{};
+};
+
+namespace detail
+{
+
+SLOG_ALWAYS_INLINE char* write_text(char* out, std::string_view text) noexcept
+{
+    std::memcpy(out, text.data(), text.size());
+    return out + text.size();
+}
+
+[[nodiscard]] SLOG_ALWAYS_INLINE std::string_view c_str_view(const char* str) noexcept
+{
+    return str ? std::string_view(str) : std::string_view{};
+}
+
+// Built-in flags for compiled patterns. `WIDTH` is the maximum output of a bounded flag, or 0
+// for text of unbounded size (message, names, source location) returned by `text()`.
+template<char Flag>
+struct CompiledFlag;
+
+template<size_t Width, int Modulo>
+struct CompiledTimeFlag
+{
+    static constexpr size_t WIDTH = Width;
+
+    SLOG_ALWAYS_INLINE static char* write_value(char* out, int value) noexcept
+    {
+        return write_fixed<Width>(out, static_cast<uint32_t>(value % Modulo));
+    }
+};
+
+// System clock years stay within 4 digits
+template<> struct CompiledFlag<'Y'> : CompiledTimeFlag<4, 10000>
+{
+    SLOG_ALWAYS_INLINE static char* write(const FormatContext& ctx, char* out) noexcept
+    {
+        return write_value(out, ctx.time().year);
+    }
+};
+
+template<> struct CompiledFlag<'m'> : CompiledTimeFlag<2, 100>
+{
+    SLOG_ALWAYS_INLINE static char* write(const FormatContext& ctx, char* out) noexcept
+    {
+        return write_value(out, ctx.time().month);
+    }
+};
+
+template<> struct CompiledFlag<'d'> : CompiledTimeFlag<2, 100>
+{
+    SLOG_ALWAYS_INLINE static char* write(const FormatContext& ctx, char* out) noexcept
+    {
+        return write_value(out, ctx.time().day);
+    }
+};
+
+template<> struct CompiledFlag<'H'> : CompiledTimeFlag<2, 100>
+{
+    SLOG_ALWAYS_INLINE static char* write(const FormatContext& ctx, char* out) noexcept
+    {
+        return write_value(out, ctx.time().hour);
+    }
+};
+
+template<> struct CompiledFlag<'M'> : CompiledTimeFlag<2, 100>
+{
+    SLOG_ALWAYS_INLINE static char* write(const FormatContext& ctx, char* out) noexcept
+    {
+        return write_value(out, ctx.time().minute);
+    }
+};
+
+template<> struct CompiledFlag<'S'> : CompiledTimeFlag<2, 100>
+{
+    SLOG_ALWAYS_INLINE static char* write(const FormatContext& ctx, char* out) noexcept
+    {
+        return write_value(out, ctx.time().second);
+    }
+};
+
+template<> struct CompiledFlag<'e'> : CompiledTimeFlag<3, 1000>
+{
+    SLOG_ALWAYS_INLINE static char* write(const FormatContext& ctx, char* out) noexcept
+    {
+        return write_value(out, ctx.time().millis);
+    }
+};
+
+template<> struct CompiledFlag<'f'> : CompiledTimeFlag<6, 1000000>
+{
+    SLOG_ALWAYS_INLINE static char* write(const FormatContext& ctx, char* out) noexcept
+    {
+        return write_value(out, ctx.time().micros);
+    }
+};
+
+template<> struct CompiledFlag<'l'>
+{
+    static constexpr size_t WIDTH = 7; // WARNING, UNKNOWN
+
+    SLOG_ALWAYS_INLINE static char* write(const FormatContext& ctx, char* out) noexcept
+    {
+        return write_text(out, slog::to_string(ctx.record.level));
+    }
+};
+
+template<> struct CompiledFlag<'L'>
+{
+    static constexpr size_t WIDTH = 1;
+
+    SLOG_ALWAYS_INLINE static char* write(const FormatContext& ctx, char* out) noexcept
+    {
+        *out = slog::to_string(ctx.record.level)[0];
+        return out + 1;
+    }
+};
+
+template<> struct CompiledFlag<'t'>
+{
+    static constexpr size_t WIDTH = std::numeric_limits<size_t>::digits10 + 1;
+
+    SLOG_ALWAYS_INLINE static char* write(const FormatContext& ctx, char* out) noexcept
+    {
+        if (ctx.record.thread) [[likely]] {
+            return write_text(out, ctx.record.thread->id_text());
+        }
+        return write_decimal(out, ctx.record.thread_id);
+    }
+};
+
+template<> struct CompiledFlag<'#'>
+{
+    static constexpr size_t WIDTH = std::numeric_limits<std::uint_least32_t>::digits10 + 1;
+
+    SLOG_ALWAYS_INLINE static char* write(const FormatContext& ctx, char* out) noexcept
+    {
+        return write_decimal(out, ctx.record.location.line());
+    }
+};
+
+// Flags of unbounded output
+template<typename Derived>
+struct CompiledTextFlag
+{
+    static constexpr size_t WIDTH = 0;
+
+    [[nodiscard]] SLOG_ALWAYS_INLINE static size_t size(const FormatContext& ctx) noexcept
+    {
+        return Derived::text(ctx).size();
+    }
+
+    SLOG_ALWAYS_INLINE static char* write(const FormatContext& ctx, char* out) noexcept
+    {
+        return write_text(out, Derived::text(ctx));
+    }
+};
+
+template<> struct CompiledFlag<'v'> : CompiledTextFlag<CompiledFlag<'v'>>
+{
+    [[nodiscard]] SLOG_ALWAYS_INLINE static std::string_view text(const FormatContext& ctx) noexcept
+    {
+        return ctx.record.string_buffer;
+    }
+};
+
+template<> struct CompiledFlag<'n'> : CompiledTextFlag<CompiledFlag<'n'>>
+{
+    [[nodiscard]] SLOG_ALWAYS_INLINE static std::string_view text(const FormatContext& ctx) noexcept
+    {
+        return ctx.record.logger_name;
+    }
+};
+
+// Thread id when the thread has no name or the record no thread context
+template<> struct CompiledFlag<'N'>
+{
+    static constexpr size_t WIDTH = std::max(slog::details::ThreadContext::MAX_NAME - 1,
+                                             CompiledFlag<'t'>::WIDTH);
+
+    SLOG_ALWAYS_INLINE static char* write(const FormatContext& ctx, char* out) noexcept
+    {
+        if (ctx.record.thread) [[likely]] {
+            return write_text(out, ctx.record.thread->name());
+        }
+        return write_decimal(out, ctx.record.thread_id);
+    }
+};
+
+template<> struct CompiledFlag<'s'> : CompiledTextFlag<CompiledFlag<'s'>>
+{
+    [[nodiscard]] SLOG_ALWAYS_INLINE static std::string_view text(const FormatContext& ctx) noexcept
+    {
+        return slog::details::path_basename(c_str_view(ctx.record.location.file_name()));
+    }
+};
+
+template<> struct CompiledFlag<'g'> : CompiledTextFlag<CompiledFlag<'g'>>
+{
+    [[nodiscard]] SLOG_ALWAYS_INLINE static std::string_view text(const FormatContext& ctx) noexcept
+    {
+        return c_str_view(ctx.record.location.file_name());
+    }
+};
+
+template<> struct CompiledFlag<'!'> : CompiledTextFlag<CompiledFlag<'!'>>
+{
+    [[nodiscard]] SLOG_ALWAYS_INLINE static std::string_view text(const FormatContext& ctx) noexcept
+    {
+        return c_str_view(ctx.record.location.function_name());
+    }
+};
+
+// Built-in flag reached through function pointers, for patterns parsed at runtime
+struct FlagWriter
+{
+    size_t width{0}; // maximum output, 0 for unbounded flags: their output is text()
+    std::string_view (*text)(const FormatContext& ctx){nullptr};
+    char* (*write)(const FormatContext& ctx, char* out){nullptr};
+};
+
+template<char Flag>
+consteval FlagWriter make_flag_writer() noexcept
+{
+    using Traits = CompiledFlag<Flag>;
+
+    if constexpr (Traits::WIDTH == 0) {
+        return FlagWriter{0, &Traits::text, &Traits::write};
+    }
+    else {
+        return FlagWriter{Traits::WIDTH, nullptr, &Traits::write};
+    }
+}
+
+// Indexed by the flag character, `write` is null for characters that are not built-in flags
+inline constexpr std::array<FlagWriter, 128> FLAG_WRITERS = [] {
+    std::array<FlagWriter, 128> writers{};
+
+    writers['v'] = make_flag_writer<'v'>();
+    writers['l'] = make_flag_writer<'l'>();
+    writers['L'] = make_flag_writer<'L'>();
+    writers['t'] = make_flag_writer<'t'>();
+    writers['N'] = make_flag_writer<'N'>();
+    writers['Y'] = make_flag_writer<'Y'>();
+    writers['m'] = make_flag_writer<'m'>();
+    writers['d'] = make_flag_writer<'d'>();
+    writers['H'] = make_flag_writer<'H'>();
+    writers['M'] = make_flag_writer<'M'>();
+    writers['S'] = make_flag_writer<'S'>();
+    writers['e'] = make_flag_writer<'e'>();
+    writers['f'] = make_flag_writer<'f'>();
+    writers['s'] = make_flag_writer<'s'>();
+    writers['g'] = make_flag_writer<'g'>();
+    writers['#'] = make_flag_writer<'#'>();
+    writers['!'] = make_flag_writer<'!'>();
+    writers['n'] = make_flag_writer<'n'>();
+    return writers;
+}();
+
+[[nodiscard]] constexpr bool is_builtin_flag(char c) noexcept
+{
+    auto index = static_cast<uint8_t>(c);
+
+    return index < FLAG_WRITERS.size() && FLAG_WRITERS[index].write != nullptr;
+}
+
+} // namespace detail
+
+// Pattern parsed at compile time into a straight-line formatting function: literals are copied
+// with a constant size and every flag is inlined, no step loop and no call through the flag
+// table. The output is sized once (bounded flags at their maximum width), written through a
+// cursor, then trimmed. "%H:%M:%S.%e" is rendered as a single block.
+//
+// Only the built-in flags are known, flags registered with PatternFormatter::register_flag
+// need the runtime formatter. Unknown flags are literals, as in PatternFormatter.
+template<PatternString Pattern>
+class CompiledPattern
+{
+    static constexpr size_t N = sizeof(Pattern.data);
+    static constexpr char CLOCK = '\1'; // "%H:%M:%S.%e", fused into one step
+
+    struct Step
+    {
+        char flag;        // '\0' for a literal
+        uint16_t offset;  // literal, into LITERALS
+        uint16_t size;
+    };
+
+    struct Parsed
+    {
+        std::array<Step, N> steps{};
+        size_t count{0};
+        std::array<char, N> literals{};
+        size_t literals_size{0};
+    };
+
+    static consteval Parsed _parse()
+    {
+        Parsed parsed;
+        std::string_view pattern = Pattern.view();
+        size_t literal_begin = 0;
+
+        auto push_char = [&](char c) { parsed.literals[parsed.literals_size++] = c; };
+        auto flush = [&]() {
+            if (parsed.literals_size != literal_begin) {
+                parsed.steps[parsed.count++] = Step{'\0', static_cast<uint16_t>(literal_begin),
+                                                    static_cast<uint16_t>(parsed.literals_size -
+                                                                          literal_begin)};
+                literal_begin = parsed.literals_size;
+            }
+        };
+
+        for (size_t i = 0; i < pattern.size();) {
+            if (pattern[i] == '%' && i + 1 < pattern.size()) {
+                char next = pattern[i + 1];
+
+                if (next == '%') {
+                    push_char('%');
+                }
+                else if (detail::is_builtin_flag(next)) {
+                    flush();
+                    parsed.steps[parsed.count++] = Step{next, 0, 0};
+                }
+                else {
+                    push_char('%');
+                    push_char(next);
+                }
+                i += 2;
+            }
+            else {
+                push_char(pattern[i]);
+                i++;
+            }
+        }
+        flush();
+        _fuse_clock(parsed);
+        return parsed;
+    }
+
+    // The clock is written by one kernel instead of three flags and two separators
+    static consteval void _fuse_clock(Parsed& parsed)
+    {
+        constexpr std::string_view CLOCK_STEPS = "H:M:S.e";
+        size_t count = 0;
+
+        auto matches = [&](size_t begin) {
+            if (begin + CLOCK_STEPS.size() > parsed.count) {
+                return false;
+            }
+            for (size_t i = 0; i < CLOCK_STEPS.size(); i++) {
+                const Step& step = parsed.steps[begin + i];
+                bool literal = i % 2 != 0;
+
+                if (literal ? step.flag != '\0' || step.size != 1 ||
+                                  parsed.literals[step.offset] != CLOCK_STEPS[i]
+                            : step.flag != CLOCK_STEPS[i]) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        for (size_t i = 0; i < parsed.count; i++) {
+            if (matches(i)) {
+                parsed.steps[count++] = Step{CLOCK, 0, 0};
+                i += CLOCK_STEPS.size() - 1;
+            }
+            else {
+                parsed.steps[count++] = parsed.steps[i];
+            }
+        }
+        parsed.count = count;
+    }
+
+    static constexpr Parsed PARSED = _parse();
+
+    template<size_t I>
+    static constexpr Step STEP = PARSED.steps[I];
+
+    static consteval size_t _max_fixed_width()
+    {
+        size_t width = 0;
+
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            ((width += _fixed_width<I>()), ...);
+        }(std::make_index_sequence<PARSED.count>{});
+        return width;
+    }
+
+    template<size_t I>
+    static consteval size_t _fixed_width()
+    {
+        if constexpr (STEP<I>.flag == '\0') {
+            return STEP<I>.size;
+        }
+        else if constexpr (STEP<I>.flag == CLOCK) {
+            return detail::CLOCK_WIDTH;
+        }
+        else {
+            return detail::CompiledFlag<STEP<I>.flag>::WIDTH;
+        }
+    }
+
+public:
+    // Upper bound of the output without the unbounded fields (message, names, source location)
+    static constexpr size_t MAX_FIXED_WIDTH = _max_fixed_width();
+
+    [[nodiscard]] static constexpr std::string_view pattern() noexcept { return Pattern.view(); }
+
+    static void format(const FormatContext& ctx, std::string& dest)
+    {
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            size_t begin = dest.size();
+            size_t size = MAX_FIXED_WIDTH;
+
+            ((size += _variable_size<I>(ctx)), ...);
+            dest.resize(begin + size);
+
+            char* out = dest.data() + begin;
+
+            ((out = _write<I>(ctx, out)), ...);
+            dest.resize(static_cast<size_t>(out - dest.data()));
+        }(std::make_index_sequence<PARSED.count>{});
+    }
+
+private:
+    template<size_t I>
+    [[nodiscard]] SLOG_ALWAYS_INLINE static size_t _variable_size(const FormatContext& ctx) noexcept
+    {
+        if constexpr (STEP<I>.flag == '\0' || STEP<I>.flag == CLOCK) {
+            return 0;
+        }
+        else if constexpr (detail::CompiledFlag<STEP<I>.flag>::WIDTH == 0) {
+            return detail::CompiledFlag<STEP<I>.flag>::size(ctx);
+        }
+        else {
+            return 0;
+        }
+    }
+
+    template<size_t I>
+    SLOG_ALWAYS_INLINE static char* _write(const FormatContext& ctx, char* out) noexcept
+    {
+        if constexpr (STEP<I>.flag == '\0') {
+            std::memcpy(out, PARSED.literals.data() + STEP<I>.offset, STEP<I>.size);
+            return out + STEP<I>.size;
+        }
+        else if constexpr (STEP<I>.flag == CLOCK) {
+            const slog::details::TimeComponents& time = ctx.time();
+
+            return detail::write_clock(out, static_cast<uint32_t>(time.hour),
+                                       static_cast<uint32_t>(time.minute),
+                                       static_cast<uint32_t>(time.second),
+                                       static_cast<uint32_t>(time.millis));
+        }
+        else {
+            return detail::CompiledFlag<STEP<I>.flag>::write(ctx, out);
+        }
+    }
+};
+
+// Tag passed to set_pattern() of formatters, sinks and sink managers
+template<PatternString Pattern>
+inline constexpr CompiledPattern<Pattern> compiled_pattern{};
+
+} // namespace slog::fmt
+
+#endif // SLOG_FMT_COMPILED_PATTERN_HPP
@@ -1,22 +1,48 @@
 #ifndef SLOG_FMT_DEFERRED_FORMAT_HPP
 #define SLOG_FMT_DEFERRED_FORMAT_HPP
 
-#include <any>
 #include <format>
+#include <iterator>
 #include <string>
 #include <string_view>
 #include <tuple>
 
+#include <slog/fmt/arg_buffer.hpp>
+#include <slog/fmt/portable_args.hpp>
+
 namespace slog::fmt
 {
 
+// Decodes the arguments encoded by `store_args<Args...>` starting at `args` and formats them
+// into `out`. Taking the raw payload lets records be decoded wherever their bytes live.
+// FormatMode::PORTABLE_ARGS appends their portable encoding to `out` instead: argument count,
+// one tag per argument, then the values.
+template<typename... Args>
+void format_deferred(std::string_view sv, const std::byte* args, std::string& out, FormatMode mode)
+{
+    if (mode == FormatMode::PORTABLE_ARGS) [[unlikely]] {
+        encode_portable<Args...>(args, out);
+        return;
+    }
+
+    std::tuple<detail::decoded_t<Args>...> decoded;
+    [[maybe_unused]] size_t offset = 0;
+
+    std::apply([&](auto&... d) {
+        ((offset = detail::ArgCodec<Args>::decode(args, offset, d)), ...);
+    }, decoded);
+
+    // Formatting in place lets `out` reuse its capacity across records
+    out.clear();
+    std::apply([&](const auto&... d) {
+        std::vformat_to(std::back_inserter(out), sv, std::make_format_args(detail::decoded_ref(d)...));
+    }, decoded);
+}
+
 template<typename... Args>
-void format_deferred(std::string_view sv, std::any& stored, std::string& out)
+void format_deferred(std::string_view sv, const ArgBuffer& stored, std::string& out)
 {
-    auto& tup = std::any_cast<std::tuple<Args...>&>(stored);
-    std::apply([&](auto&... a) {
-        out = std::vformat(sv, std::make_format_args(a...));
-    }, tup);
+    format_deferred<Args...>(sv, stored.data(), out, FormatMode::MESSAGE);
 }
 
 } // namespace slog::fmt
@@ -0,0 +1,147 @@
+#ifndef SLOG_FMT_DIGITS_HPP
+#define SLOG_FMT_DIGITS_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <slog/details/macros.hpp>
+
+// Decimal kernels of the numeric pattern flags. Digits are written two at a time from a table,
+// the value must fit the width of the fixed width writers.
+namespace slog::fmt::detail
+{
+
+// "00" "01" ... "99"
+inline constexpr std::array<char, 200> DIGIT_PAIRS = [] {
+    std::array<char, 200> pairs{};
+
+    for (size_t i = 0; i < 100; i++) {
+        pairs[i * 2] = static_cast<char>('0' + i / 10);
+        pairs[i * 2 + 1] = static_cast<char>('0' + i % 10);
+    }
+    return pairs;
+}();
+
+inline constexpr std::array<uint64_t, 20> POWERS_OF_10 = [] {
+    std::array<uint64_t, 20> powers{};
+    uint64_t power = 1;
+
+    for (uint64_t& p : powers) {
+        p = power;
+        power *= 10;
+    }
+    return powers;
+}();
+
+SLOG_ALWAYS_INLINE void write_pair(char* out, uint32_t value) noexcept
+{
+    std::memcpy(out, DIGIT_PAIRS.data() + value * 2, 2);
+}
+
+// No loop and no division: log10 estimated from the bit width (1233 / 4096 ~ log10(2)),
+// corrected by one table compare
+[[nodiscard]] SLOG_ALWAYS_INLINE constexpr size_t count_digits(uint64_t value) noexcept
+{
+    value |= 1; // 0 has one digit, the count of others is unchanged
+    auto estimate = static_cast<size_t>((std::bit_width(value) * 1233) >> 12);
+
+    return estimate + 1 - static_cast<size_t>(value < POWERS_OF_10[estimate]);
+}
+
+// Writes exactly `Width` digits
+template<size_t Width>
+SLOG_ALWAYS_INLINE char* write_fixed(char* out, uint32_t value) noexcept
+{
+    char* end = out + Width;
+    char* cursor = end;
+
+    for (size_t i = 0; i < Width / 2; i++) {
+        cursor -= 2;
+        write_pair(cursor, value % 100);
+        value /= 100;
+    }
+    if constexpr (Width % 2 != 0) {
+        *out = static_cast<char>('0' + value);
+    }
+    return end;
+}
+
+// Writes `digits` digits, the right count for the value is count_digits()
+SLOG_ALWAYS_INLINE char* write_digits(char* out, uint64_t value, size_t digits) noexcept
+{
+    char* end = out + digits;
+    char* cursor = end;
+
+    while (value >= 100) {
+        cursor -= 2;
+        write_pair(cursor, static_cast<uint32_t>(value % 100));
+        value /= 100;
+    }
+    if (value >= 10) {
+        write_pair(cursor - 2, static_cast<uint32_t>(value));
+    }
+    else {
+        cursor[-1] = static_cast<char>('0' + value);
+    }
+    return end;
+}
+
+SLOG_ALWAYS_INLINE char* write_decimal(char* out, uint64_t value) noexcept
+{
+    return write_digits(out, value, count_digits(value));
+}
+
+// Zero padded to `width`, wider values are written whole
+SLOG_ALWAYS_INLINE char* write_padded(char* out, uint64_t value, size_t width) noexcept
+{
+    size_t digits = count_digits(value);
+
+    if (digits < width) {
+        std::memset(out, '0', width - digits);
+        out += width - digits;
+    }
+    return write_digits(out, value, digits);
+}
+
+// "HH:MM:SS.mmm", every field must be in range
+inline constexpr size_t CLOCK_WIDTH = 12;
+
+SLOG_ALWAYS_INLINE char* write_clock(char* out, uint32_t hour, uint32_t minute, uint32_t second,
+                                     uint32_t millis) noexcept
+{
+    if constexpr (std::endian::native == std::endian::little) {
+        // One 24 bit lane per field, lane i is bytes 3i..3i+2: tens, ones, separator.
+        // x * 103 >> 10 is x / 10 for x < 100 and stays in its lane (99 * 103 < 2^24).
+        uint64_t lanes = hour | (uint64_t{minute} << 24) | (uint64_t{second} << 48);
+        uint64_t tens = ((lanes * 103) >> 10) & 0x000F'0000'0F00'000FULL;
+        uint64_t ones = lanes - tens * 10;
+        uint64_t text = tens | (ones << 8) | 0x3030'3A30'303A'3030ULL; // "00:00:00"
+
+        // n * 41 >> 12 is n / 100 for n < 1000
+        uint32_t hundreds = (millis * 41) >> 12;
+        uint32_t rest = millis - hundreds * 100;
+        uint32_t rest_tens = (rest * 103) >> 10;
+        uint32_t fraction = 0x3030'302EU | (hundreds << 8) | (rest_tens << 16) | // ".000"
+                            ((rest - rest_tens * 10) << 24);
+
+        std::memcpy(out, &text, 8);
+        std::memcpy(out + 8, &fraction, 4);
+    }
+    else {
+        write_pair(out, hour);
+        out[2] = ':';
+        write_pair(out + 3, minute);
+        out[5] = ':';
+        write_pair(out + 6, second);
+        out[8] = '.';
+        write_fixed<3>(out + 9, millis);
+    }
+    return out + CLOCK_WIDTH;
+}
+
+} // namespace slog::fmt::detail
+
+#endif // SLOG_FMT_DIGITS_HPP
@@ -2,20 +2,81 @@
 #define SLOG_FMT_FORMAT_CONTEXT_HPP
 
 #include <chrono>
+#include <cstdint>
 #include <ctime>
+#include <limits>
 
 #include <slog/core/log_record.hpp>
+#include <slog/details/macros.hpp>
 #include <slog/details/time.hpp>
 
 namespace slog::fmt
 {
 
+// Decomposed local time of the last second seen. localtime (which takes the global tz lock in
+// glibc) only runs when the second changes, the sub-second fields are patched per timestamp.
+class TimeCache
+{
+public:
+
+    [[nodiscard]] SLOG_ALWAYS_INLINE const slog::details::TimeComponents&
+    get(std::chrono::system_clock::time_point tp) noexcept
+    {
+        std::chrono::seconds secs = std::chrono::floor<std::chrono::seconds>(tp.time_since_epoch());
+        std::chrono::system_clock::duration sub_secs = tp.time_since_epoch() - secs;
+
+        if (secs.count() != _second) [[unlikely]] {
+            _decompose(secs);
+        }
+        _time.millis = static_cast<int>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(sub_secs).count());
+        _time.micros = static_cast<int>(
+            std::chrono::duration_cast<std::chrono::microseconds>(sub_secs).count());
+        return _time;
+    }
+
+    // Epoch second of the last timestamp passed to get()
+    [[nodiscard]] SLOG_ALWAYS_INLINE int64_t second() const noexcept
+    {
+        return _second;
+    }
+
+private:
+
+    void _decompose(std::chrono::seconds secs) noexcept
+    {
+        std::time_t tt = static_cast<std::time_t>(secs.count());
+        std::tm tm_buf{};
+
+        slog::details::localtime(&tt, &tm_buf);
+
+        _time.year   = tm_buf.tm_year + 1900;
+        _time.month  = tm_buf.tm_mon + 1;
+        _time.day    = tm_buf.tm_mday;
+        _time.hour   = tm_buf.tm_hour;
+        _time.minute = tm_buf.tm_min;
+        _time.second = tm_buf.tm_sec;
+        _second = secs.count();
+    }
+
+    int64_t _second{std::numeric_limits<int64_t>::min()};
+    slog::details::TimeComponents _time{};
+};
+
 class SLOG_API FormatContext
 {
 public:
 
-    explicit FormatContext(const slog::LogRecord& rec) : record(rec) {
-        _decompose(_cached_time, record.timestamp);
+    explicit FormatContext(const slog::LogRecord& rec) : record(rec)
+    {
+        TimeCache cache;
+
+        _cached_time = cache.get(record.timestamp);
+    }
+
+    FormatContext(const slog::LogRecord& rec, TimeCache& cache)
+        : record(rec), _cached_time(cache.get(rec.timestamp))
+    {
     }
 
     FormatContext(const FormatContext&) = delete;
@@ -32,26 +93,6 @@ public:
 
 private:
 
-    static void _decompose(slog::details::TimeComponents& tc, std::chrono::system_clock::time_point tp)
-    {
-        std::chrono::system_clock::duration sub_secs = slog::details::sub_seconds(tp);
-        std::time_t tt = std::chrono::system_clock::to_time_t(tp);
-        std::tm tm_buf{};
-
-        slog::details::localtime(&tt, &tm_buf);
-
-        tc.year   = tm_buf.tm_year + 1900;
-        tc.month  = tm_buf.tm_mon + 1;
-        tc.day    = tm_buf.tm_mday;
-        tc.hour   = tm_buf.tm_hour;
-        tc.minute = tm_buf.tm_min;
-        tc.second = tm_buf.tm_sec;
-        tc.millis = static_cast<int>(
-            std::chrono::duration_cast<std::chrono::milliseconds>(sub_secs).count());
-        tc.micros = static_cast<int>(
-            std::chrono::duration_cast<std::chrono::microseconds>(sub_secs).count());
-    }
-
     slog::details::TimeComponents _cached_time;
 };
 
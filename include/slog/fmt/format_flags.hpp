@@ -1,6 +1,7 @@
 #ifndef SLOG_FMT_FORMAT_FLAGS_HPP
 #define SLOG_FMT_FORMAT_FLAGS_HPP
 
+#include <array>
 #include <charconv>
 #include <limits>
 #include <string>
@@ -9,8 +10,9 @@
 #include <slog/core/log_level.hpp>
 #include <slog/core/log_record.hpp>
 #include <slog/details/macros.hpp>
-#include <slog/details/thread_id.hpp>
+#include <slog/details/thread_context.hpp>
 #include <slog/details/filesystem.hpp>
+#include <slog/fmt/digits.hpp>
 #include <slog/fmt/format_context.hpp>
 
 namespace slog::fmt
@@ -24,21 +26,22 @@ namespace detail
 inline void append_padded(std::string& dest, int value, int width)
 {
     static constexpr size_t MAX_DIGITS = std::numeric_limits<int>::digits10 + 1;
-    char buf[MAX_DIGITS];
-    std::to_chars_result result;
+    char buf[MAX_DIGITS + 1]; // sign
+    char* end;
     int digits;
-    
-    result = std::to_chars(buf, buf + sizeof(buf), value);
-    if (result.ec != std::errc()) {
-        return;
+
+    if (value < 0) [[unlikely]] {
+        end = std::to_chars(buf, buf + sizeof(buf), value).ptr;
+    }
+    else {
+        end = write_decimal(buf, static_cast<uint32_t>(value));
     }
 
-    digits = static_cast<int>(result.ptr - buf);
-    while (digits < width) {
-        dest.push_back('0');
-        digits++;
+    digits = static_cast<int>(end - buf);
+    if (digits < width) {
+        dest.append(static_cast<size_t>(width - digits), '0');
     }
-    dest.append(buf, result.ptr);
+    dest.append(buf, end);
 }
 
 } // namespace detail
@@ -67,8 +70,23 @@ inline void fmt_thread_id(const FormatContext& ctx, std::string& dest)
     static constexpr size_t MAX_DIGITS = std::numeric_limits<size_t>::digits10 + 1;
     char buf[MAX_DIGITS];
 
-    std::to_chars_result result = std::to_chars(buf, buf + sizeof(buf), ctx.record.thread_id);
-    dest.append(buf, result.ptr);
+    // Pre-rendered once per thread
+    if (ctx.record.thread) [[likely]] {
+        dest.append(ctx.record.thread->id_text());
+        return;
+    }
+
+    dest.append(buf, detail::write_decimal(buf, ctx.record.thread_id));
+}
+
+// %N — thread name (thread id when unnamed)
+inline void fmt_thread_name(const FormatContext& ctx, std::string& dest)
+{
+    if (ctx.record.thread) [[likely]] {
+        dest.append(ctx.record.thread->name());
+        return;
+    }
+    fmt_thread_id(ctx, dest);
 }
 
 // %Y — year (4 digits)
@@ -141,11 +159,7 @@ inline void fmt_source_line(const FormatContext& ctx, std::string& dest)
     static constexpr size_t MAX_DIGITS = std::numeric_limits<std::uint_least32_t>::digits10 + 1;
     char buf[MAX_DIGITS];
 
-    std::to_chars_result result = std::to_chars(buf, buf + sizeof(buf), ctx.record.location.line());
-    if (result.ec != std::errc()) {
-        return;
-    }
-    dest.append(buf, result.ptr);
+    dest.append(buf, detail::write_decimal(buf, ctx.record.location.line()));
 }
 
 // %! — source function name
@@ -163,6 +177,31 @@ SLOG_ALWAYS_INLINE void fmt_logger_name(const FormatContext& ctx, std::string& d
     dest.append(ctx.record.logger_name);
 }
 
+// Flags known to PatternFormatter, indexed by the flag character
+inline constexpr std::array<FormatFn, 128> BUILTIN_FLAGS = [] {
+    std::array<FormatFn, 128> flags{};
+
+    flags['v'] = fmt_message;
+    flags['l'] = fmt_level;
+    flags['L'] = fmt_level_short;
+    flags['t'] = fmt_thread_id;
+    flags['N'] = fmt_thread_name;
+    flags['Y'] = fmt_year;
+    flags['m'] = fmt_month;
+    flags['d'] = fmt_day;
+    flags['H'] = fmt_hour;
+    flags['M'] = fmt_minute;
+    flags['S'] = fmt_second;
+    flags['e'] = fmt_millisecond;
+    flags['f'] = fmt_microsecond;
+    flags['s'] = fmt_source_file;
+    flags['g'] = fmt_source_path;
+    flags['#'] = fmt_source_line;
+    flags['!'] = fmt_source_func;
+    flags['n'] = fmt_logger_name;
+    return flags;
+}();
+
 } // namespace slog::fmt
 
 #endif // SLOG_FMT_FORMAT_FLAGS_HPP
@@ -2,13 +2,16 @@
 #define SLOG_FMT_PATTERN_FORMATTER_HPP
 
 #include <array>
+#include <atomic>
 #include <cstdint>
+#include <limits>
 #include <string>
 #include <string_view>
 #include <vector>
 
 #include <slog/config_macros.hpp>
 #include <slog/details/macros.hpp>
+#include <slog/fmt/compiled_pattern.hpp>
 #include <slog/fmt/format_context.hpp>
 #include <slog/fmt/format_flags.hpp>
 
@@ -18,7 +21,9 @@ namespace slog::fmt
 class PatternFormatter
 {
     static constexpr std::string_view DEFAULT_PATTERN = "[%Y-%m-%d %H:%M:%S.%e] [%l] %v\n";
-    static constexpr size_t TABLE_SIZE = 128;
+    static constexpr size_t TABLE_SIZE = BUILTIN_FLAGS.size();
+    static constexpr size_t MAX_UNBOUNDED = 16; // more unbounded flags fall back to appending
+    static constexpr size_t MIN_SIZED_STEPS = 4; // below, appending is cheaper than sizing
 
 public:
 
@@ -32,6 +37,12 @@ public:
         set_pattern(pattern);
     }
 
+    template<PatternString Pattern>
+    explicit PatternFormatter(CompiledPattern<Pattern> pattern)
+    {
+        set_pattern(pattern);
+    }
+
     PatternFormatter(const PatternFormatter&) = delete;
     PatternFormatter(PatternFormatter&&) = delete;
     ~PatternFormatter() = default;
@@ -41,9 +52,17 @@ public:
 
     void set_pattern(std::string_view pattern)
     {
-        _pattern = pattern;
-        _steps.clear();
+        _reset(pattern, nullptr);
         _compile(pattern);
+        _group_time_segments();
+    }
+
+    // Formats with the function generated for the pattern. Its id differs from the runtime
+    // pattern's: the generated function ignores the flags registered with register_flag().
+    template<PatternString Pattern>
+    void set_pattern(CompiledPattern<Pattern>)
+    {
+        _reset(Pattern.view(), &CompiledPattern<Pattern>::format);
     }
 
     [[nodiscard]] SLOG_ALWAYS_INLINE const std::string& get_pattern() const noexcept
@@ -51,18 +70,75 @@ public:
         return _pattern;
     }
 
+    // Process-wide id of the pattern, equal patterns of the same kind (runtime or compiled) have
+    // the same id
+    [[nodiscard]] SLOG_ALWAYS_INLINE uint32_t get_pattern_id() const noexcept
+    {
+        return _pattern_id.load(std::memory_order_relaxed);
+    }
+
+    // Bumped by every set_pattern() of any formatter
+    [[nodiscard]] SLOG_ALWAYS_INLINE static uint64_t pattern_generation() noexcept
+    {
+        return _pattern_generation.load(std::memory_order_acquire);
+    }
+
+    // Sizes the output once (bounded flags at their maximum width), writes it through a cursor
+    // then trims it. Patterns with registered flags are appended step by step.
     void format(const slog::LogRecord& record, std::string& dest) const
     {
-        FormatContext ctx(record);
+        FormatContext ctx(record, _time_cache);
+
+        if (_compiled) {
+            _compiled(ctx, dest);
+            return;
+        }
+        if (_time_cache.second() != _rendered_second) [[unlikely]] {
+            _render_time_segments(ctx);
+        }
+        if (!_sized) [[unlikely]] {
+            _append(ctx, dest);
+            return;
+        }
+
+        // Unbounded flags are measured once, their text is copied in the second pass
+        const char* texts[MAX_UNBOUNDED];
+        size_t text_sizes[MAX_UNBOUNDED];
+        size_t size = _bounded_width + _rendered.size();
+        size_t begin = dest.size();
+
+        for (size_t i = 0; i < _unbounded_steps.size(); i++) {
+            std::string_view text = _steps[_unbounded_steps[i]].writer.text(ctx);
+
+            texts[i] = text.data();
+            text_sizes[i] = text.size();
+            size += text.size();
+        }
+        dest.resize(begin + size);
+
+        size_t text = 0;
+        char* out = dest.data() + begin;
 
         for (const FormatStep& step : _steps) {
-            if (step.flag_char == '\0') {
-                dest.append(step.literal);
-            }
-            else {
-                _dispatch_table[static_cast<uint8_t>(step.flag_char)](ctx, dest);
+            switch (step.kind) {
+            case StepKind::LITERAL:
+                out = detail::write_text(out, _literal(step));
+                break;
+            case StepKind::TIME:
+                out = detail::write_text(out, _segment_text(step));
+                break;
+            case StepKind::FLAG:
+                if (step.writer.text) {
+                    out = detail::write_text(out, {texts[text], text_sizes[text]});
+                    text++;
+                }
+                else {
+                    out = step.writer.write(ctx, out);
+                }
+                break;
             }
         }
+        dest.resize(static_cast<size_t>(out - dest.data()));
     }
 
     SLOG_API static void register_flag(char c, FormatFn fn)
@@ -76,15 +152,49 @@ public:
 
 private:
 
+    enum class StepKind : uint8_t
+    {
+        LITERAL, // _literals[offset, offset + size)
+        TIME,    // text rendered for _segments[offset]
+        FLAG
+    };
+
     struct FormatStep
     {
-        char flag_char;        // '\0' for literal, otherwise the flag character
-        std::string literal;   // only populated when flag_char == '\0'
+        StepKind kind;
+        char flag_char;
+        uint32_t offset;
+        uint32_t size;
+        detail::FlagWriter writer; // built-in flags, `write` is null for registered flags
+    };
+
+    // Run of literals and second resolution flags (e.g. "[%Y-%m-%d %H:%M:%S."), rendered once
+    // per second into _rendered
+    struct TimeSegment
+    {
+        std::vector<FormatStep> steps;
+        uint32_t offset{0};
+        uint32_t size{0};
     };
 
+    void _reset(std::string_view pattern, FormatFn compiled)
+    {
+        _pattern = pattern;
+        _pattern_id.store(_intern(pattern, compiled != nullptr), std::memory_order_relaxed);
+        _pattern_generation.fetch_add(1, std::memory_order_release);
+        _compiled = compiled;
+        _literals.clear();
+        _steps.clear();
+        _segments.clear();
+        _unbounded_steps.clear();
+        _bounded_width = 0;
+        _sized = true;
+        _rendered_second = std::numeric_limits<int64_t>::min();
+    }
+
     void _compile(std::string_view pattern)
     {
-        static std::string literal_accum;
+        size_t literal_begin = 0;
 
         for (size_t i = 0; i < pattern.size();) {
             if (pattern[i] == '%' && i + 1 < pattern.size()) {
@@ -92,46 +202,187 @@ private:
 
                 if (next == '%') {
                     // %% → literal '%'
-                    literal_accum.push_back('%');
+                    _literals.push_back('%');
                     i += 2;
                     continue;
                 }
 
                 uint8_t idx = static_cast<uint8_t>(next);
                 if (idx < TABLE_SIZE && _dispatch_table[idx] != nullptr) {
-                    _literal_flush(literal_accum);
-                    _steps.push_back(FormatStep{next, {}});
+                    _literal_flush(literal_begin);
+                    _steps.push_back(FormatStep{StepKind::FLAG, next, 0, 0, _writer(next)});
                 }
                 else {
                     // Unknown flag → treat as literal "%X"
-                    literal_accum.push_back('%');
-                    literal_accum.push_back(next);
+                    _literals.push_back('%');
+                    _literals.push_back(next);
                 }
 
                 i += 2;
             }
             else {
-                literal_accum.push_back(pattern[i]);
+                _literals.push_back(pattern[i]);
                 i++;
             }
         }
 
-        _literal_flush(literal_accum);
+        _literal_flush(literal_begin);
     }
 
-    void _literal_flush(std::string& literal_accum)
+    // Writer of a built-in flag that was not overridden with register_flag()
+    [[nodiscard]] static detail::FlagWriter _writer(char flag_char) noexcept
     {
-        if (!literal_accum.empty()) {
-            _steps.push_back(FormatStep{'\0', std::move(literal_accum)});
-            literal_accum.clear();
+        auto idx = static_cast<uint8_t>(flag_char);
+
+        if (_dispatch_table[idx] != BUILTIN_FLAGS[idx]) {
+            return {};
         }
+        return detail::FLAG_WRITERS[idx];
+    }
+
+    // Flags whose output only changes with the second, overridden flags are left out
+    [[nodiscard]] static bool _is_second_resolution(char flag_char) noexcept
+    {
+        FormatFn fn = _dispatch_table[static_cast<uint8_t>(flag_char)];
+
+        return fn == fmt_year || fn == fmt_month || fn == fmt_day || fn == fmt_hour ||
+               fn == fmt_minute || fn == fmt_second;
+    }
+
+    [[nodiscard]] static bool _is_time_step(const FormatStep& step) noexcept
+    {
+        return step.kind == StepKind::LITERAL || _is_second_resolution(step.flag_char);
     }
 
+    void _group_time_segments()
+    {
+        std::vector<FormatStep> steps = std::move(_steps);
+
+        _steps.clear();
+        for (size_t i = 0; i < steps.size();) {
+            size_t end = i;
+            bool has_time = false;
+
+            while (end < steps.size() && _is_time_step(steps[end])) {
+                has_time = has_time || steps[end].kind == StepKind::FLAG;
+                end++;
+            }
+            if (!has_time) {
+                _push_step(steps[i]);
+                i++;
+                continue;
+            }
+
+            TimeSegment segment;
+
+            for (; i < end; i++) {
+                segment.steps.push_back(steps[i]);
+            }
+            _steps.push_back(FormatStep{StepKind::TIME, '\0',
+                                        static_cast<uint32_t>(_segments.size()), 0, {}});
+            _segments.push_back(std::move(segment));
+        }
+        _sized = _sized && _steps.size() >= MIN_SIZED_STEPS;
+    }
+
+    // Accounts the step in the size computed by format()
+    void _push_step(const FormatStep& step)
+    {
+        if (step.kind == StepKind::LITERAL) {
+            _bounded_width += step.size;
+        }
+        else if (!step.writer.write || (step.writer.text && _unbounded_steps.size() == MAX_UNBOUNDED)) {
+            _sized = false;
+        }
+        else if (step.writer.text) {
+            _unbounded_steps.push_back(static_cast<uint32_t>(_steps.size()));
+        }
+        else {
+            _bounded_width += step.writer.width;
+        }
+        _steps.push_back(step);
+    }
+
+    void _render_time_segments(const FormatContext& ctx) const
+    {
+        _rendered.clear();
+        for (TimeSegment& segment : _segments) {
+            segment.offset = static_cast<uint32_t>(_rendered.size());
+            for (const FormatStep& step : segment.steps) {
+                if (step.kind == StepKind::LITERAL) {
+                    _rendered.append(_literal(step));
+                }
+                else {
+                    _dispatch_table[static_cast<uint8_t>(step.flag_char)](ctx, _rendered);
+                }
+            }
+            segment.size = static_cast<uint32_t>(_rendered.size() - segment.offset);
+        }
+        _rendered_second = _time_cache.second();
+    }
+
+    void _append(const FormatContext& ctx, std::string& dest) const
+    {
+        for (const FormatStep& step : _steps) {
+            switch (step.kind) {
+            case StepKind::LITERAL:
+                dest.append(_literal(step));
+                break;
+            case StepKind::TIME:
+                dest.append(_segment_text(step));
+                break;
+            case StepKind::FLAG:
+                _dispatch_table[static_cast<uint8_t>(step.flag_char)](ctx, dest);
+                break;
+            }
+        }
+    }
+
+    [[nodiscard]] SLOG_ALWAYS_INLINE std::string_view _literal(const FormatStep& step) const noexcept
+    {
+        return {_literals.data() + step.offset, step.size};
+    }
+
+    [[nodiscard]] SLOG_ALWAYS_INLINE std::string_view
+    _segment_text(const FormatStep& step) const noexcept
+    {
+        const TimeSegment& segment = _segments[step.offset];
+
+        return {_rendered.data() + segment.offset, segment.size};
+    }
+
+    void _literal_flush(size_t& literal_begin)
+    {
+        if (_literals.size() != literal_begin) {
+            _steps.push_back(FormatStep{StepKind::LITERAL, '\0', static_cast<uint32_t>(literal_begin),
+                                        static_cast<uint32_t>(_literals.size() - literal_begin), {}});
+            literal_begin = _literals.size();
+        }
+    }
+
+    SLOG_API static uint32_t _intern(std::string_view pattern, bool compiled);
+
     SLOG_API static std::array<FormatFn, TABLE_SIZE> _dispatch_table;
+    SLOG_API static std::atomic<uint64_t> _pattern_generation;
+    std::atomic<uint32_t> _pattern_id{0};
+    FormatFn _compiled{nullptr}; // set for compiled patterns, replaces the steps
+    std::string _literals;       // literals of all the steps, back to back
     std::vector<FormatStep> _steps;
+    std::vector<uint32_t> _unbounded_steps; // flags measured per record
+    size_t _bounded_width{0};    // literals and bounded flags at their maximum width
+    bool _sized{true};           // false when a registered flag forces appending
+    // Time segments are re-rendered from const format(), callers serialize it (sink lock)
+    mutable std::vector<TimeSegment> _segments;
+    mutable std::string _rendered;
+    mutable TimeCache _time_cache;
+    mutable int64_t _rendered_second{std::numeric_limits<int64_t>::min()};
     std::string _pattern;
 };
 
 } // namespace slog::fmt
 
+#ifdef SLOG_HEADER_ONLY
+    #include <slog/impl/fmt/pattern_formatter.ipp>
+#endif // SLOG_HEADER_ONLY
+
 #endif // SLOG_FMT_PATTERN_FORMATTER_HPP
@@ -0,0 +1,310 @@
+#ifndef SLOG_FMT_PORTABLE_ARGS_HPP
+#define SLOG_FMT_PORTABLE_ARGS_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <variant>
+
+#include <slog/details/macros.hpp>
+#include <slog/fmt/arg_buffer.hpp>
+
+// Arguments of a record in a form that can be read back without their C++ types, so that
+// records can be stored in binary and formatted later (see BinaryFileSink). Integers are
+// LEB128 varints (zigzag for signed ones), floating point values little endian IEEE 754,
+// other types are formatted with "{}" when encoded and stored as text.
+namespace slog::fmt
+{
+
+enum class PortableTag : uint8_t
+{
+    BOOL,
+    CHAR,
+    INT,
+    UINT,
+    FLOAT,
+    DOUBLE,
+    STRING,
+    POINTER
+};
+
+using PortableArg =
+    std::variant<bool, char, int64_t, uint64_t, float, double, std::string_view, const void*>;
+
+namespace detail
+{
+
+inline void write_varint(std::string& out, uint64_t value)
+{
+    char buf[10];
+    size_t size = 0;
+
+    while (value >= 0x80) {
+        buf[size++] = static_cast<char>(value | 0x80);
+        value >>= 7;
+    }
+    buf[size++] = static_cast<char>(value);
+    out.append(buf, size);
+}
+
+// Consumes the value from `in`, false when `in` ends before it
+[[nodiscard]] inline bool read_varint(std::string_view& in, uint64_t& value) noexcept
+{
+    value = 0;
+    for (size_t i = 0; i < in.size() && i < 10; i++) {
+        auto byte = static_cast<uint8_t>(in[i]);
+
+        value |= uint64_t{byte & 0x7Fu} << (7 * i);
+        if (byte < 0x80) {
+            in.remove_prefix(i + 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+[[nodiscard]] constexpr uint64_t zigzag(int64_t value) noexcept
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+[[nodiscard]] constexpr int64_t unzigzag(uint64_t value) noexcept
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+template<typename T>
+using float_bits_t = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+
+template<typename T>
+void write_float(std::string& out, T value)
+{
+    auto bits = std::bit_cast<float_bits_t<T>>(value);
+    char buf[sizeof(T)];
+
+    for (size_t i = 0; i < sizeof(T); i++) {
+        buf[i] = static_cast<char>(bits >> (8 * i));
+    }
+    out.append(buf, sizeof(T));
+}
+
+template<typename T>
+[[nodiscard]] bool read_float(std::string_view& in, T& value) noexcept
+{
+    float_bits_t<T> bits = 0;
+
+    if (in.size() < sizeof(T)) {
+        return false;
+    }
+    for (size_t i = 0; i < sizeof(T); i++) {
+        bits |= float_bits_t<T>{static_cast<uint8_t>(in[i])} << (8 * i);
+    }
+    value = std::bit_cast<T>(bits);
+    in.remove_prefix(sizeof(T));
+    return true;
+}
+
+// signed char and unsigned char are formatted as integers, only char as a character
+template<typename T>
+inline constexpr PortableTag portable_tag_v =
+    std::is_same_v<T, bool>                                    ? PortableTag::BOOL
+    : std::is_same_v<T, char>                                  ? PortableTag::CHAR
+    : std::is_integral_v<T> && std::is_signed_v<T>             ? PortableTag::INT
+    : std::is_integral_v<T>                                    ? PortableTag::UINT
+    : std::is_same_v<T, float>                                 ? PortableTag::FLOAT
+    : std::is_floating_point_v<T>                              ? PortableTag::DOUBLE
+    : std::is_same_v<T, const void*> || std::is_same_v<T, void*> ||
+              std::is_same_v<T, std::nullptr_t>                ? PortableTag::POINTER
+                                                               : PortableTag::STRING;
+
+template<typename T>
+void write_portable(std::string& out, const T& value)
+{
+    constexpr PortableTag tag = portable_tag_v<T>;
+
+    if constexpr (tag == PortableTag::BOOL || tag == PortableTag::CHAR) {
+        out.push_back(static_cast<char>(value));
+    }
+    else if constexpr (tag == PortableTag::INT) {
+        write_varint(out, zigzag(static_cast<int64_t>(value)));
+    }
+    else if constexpr (tag == PortableTag::UINT) {
+        write_varint(out, static_cast<uint64_t>(value));
+    }
+    else if constexpr (tag == PortableTag::FLOAT) {
+        write_float(out, value);
+    }
+    else if constexpr (tag == PortableTag::DOUBLE) {
+        write_float(out, static_cast<double>(value));
+    }
+    else if constexpr (tag == PortableTag::POINTER) {
+        write_varint(out, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(static_cast<const void*>(value))));
+    }
+    else if constexpr (std::is_same_v<T, std::string_view>) {
+        write_varint(out, value.size());
+        out.append(value);
+    }
+    else {
+        std::string text = std::format("{}", value);
+
+        write_varint(out, text.size());
+        out.append(text);
+    }
+}
+
+} // namespace detail
+
+// Appends the portable encoding of the arguments encoded by `store_args<Args...>` at `args`
+template<typename... Args>
+void encode_portable(const std::byte* args, std::string& out)
+{
+    static_assert(sizeof...(Args) < 256, "slog: too many arguments for the portable encoding");
+
+    std::tuple<detail::decoded_t<Args>...> decoded;
+    [[maybe_unused]] size_t offset = 0;
+
+    out.push_back(static_cast<char>(sizeof...(Args)));
+    (out.push_back(static_cast<char>(detail::portable_tag_v<Args>)), ...);
+    std::apply([&](auto&... d) {
+        ((offset = detail::ArgCodec<Args>::decode(args, offset, d)), ...);
+    }, decoded);
+    std::apply([&](const auto&... d) {
+        (detail::write_portable(out, detail::decoded_ref(d)), ...);
+    }, decoded);
+}
+
+// Consumes one value of type `tag` from `in`, false when `in` ends before it.
+// Strings point into `in`.
+[[nodiscard]] inline bool read_portable(PortableTag tag, std::string_view& in, PortableArg& arg) noexcept
+{
+    uint64_t value = 0;
+
+    switch (tag) {
+    case PortableTag::BOOL:
+    case PortableTag::CHAR:
+        if (in.empty()) {
+            return false;
+        }
+        arg = tag == PortableTag::BOOL ? PortableArg{in[0] != 0} : PortableArg{in[0]};
+        in.remove_prefix(1);
+        return true;
+    case PortableTag::FLOAT: {
+        float f = 0;
+
+        if (!detail::read_float(in, f)) {
+            return false;
+        }
+        arg = f;
+        return true;
+    }
+    case PortableTag::DOUBLE: {
+        double d = 0;
+
+        if (!detail::read_float(in, d)) {
+            return false;
+        }
+        arg = d;
+        return true;
+    }
+    default:
+        break;
+    }
+
+    if (!detail::read_varint(in, value)) {
+        return false;
+    }
+    switch (tag) {
+    case PortableTag::INT: arg = detail::unzigzag(value); return true;
+    case PortableTag::UINT: arg = value; return true;
+    case PortableTag::POINTER: arg = reinterpret_cast<const void*>(static_cast<uintptr_t>(value)); return true;
+    case PortableTag::STRING:
+        if (value > in.size()) {
+            return false;
+        }
+        arg = in.substr(0, value);
+        in.remove_prefix(value);
+        return true;
+    default: return false;
+    }
+}
+
+// std::format with arguments known at runtime only: replacement fields are formatted one at a
+// time with their own spec. A field whose spec doesn't apply to the stored value (e.g. a
+// numeric spec on a value stored as text) or refers to other arguments is formatted with "{}".
+inline void format_portable(std::string_view fmt, std::span<const PortableArg> args, std::string& out)
+{
+    std::string field;
+    size_t next_arg = 0;
+
+    for (size_t i = 0; i < fmt.size(); i++) {
+        char c = fmt[i];
+
+        if ((c == '{' || c == '}') && i + 1 < fmt.size() && fmt[i + 1] == c) {
+            out.push_back(c);
+            i++;
+            continue;
+        }
+        if (c != '{') {
+            out.push_back(c);
+            continue;
+        }
+
+        // Nested fields ({:{}}) are part of the spec
+        size_t end = i + 1;
+
+        for (size_t depth = 1; end < fmt.size(); end++) {
+            depth += fmt[end] == '{' ? 1 : fmt[end] == '}' ? -1 : 0;
+            if (depth == 0) {
+                break;
+            }
+        }
+        if (end == fmt.size()) {
+            out.append(fmt.substr(i));
+            return;
+        }
+
+        std::string_view content = fmt.substr(i + 1, end - i - 1);
+        size_t colon = content.find(':');
+        std::string_view id = content.substr(0, colon);
+        size_t index = 0;
+
+        if (id.empty()) {
+            index = next_arg++;
+        }
+        else {
+            for (char digit : id) {
+                index = index * 10 + static_cast<size_t>(digit - '0');
+            }
+        }
+        if (index >= args.size()) {
+            out.append(fmt.substr(i, end - i + 1));
+        }
+        else {
+            field.assign("{");
+            if (colon != std::string_view::npos) {
+                field.append(content.substr(colon));
+            }
+            field.push_back('}');
+            std::visit([&](auto value) {
+                try {
+                    std::vformat_to(std::back_inserter(out), field, std::make_format_args(value));
+                }
+                catch (const std::format_error&) {
+                    std::format_to(std::back_inserter(out), "{}", value);
+                }
+            }, args[index]);
+        }
+        i = end;
+    }
+}
+
+} // namespace slog::fmt
+
+#endif // SLOG_FMT_PORTABLE_ARGS_HPP
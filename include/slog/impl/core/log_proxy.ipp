@@ -8,7 +8,8 @@
 
     #include <slog/core/log_level.hpp>
     #include <slog/core/logger.hpp>
-    #include <slog/details/thread_id.hpp>
+    #include <slog/details/clock.hpp>
+    #include <slog/details/thread_context.hpp>
 
 namespace slog
 {
@@ -23,8 +24,9 @@ SLOG_INLINE LogProxy::LogProxy(Logger& logger, LogLevel level,
 {
     _record.level = level;
     _record.location = loc;
-    _record.timestamp = std::chrono::system_clock::now();
-    _record.thread_id = slog::details::current_thread_id();
+    _record.timestamp = slog::details::Clock::now();
+    _record.thread = &slog::details::ThreadContext::current();
+    _record.thread_id = _record.thread->id();
 }
 
 SLOG_INLINE LogProxy::LogProxy(Logger* logger, LogLevel level,
@@ -33,8 +35,9 @@ SLOG_INLINE LogProxy::LogProxy(Logger* logger, LogLevel level,
 {
     _record.level = level;
     _record.location = loc;
-    _record.timestamp = std::chrono::system_clock::now();
-    _record.thread_id = slog::details::current_thread_id();
+    _record.timestamp = slog::details::Clock::now();
+    _record.thread = &slog::details::ThreadContext::current();
+    _record.thread_id = _record.thread->id();
 }
 
 SLOG_INLINE LogProxy::LogProxy(std::shared_ptr<Logger> logger, LogLevel level,
@@ -43,8 +46,9 @@ SLOG_INLINE LogProxy::LogProxy(std::shared_ptr<Logger> logger, LogLevel level,
 {
     _record.level = level;
     _record.location = loc;
-    _record.timestamp = std::chrono::system_clock::now();
-    _record.thread_id = slog::details::current_thread_id();
+    _record.timestamp = slog::details::Clock::now();
+    _record.thread = &slog::details::ThreadContext::current();
+    _record.thread_id = _record.thread->id();
 }
 
 
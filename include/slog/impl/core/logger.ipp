@@ -51,6 +51,9 @@ SLOG_INLINE Logger::Logger(std::string_view name, std::shared_ptr<slog::async::W
     : _name(name), _worker(worker)
 {
     _sink_manager = std::make_shared<slog::sinks::SinkManager>();
+#ifdef SLOG_ASYNC_ENABLED
+    _manager_handle = _worker->attach(_sink_manager, _name);
+#endif
 }
 
 SLOG_INLINE Logger::Logger(std::string_view name, const std::shared_ptr<slog::sinks::ISink> sink,
@@ -58,6 +61,9 @@ SLOG_INLINE Logger::Logger(std::string_view name, const std::shared_ptr<slog::si
     : _name(name), _worker(worker)
 {
     _sink_manager = std::make_shared<slog::sinks::SinkManager>(sink);
+#ifdef SLOG_ASYNC_ENABLED
+    _manager_handle = _worker->attach(_sink_manager, _name);
+#endif
 }
 
 SLOG_INLINE Logger::Logger(std::string_view name,
@@ -66,6 +72,17 @@ SLOG_INLINE Logger::Logger(std::string_view name,
     : _name(name), _worker(worker)
 {
     _sink_manager = std::make_shared<slog::sinks::SinkManager>(sinks);
+#ifdef SLOG_ASYNC_ENABLED
+    _manager_handle = _worker->attach(_sink_manager, _name);
+#endif
+}
+
+SLOG_INLINE Logger::~Logger()
+{
+#ifdef SLOG_ASYNC_ENABLED
+    // The worker keeps the manager alive until the records already pushed are dispatched
+    _worker->detach(_manager_handle);
+#endif
 }
 
 SLOG_INLINE void Logger::set_pattern(std::string_view pattern)
@@ -76,7 +93,7 @@ SLOG_INLINE void Logger::set_pattern(std::string_view pattern)
 SLOG_INLINE void Logger::_submit(LogRecord&& record)
 {
 #ifdef SLOG_ASYNC_ENABLED
-    _worker->push(slog::async::AsyncOp{std::move(record), _sink_manager});
+    _worker->push(slog::async::AsyncOp{std::move(record), _manager_handle});
 #else
     _sink_manager->dispatch(record);
 #endif
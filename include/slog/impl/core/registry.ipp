@@ -1,10 +1,14 @@
 #ifndef SLOG_CORE_REGISTRY_IPP
 #define SLOG_CORE_REGISTRY_IPP
 
+#include <algorithm>
+#include <bit>
 #include <cstdio>
+#include <functional>
 
 #include <slog/core/logger.hpp>
 #include <slog/core/registry.hpp>
+#include <slog/details/rcu.hpp>
 #include <slog/sinks/console_sink.hpp>
 
 namespace slog
@@ -14,19 +18,28 @@ namespace slog
 // Public methods
 // ------------------------
 
+SLOG_INLINE Registry::~Registry()
+{
+    if (_state.load(std::memory_order_relaxed) == RegistryState::ACTIVE) {
+        _state.store(RegistryState::INACTIVE);
+    }
+    // No reader is left once the registry is destroyed
+    for (auto& [index, epoch] : _retired_indexes) {
+        delete index;
+    }
+    delete _index.exchange(nullptr, std::memory_order_relaxed);
+    _loggers.clear();
+}
+
 SLOG_INLINE std::shared_ptr<Logger> Registry::create_logger(std::string_view name)
 {
-    std::shared_ptr<Logger> new_logger{nullptr};
-    SLOG_LOCK(_mutex);
+    return _create_logger(name, std::nullopt);
+}
 
-    for (auto& logger : _loggers) {
-        if (logger->get_name() == name) {
-            return logger;
-        }
-    }
-    new_logger = _make_logger(name, _worker);
-    _loggers.push_back(new_logger);
-    return new_logger;
+SLOG_INLINE std::shared_ptr<Logger> Registry::create_logger(std::string_view name,
+                                                            size_t worker_index)
+{
+    return _create_logger(name, worker_index);
 }
 
 SLOG_INLINE void Registry::flush() const
@@ -44,6 +57,29 @@ SLOG_INLINE Registry& Registry::instance()
     return instance;
 }
 
+SLOG_INLINE Logger& Registry::get_default_logger() const noexcept
+{
+    slog::details::Rcu::ReadGuard guard;
+
+    // Loggers are never removed, the reference outlives the guard
+    return *_index.load(std::memory_order_seq_cst)->default_logger;
+}
+
+SLOG_INLINE std::shared_ptr<Logger> Registry::get_default_logger_ptr() const noexcept
+{
+    slog::details::Rcu::ReadGuard guard;
+
+    return _index.load(std::memory_order_seq_cst)->default_logger;
+}
+
+SLOG_INLINE Logger* Registry::find_logger(std::string_view name) const noexcept
+{
+    slog::details::Rcu::ReadGuard guard;
+    const std::shared_ptr<Logger>* logger = _index.load(std::memory_order_seq_cst)->find(name);
+
+    return logger ? logger->get() : nullptr;
+}
+
 SLOG_INLINE bool Registry::set_default_logger_name(std::string_view name)
 {
     SLOG_LOCK(_mutex);
@@ -51,63 +87,242 @@ SLOG_INLINE bool Registry::set_default_logger_name(std::string_view name)
     for (const auto& logger : _loggers) {
         if (logger->get_name() == name) {
             _default_logger_name = name;
+            _publish_index();
             return true;
         }
     }
     return false;
 }
 
+SLOG_INLINE void Registry::set_sharding(slog::async::Sharding sharding) noexcept
+{
+    SLOG_LOCK(_mutex);
+
+    _sharding = sharding;
+}
+
+SLOG_INLINE void Registry::set_idle_strategy(slog::async::IdleStrategy idle) noexcept
+{
+#ifdef SLOG_ASYNC_ENABLED
+    SLOG_LOCK(_mutex);
+
+    _workers.set_idle_strategy(idle);
+#else
+    (void)idle;
+#endif
+}
+
+SLOG_INLINE bool Registry::set_queue_options(slog::async::QueueOptions options) noexcept
+{
+    if (_options_frozen.load(std::memory_order_acquire)) {
+        return false;
+    }
+    _queue_options = options;
+    return true;
+}
+
+SLOG_INLINE bool Registry::set_worker_count(size_t count) noexcept
+{
+    if (_options_frozen.load(std::memory_order_acquire)) {
+        return false;
+    }
+    _worker_count = count;
+    return true;
+}
+
+SLOG_INLINE void Registry::set_queue_full_policy(slog::async::QueueFullPolicy policy) noexcept
+{
+#ifdef SLOG_ASYNC_ENABLED
+    SLOG_LOCK(_mutex);
+
+    _workers.set_queue_full_policy(policy);
+#else
+    (void)policy;
+#endif
+}
+
+SLOG_INLINE void Registry::set_stats_interval(std::chrono::milliseconds interval, std::string_view logger_name)
+{
+#ifdef SLOG_ASYNC_ENABLED
+    std::shared_ptr<Logger> logger = logger_name.empty() ? get_default_logger_ptr() : _get_logger_ptr(logger_name);
+    SLOG_LOCK(_mutex);
+
+    if (!logger || interval.count() <= 0) {
+        _workers.set_stats_reporting(nullptr, {}, std::chrono::milliseconds(0));
+        return;
+    }
+    _workers.set_stats_reporting(logger->_sink_manager, logger->get_name(), interval);
+#else
+    (void)interval;
+    (void)logger_name;
+#endif
+}
+
+SLOG_INLINE size_t Registry::get_worker_count() const noexcept
+{
+#ifdef SLOG_ASYNC_ENABLED
+    return _workers.size();
+#else
+    return 0;
+#endif
+}
+
+SLOG_INLINE std::vector<slog::async::WorkerCounters> Registry::get_worker_counters() const
+{
+#ifdef SLOG_ASYNC_ENABLED
+    SLOG_LOCK(_mutex);
+
+    return _workers.counters();
+#else
+    return {};
+#endif
+}
+
+SLOG_INLINE std::vector<slog::async::WorkerStats> Registry::get_worker_stats() const
+{
+#ifdef SLOG_ASYNC_ENABLED
+    SLOG_LOCK(_mutex);
+
+    return _workers.stats();
+#else
+    return {};
+#endif
+}
+
 // ------------------------
 // Private methods
 // ------------------------
 
+// Read by the worker pool, before the constructor body runs
+SLOG_INLINE slog::async::QueueOptions Registry::_freeze_queue_options() noexcept
+{
+    _options_frozen.store(true, std::memory_order_release);
+    return _queue_options;
+}
+
+SLOG_INLINE size_t Registry::_freeze_worker_count() noexcept
+{
+    _options_frozen.store(true, std::memory_order_release);
+    return _worker_count;
+}
+
 SLOG_INLINE Registry::Registry()
 {
     std::shared_ptr<Logger> logger;
     _local_state = _state.load(std::memory_order_relaxed);
 
 #ifdef SLOG_ASYNC_ENABLED
-    _worker = std::make_shared<slog::async::Worker>();
+    if (_workers.size() > 1) {
+        slog::sinks::ISink::_shared_by_workers.store(true, std::memory_order_relaxed);
+    }
 #endif
-
     if (_local_state == RegistryState::ACTIVE) {
         _default_logger_name = SLOG_DEFAULT_LOGGER_NAME;
-        logger = _make_logger(_default_logger_name, _worker);
+        logger = _make_logger(_default_logger_name,
+                              _assign_worker(_default_logger_name, std::nullopt));
         logger->add_sink(
             std::make_shared<slog::sinks::ConsoleSink>(SLOG_DEFAULT_SINK_NAME, stdout));
     }
     else if (_local_state == RegistryState::INACTIVE) {
         _default_logger_name = SLOG_INACTIVE_LOGGER_NAME;
-        logger = _make_logger(_default_logger_name, _worker);
+        logger = _make_logger(_default_logger_name,
+                              _assign_worker(_default_logger_name, std::nullopt));
         logger->add_sink(
             std::make_shared<slog::sinks::ConsoleSink>(SLOG_INACTIVE_SINK_NAME, stderr));
     }
     _loggers.push_back(logger);
+    _publish_index();
 }
 
-SLOG_INLINE Logger& Registry::_get_logger(std::string_view name) const noexcept
+SLOG_INLINE std::shared_ptr<Logger> Registry::_create_logger(std::string_view name,
+                                                             std::optional<size_t> worker_index)
 {
-    {
-        SLOG_LOCK(_mutex);
+    std::shared_ptr<Logger> new_logger{nullptr};
+    SLOG_LOCK(_mutex);
 
-        for (auto& logger : _loggers) {
-            if (logger->get_name() == name) {
-                return *(logger.get());
-            }
+    for (auto& logger : _loggers) {
+        if (logger->get_name() == name) {
+            return logger;
         }
     }
-    return this->get_default_logger();
+    new_logger = _make_logger(name, _assign_worker(name, worker_index));
+    _loggers.push_back(new_logger);
+    _publish_index();
+    return new_logger;
+}
+
+SLOG_INLINE Logger& Registry::_get_logger(std::string_view name) const noexcept
+{
+    slog::details::Rcu::ReadGuard guard;
+    const LoggerIndex* index = _index.load(std::memory_order_seq_cst);
+    const std::shared_ptr<Logger>* logger = index->find(name);
+
+    // Loggers are never removed, the reference outlives the guard
+    return logger ? **logger : *index->default_logger;
 }
 
 SLOG_INLINE std::shared_ptr<Logger> Registry::_get_logger_ptr(std::string_view name) const noexcept
 {
-    {
-        SLOG_LOCK(_mutex);
+    slog::details::Rcu::ReadGuard guard;
+    const std::shared_ptr<Logger>* logger = _index.load(std::memory_order_seq_cst)->find(name);
+
+    return logger ? *logger : nullptr;
+}
 
-        for (auto& logger : _loggers) {
-            if (logger->get_name() == name) {
-                return logger;
-            }
+// Writers hold _mutex
+SLOG_INLINE void Registry::_publish_index()
+{
+    std::shared_ptr<Logger> default_logger;
+
+    for (const auto& logger : _loggers) {
+        if (logger->get_name() == _default_logger_name) {
+            default_logger = logger;
+            break;
+        }
+    }
+
+    const LoggerIndex* old = _index.exchange(new LoggerIndex(_loggers, std::move(default_logger)),
+                                             std::memory_order_seq_cst);
+
+    if (old) {
+        _retired_indexes.emplace_back(old, slog::details::Rcu::advance());
+    }
+    // Readers are short, the indexes retired by the previous changes are usually free by now
+    std::erase_if(_retired_indexes, [](const auto& retired) {
+        if (!slog::details::Rcu::quiescent(retired.second)) {
+            return false;
+        }
+        delete retired.first;
+        return true;
+    });
+}
+
+SLOG_INLINE Registry::LoggerIndex::LoggerIndex(const std::vector<std::shared_ptr<Logger>>& loggers,
+                                               std::shared_ptr<Logger> default_logger)
+    : slots(std::bit_ceil(std::max<size_t>(8, loggers.size() * 2))),
+      mask(slots.size() - 1),
+      default_logger(std::move(default_logger))
+{
+    for (const auto& logger : loggers) {
+        size_t hash = std::hash<std::string_view>{}(logger->get_name());
+        size_t i = hash & mask;
+
+        while (slots[i].logger) {
+            i = (i + 1) & mask;
+        }
+        slots[i] = Slot{hash, std::string(logger->get_name()), logger};
+    }
+}
+
+SLOG_INLINE const std::shared_ptr<Logger>*
+Registry::LoggerIndex::find(std::string_view name) const noexcept
+{
+    size_t hash = std::hash<std::string_view>{}(name);
+
+    // Linear probing, at most half full so an empty slot ends the search
+    for (size_t i = hash & mask; slots[i].logger; i = (i + 1) & mask) {
+        if (slots[i].hash == hash && slots[i].name == name) {
+            return &slots[i].logger;
         }
     }
     return nullptr;
@@ -130,6 +345,18 @@ Registry::_make_logger(std::string_view name, std::shared_ptr<slog::async::Worke
     return logger;
 }
 
+SLOG_INLINE std::shared_ptr<slog::async::Worker>
+Registry::_assign_worker(std::string_view name, std::optional<size_t> worker_index)
+{
+#ifdef SLOG_ASYNC_ENABLED
+    return worker_index ? _workers.pin(*worker_index) : _workers.assign(name, _sharding);
+#else
+    (void)name;
+    (void)worker_index;
+    return nullptr;
+#endif
+}
+
 } // namespace slog
 
 #endif // SLOG_CORE_REGISTRY_IPP
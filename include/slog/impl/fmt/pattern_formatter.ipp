@@ -1,35 +1,39 @@
 #ifndef SLOG_IMPL_FMT_PATTERN_FORMATTER_HPP
 #define SLOG_IMPL_FMT_PATTERN_FORMATTER_HPP
 
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <slog/config_macros.hpp>
 #include <slog/details/macros.hpp>
 #include <slog/fmt/pattern_formatter.hpp>
 
 namespace slog::fmt
 {
 
-    SLOG_API std::array<FormatFn, PatternFormatter::TABLE_SIZE> PatternFormatter::_dispatch_table = [] {
-        std::array<FormatFn, PatternFormatter::TABLE_SIZE> t{};
-
-        t.fill(nullptr);
-        t['v'] = fmt_message;
-        t['l'] = fmt_level;
-        t['L'] = fmt_level_short;
-        t['t'] = fmt_thread_id;
-        t['Y'] = fmt_year;
-        t['m'] = fmt_month;
-        t['d'] = fmt_day;
-        t['H'] = fmt_hour;
-        t['M'] = fmt_minute;
-        t['S'] = fmt_second;
-        t['e'] = fmt_millisecond;
-        t['f'] = fmt_microsecond;
-        t['s'] = fmt_source_file;
-        t['g'] = fmt_source_path;
-        t['#'] = fmt_source_line;
-        t['!'] = fmt_source_func;
-        t['n'] = fmt_logger_name;
-        return t;
-    }();
+    SLOG_API SLOG_INLINE std::array<FormatFn, PatternFormatter::TABLE_SIZE> PatternFormatter::_dispatch_table = BUILTIN_FLAGS;
+
+    SLOG_API SLOG_INLINE std::atomic<uint64_t> PatternFormatter::_pattern_generation{0};
+
+    // Patterns are few and set rarely, ids are never recycled. Compiled patterns are keyed apart
+    // from the runtime ones by a leading tag.
+    SLOG_API SLOG_INLINE uint32_t PatternFormatter::_intern(std::string_view pattern, bool compiled)
+    {
+        struct Table
+        {
+            std::unordered_map<std::string, uint32_t> ids;
+            SLOG_MUTEX_MEMBER(mutex)
+        };
+        static Table table;
+        SLOG_LOCK(table.mutex)
+
+        std::string key(1, compiled ? 'c' : 'r');
+
+        key.append(pattern);
+        return table.ids.try_emplace(std::move(key), static_cast<uint32_t>(table.ids.size()))
+            .first->second;
+    }
 
 
 }
@@ -0,0 +1,228 @@
+#ifndef SLOG_SINKS_BINARY_FILE_SINK_HPP
+#define SLOG_SINKS_BINARY_FILE_SINK_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <slog/config_macros.hpp>
+#include <slog/details/filesystem.hpp>
+#include <slog/details/macros.hpp>
+#include <slog/details/thread_context.hpp>
+#include <slog/fmt/portable_args.hpp>
+#include <slog/sinks/binary_log.hpp>
+#include <slog/sinks/isink.hpp>
+
+namespace slog::sinks
+{
+
+// Writes records unformatted, in the layout described in binary_log.hpp: the format string and
+// the source location of a call are stored once, then records only carry ids, the timestamp,
+// the thread id and the arguments. The sink pattern is not used, the text is rendered later by
+// slog-decode (or binary::Reader) with any pattern. Format strings must outlive the sink, as
+// string literals do.
+class SLOG_API BinaryFileSink : public ISink
+{
+public:
+    static constexpr size_t BUFFER_SIZE = size_t{64} << 10; // frames are written past this size
+    static constexpr size_t MAX_THREADS = 4096;                 // threads described, see _thread()
+
+    BinaryFileSink(const std::string_view sink_name, const std::string_view file_name,
+                   const std::string_view mode = "wb")
+        : ISink(sink_name, true, true), _file_name(file_name)
+    {
+        _stream = slog::details::fopen(_file_name, mode);
+        if (!_stream) {
+            throw std::runtime_error("Failed to open log file.");
+        }
+        _buffer.reserve(BUFFER_SIZE * 2);
+        _buffer.append(binary::MAGIC);
+    }
+
+    BinaryFileSink(const BinaryFileSink&) = delete;
+    BinaryFileSink(BinaryFileSink&&) = delete;
+
+    ~BinaryFileSink() override
+    {
+        if (_stream) {
+            this->flush();
+            std::fclose(_stream);
+        }
+    }
+
+    BinaryFileSink& operator=(const BinaryFileSink&) = delete;
+
+    void flush() override
+    {
+        _write_buffer();
+        std::fflush(_stream);
+    }
+
+    [[nodiscard]] std::string get_file_name() const { return _file_name; }
+
+private:
+    struct CallsiteKey
+    {
+        slog::fmt::DeferredFormatFn format_fn;
+        const char* format;
+        size_t format_size;
+        const char* file;
+        uint_least32_t line;
+        uint_least32_t column;
+
+        bool operator==(const CallsiteKey&) const = default;
+    };
+
+    struct CallsiteHash
+    {
+        size_t operator()(const CallsiteKey& key) const noexcept
+        {
+            return std::hash<const void*>{}(key.format) ^ (std::hash<const void*>{}(key.file) << 1) ^
+                   (size_t{key.line} << 20) ^ key.column;
+        }
+    };
+
+    // Text written to the sink directly, e.g. with ISink::log(std::string_view)
+    void _write(std::string_view message) override
+    {
+        _buffer.push_back(static_cast<char>(binary::Frame::TEXT));
+        _write_string(message);
+        _maybe_write_buffer();
+    }
+
+    void _write_record(const slog::LogRecord& record) override
+    {
+        _args.clear();
+        if (record.format_fn) {
+            record.format_fn(record.format_str, record.args(), _args,
+                             slog::fmt::FormatMode::PORTABLE_ARGS);
+        }
+        else {
+            // Stream records are formatted by the caller: a single string for "{}"
+            _args.push_back(1);
+            _args.push_back(static_cast<char>(slog::fmt::PortableTag::STRING));
+            slog::fmt::detail::write_varint(_args, record.string_buffer.size());
+            _args.append(record.string_buffer);
+        }
+
+        size_t signature = size_t{1} + static_cast<uint8_t>(_args[0]);
+        uint64_t callsite = _callsite(record, std::string_view(_args).substr(0, signature));
+        uint64_t logger = _logger(record.logger_name);
+        int64_t timestamp =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(record.timestamp.time_since_epoch()).count();
+
+        if (record.thread) {
+            _thread(*record.thread);
+        }
+        _buffer.push_back(static_cast<char>(binary::Frame::RECORD));
+        _buffer.push_back(static_cast<char>(record.level));
+        slog::fmt::detail::write_varint(_buffer, callsite);
+        slog::fmt::detail::write_varint(_buffer, logger);
+        slog::fmt::detail::write_varint(_buffer, slog::fmt::detail::zigzag(timestamp - _last_timestamp));
+        slog::fmt::detail::write_varint(_buffer, record.thread_id);
+        _buffer.append(_args, signature);
+        _last_timestamp = timestamp;
+        _maybe_write_buffer();
+    }
+
+    // Id of the call that logged `record`, described in a CALLSITE frame when first seen
+    uint64_t _callsite(const slog::LogRecord& record, std::string_view signature)
+    {
+        std::string_view format = record.format_fn ? record.format_str : std::string_view("{}");
+        CallsiteKey key{record.format_fn,         format.data(),
+                        format.size(),            record.location.file_name(),
+                        record.location.line(),   record.location.column()};
+        auto [it, inserted] = _callsites.try_emplace(key, _callsites.size());
+
+        if (inserted) {
+            _buffer.push_back(static_cast<char>(binary::Frame::CALLSITE));
+            slog::fmt::detail::write_varint(_buffer, it->second);
+            slog::fmt::detail::write_varint(_buffer, key.line);
+            slog::fmt::detail::write_varint(_buffer, key.column);
+            _write_string(key.file);
+            _write_string(record.location.function_name());
+            _write_string(format);
+            _buffer.append(signature);
+        }
+        return it->second;
+    }
+
+    // Describes the thread in a THREAD frame when first seen or renamed. Contexts are freed with
+    // their thread, threads are told apart by id and the table is bounded: once full it starts
+    // over and the threads still logging are described again.
+    void _thread(const slog::details::ThreadContext& thread)
+    {
+        auto it = _threads.find(thread.id());
+
+        if (it != _threads.end() && it->second == thread.name()) [[likely]] {
+            return;
+        }
+        if (it == _threads.end()) {
+            if (_threads.size() >= MAX_THREADS) {
+                _threads.clear();
+            }
+            it = _threads.emplace(thread.id(), std::string()).first;
+        }
+        it->second = thread.name();
+        _buffer.push_back(static_cast<char>(binary::Frame::THREAD));
+        slog::fmt::detail::write_varint(_buffer, thread.id());
+        _write_string(thread.name());
+    }
+
+    uint64_t _logger(std::string_view name)
+    {
+        if (_last_logger < _loggers.size() && _loggers[_last_logger] == name) [[likely]] {
+            return _last_logger;
+        }
+        for (_last_logger = 0; _last_logger < _loggers.size(); _last_logger++) {
+            if (_loggers[_last_logger] == name) {
+                return _last_logger;
+            }
+        }
+        _loggers.emplace_back(name);
+        _buffer.push_back(static_cast<char>(binary::Frame::LOGGER));
+        slog::fmt::detail::write_varint(_buffer, _last_logger);
+        _write_string(name);
+        return _last_logger;
+    }
+
+    void _write_string(std::string_view text)
+    {
+        slog::fmt::detail::write_varint(_buffer, text.size());
+        _buffer.append(text);
+    }
+
+    SLOG_ALWAYS_INLINE void _maybe_write_buffer()
+    {
+        if (_buffer.size() >= BUFFER_SIZE) {
+            _write_buffer();
+        }
+    }
+
+    void _write_buffer()
+    {
+        if (!_buffer.empty()) {
+            slog::details::fwrite_file(_buffer.data(), _buffer.size(), _stream);
+            _buffer.clear();
+        }
+    }
+
+    std::FILE* _stream{nullptr};
+    std::string _file_name;
+    std::string _buffer;
+    std::string _args;
+    std::unordered_map<CallsiteKey, uint64_t, CallsiteHash> _callsites;
+    std::unordered_map<size_t, std::string> _threads; // id -> name last described
+    std::vector<std::string> _loggers;
+    size_t _last_logger{0};
+    int64_t _last_timestamp{0};
+};
+
+} // namespace slog::sinks
+
+#endif // SLOG_SINKS_BINARY_FILE_SINK_HPP
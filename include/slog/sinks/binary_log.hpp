@@ -0,0 +1,263 @@
+#ifndef SLOG_SINKS_BINARY_LOG_HPP
+#define SLOG_SINKS_BINARY_LOG_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <slog/core/log_level.hpp>
+#include <slog/fmt/portable_args.hpp>
+
+// Layout of the files written by BinaryFileSink. A session starts with MAGIC and is a sequence
+// of frames, each starting with its Frame tag. Callsites, loggers and threads are described by
+// a frame once, before the first record using them:
+//  - CALLSITE: id, line, column, file, function, format string, argument count and tags
+//  - LOGGER:   id, name
+//  - THREAD:   thread id, name
+//  - RECORD:   level byte, callsite id, logger id, timestamp, thread id, argument values
+//  - TEXT:     text written to the sink directly, bypassing records
+// Numbers are LEB128 varints, strings a varint size followed by the bytes. Record timestamps
+// are nanoseconds since the epoch, zigzag encoded as a delta to the previous record.
+// Appending to a file starts a new session with its own ids.
+namespace slog::sinks::binary
+{
+
+inline constexpr std::string_view MAGIC{"SLOGBIN\x01", 8}; // the last byte is the version
+
+enum class Frame : uint8_t
+{
+    CALLSITE = 1,
+    LOGGER,
+    THREAD,
+    RECORD,
+    TEXT
+};
+
+struct Callsite
+{
+    std::string file;
+    std::string function;
+    std::string format;
+    uint32_t line{0};
+    uint32_t column{0};
+    std::vector<slog::fmt::PortableTag> tags;
+};
+
+struct Record
+{
+    const Callsite* callsite{nullptr}; // null for TEXT frames
+    std::string_view logger_name;
+    std::string_view thread_name;      // empty when the thread was not described
+    std::chrono::system_clock::time_point timestamp{};
+    uint64_t thread_id{0};
+    slog::LogLevel level{slog::LogLevel::INFO};
+    std::string message;               // formatted, the text of TEXT frames
+};
+
+// Reads the records of a binary log held in memory, in file order. The names and the callsite
+// of a record stay valid until the next call to next().
+class Reader
+{
+public:
+    explicit Reader(std::string_view data) noexcept : _data(data) {}
+
+    // False at the end of the data, or at the first frame that is truncated (e.g. the process
+    // died while writing it) or not valid, see complete()
+    [[nodiscard]] bool next(Record& record)
+    {
+        while (!_data.empty()) {
+            if (_data.starts_with(MAGIC)) {
+                _data.remove_prefix(MAGIC.size());
+                _callsites.clear();
+                _loggers.clear();
+                _threads.clear();
+                _last_timestamp = 0;
+                _started = true;
+                continue;
+            }
+            if (!_started) {
+                return false; // not a binary log
+            }
+
+            std::string_view frame = _data;
+            auto tag = static_cast<Frame>(frame[0]);
+            bool read = false;
+
+            frame.remove_prefix(1);
+            switch (tag) {
+            case Frame::CALLSITE: read = _read_callsite(frame); break;
+            case Frame::LOGGER: read = _read_name(frame, _loggers); break;
+            case Frame::THREAD: read = _read_thread(frame); break;
+            case Frame::RECORD: read = _read_record(frame, record); break;
+            case Frame::TEXT: read = _read_text(frame, record); break;
+            }
+            if (!read) {
+                return false;
+            }
+            _data = frame;
+            if (tag == Frame::RECORD || tag == Frame::TEXT) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // True once every byte was read
+    [[nodiscard]] bool complete() const noexcept { return _data.empty(); }
+
+private:
+    struct Thread
+    {
+        uint64_t id;
+        std::string name;
+    };
+
+    [[nodiscard]] static bool _read_string(std::string_view& in, std::string_view& out) noexcept
+    {
+        uint64_t size = 0;
+
+        if (!slog::fmt::detail::read_varint(in, size) || size > in.size()) {
+            return false;
+        }
+        out = in.substr(0, size);
+        in.remove_prefix(size);
+        return true;
+    }
+
+    // Ids are given in order, a frame redefining or skipping one is not valid
+    [[nodiscard]] static bool _read_id(std::string_view& in, size_t expected) noexcept
+    {
+        uint64_t id = 0;
+
+        return slog::fmt::detail::read_varint(in, id) && id == expected;
+    }
+
+    bool _read_callsite(std::string_view& in)
+    {
+        Callsite callsite;
+        uint64_t line = 0;
+        uint64_t column = 0;
+        std::string_view file;
+        std::string_view function;
+        std::string_view format;
+
+        if (!_read_id(in, _callsites.size()) || !slog::fmt::detail::read_varint(in, line) ||
+            !slog::fmt::detail::read_varint(in, column) || !_read_string(in, file) ||
+            !_read_string(in, function) || !_read_string(in, format) || in.empty()) {
+            return false;
+        }
+
+        auto count = static_cast<uint8_t>(in[0]);
+
+        if (in.size() < size_t{1} + count) {
+            return false;
+        }
+        for (size_t i = 1; i <= count; i++) {
+            callsite.tags.push_back(static_cast<slog::fmt::PortableTag>(in[i]));
+        }
+        in.remove_prefix(size_t{1} + count);
+        callsite.file = file;
+        callsite.function = function;
+        callsite.format = format;
+        callsite.line = static_cast<uint32_t>(line);
+        callsite.column = static_cast<uint32_t>(column);
+        _callsites.push_back(std::make_unique<Callsite>(std::move(callsite)));
+        return true;
+    }
+
+    bool _read_name(std::string_view& in, std::vector<std::string>& names)
+    {
+        std::string_view name;
+
+        if (!_read_id(in, names.size()) || !_read_string(in, name)) {
+            return false;
+        }
+        names.emplace_back(name);
+        return true;
+    }
+
+    bool _read_thread(std::string_view& in)
+    {
+        uint64_t id = 0;
+        std::string_view name;
+
+        if (!slog::fmt::detail::read_varint(in, id) || !_read_string(in, name)) {
+            return false;
+        }
+        for (Thread& thread : _threads) {
+            if (thread.id == id) {
+                thread.name = name; // renamed
+                return true;
+            }
+        }
+        _threads.push_back(Thread{id, std::string(name)});
+        return true;
+    }
+
+    bool _read_record(std::string_view& in, Record& record)
+    {
+        uint64_t callsite = 0;
+        uint64_t logger = 0;
+        uint64_t delta = 0;
+
+        if (in.empty()) {
+            return false;
+        }
+        record.level = static_cast<slog::LogLevel>(in[0]);
+        in.remove_prefix(1);
+        if (!slog::fmt::detail::read_varint(in, callsite) || callsite >= _callsites.size() ||
+            !slog::fmt::detail::read_varint(in, logger) || logger >= _loggers.size() ||
+            !slog::fmt::detail::read_varint(in, delta) ||
+            !slog::fmt::detail::read_varint(in, record.thread_id)) {
+            return false;
+        }
+        record.callsite = _callsites[callsite].get();
+        _args.clear();
+        for (slog::fmt::PortableTag tag : record.callsite->tags) {
+            if (!slog::fmt::read_portable(tag, in, _args.emplace_back())) {
+                return false;
+            }
+        }
+        _last_timestamp += slog::fmt::detail::unzigzag(delta);
+        record.timestamp = std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                std::chrono::nanoseconds(_last_timestamp)));
+        record.logger_name = _loggers[logger];
+        record.thread_name = {};
+        for (const Thread& thread : _threads) {
+            if (thread.id == record.thread_id) {
+                record.thread_name = thread.name;
+            }
+        }
+        record.message.clear();
+        slog::fmt::format_portable(record.callsite->format, _args, record.message);
+        return true;
+    }
+
+    bool _read_text(std::string_view& in, Record& record)
+    {
+        std::string_view text;
+
+        if (!_read_string(in, text)) {
+            return false;
+        }
+        record = Record{};
+        record.message = text;
+        return true;
+    }
+
+    std::string_view _data;
+    std::vector<std::unique_ptr<Callsite>> _callsites; // records point to them
+    std::vector<std::string> _loggers;
+    std::vector<Thread> _threads;
+    std::vector<slog::fmt::PortableArg> _args;
+    int64_t _last_timestamp{0};
+    bool _started{false};
+};
+
+} // namespace slog::sinks::binary
+
+#endif // SLOG_SINKS_BINARY_LOG_HPP
@@ -31,6 +31,17 @@ private:
             slog::details::fwrite_console(message.data(), message.size(), _stream);
         }
     }
+
+    // One stdio call for the whole batch
+    void _write_batch(std::span<const std::string_view> messages) override
+    {
+        if (_stream) [[likely]] {
+            std::string_view joined = _join(messages);
+
+            slog::details::fwrite_console(joined.data(), joined.size(), _stream);
+        }
+    }
+
     std::FILE* _stream;
 };
 
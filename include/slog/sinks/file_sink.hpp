@@ -50,6 +50,14 @@ private:
         slog::details::fwrite_file(message.data(), message.size(), _stream);
     }
 
+    // One stdio call for the whole batch
+    void _write_batch(std::span<const std::string_view> messages) override
+    {
+        std::string_view joined = _join(messages);
+
+        slog::details::fwrite_file(joined.data(), joined.size(), _stream);
+    }
+
     std::FILE* _stream{nullptr};
     std::string _file_name;
 };
@@ -1,7 +1,12 @@
 #ifndef SLOG_SINKS_ISINK_HPP
 #define SLOG_SINKS_ISINK_HPP
 
+#include <atomic>
+#include <cstring>
 #include <iosfwd>
+#include <span>
+#include <string>
+#include <string_view>
 
 #include <slog/config_macros.hpp>
 #include <slog/core/log_level.hpp>
@@ -9,9 +14,16 @@
 #include <slog/details/macros.hpp>
 #include <slog/fmt/pattern_formatter.hpp>
 
+namespace slog
+{
+class Registry;
+}
+
 namespace slog::sinks
 {
 
+class SinkManager;
+
 #ifdef SLOG_ASYNC_ENABLED
     inline namespace async {
 #else
@@ -30,39 +42,125 @@ public:
     ISink& operator=(const ISink&) = delete;
     ISink& operator=(ISink&&) = delete;
 
+    // SinkManager calls it under the sink lock, even with a single async worker: it runs on
+    // the thread calling Logger::flush while the worker may be writing the sink for another
+    // logger
     virtual void flush() = 0;
 
     [[nodiscard]] SLOG_ALWAYS_INLINE slog::LogLevel get_level() const noexcept { return _level; }
 
     [[nodiscard]] SLOG_ALWAYS_INLINE const std::string& get_name() const noexcept { return _name; }
 
-    SLOG_ALWAYS_INLINE void log(const slog::LogRecord& record, const std::string& sink_manager_pattern)
+    // Renders the record with the sink pattern. Sink managers render each distinct pattern
+    // once per record and hand the text to every sink using it.
+    void format(const slog::LogRecord& record, std::string& dest) const
     {
-        _message.clear();
+        SLOG_SINK_LOCK_IF(_sink_mutex, _must_lock())
+        _formatter.format(record, dest);
+    }
 
-        SLOG_SINK_LOCK(_sink_mutex)
-        if (_formatter.get_pattern() != sink_manager_pattern) {
-            _formatter.format(record, _message);
-            _write(_message);
-        }
-        else {
-            _write(record.message);
-        }
+    SLOG_ALWAYS_INLINE void log(std::string_view message)
+    {
+        SLOG_SINK_LOCK_IF(_sink_mutex, _must_lock())
+        _write(message);
+    }
+
+    // Batched version of log(), messages are already filtered by the sink level
+    void log(std::span<const std::string_view> messages)
+    {
+        SLOG_SINK_LOCK_IF(_sink_mutex, _must_lock())
+        _write_batch(messages);
     }
 
+    // Sinks taking records (e.g. BinaryFileSink) get them from sink managers unrendered, the
+    // message is only formatted when a sink taking text accepts the record
+    void log(const slog::LogRecord& record)
+    {
+        SLOG_SINK_LOCK_IF(_sink_mutex, _must_lock())
+        _write_record(record);
+    }
+
+    [[nodiscard]] SLOG_ALWAYS_INLINE bool takes_records() const noexcept { return _takes_records; }
+
     SLOG_ALWAYS_INLINE void set_level(const slog::LogLevel level) noexcept { _level = level; }
 
     SLOG_ALWAYS_INLINE void set_pattern(std::string_view pattern) { _formatter.set_pattern(pattern); }
 
+    template<slog::fmt::PatternString Pattern>
+    SLOG_ALWAYS_INLINE void set_pattern(slog::fmt::CompiledPattern<Pattern> pattern)
+    {
+        _formatter.set_pattern(pattern);
+    }
+
+    [[nodiscard]] SLOG_ALWAYS_INLINE uint32_t get_pattern_id() const noexcept
+    {
+        return _formatter.get_pattern_id();
+    }
+
 protected:
+    // Sinks whose flush touches the state written by _write (e.g. their own buffer) set
+    // `locks_writes`: their writes are locked even when a single worker writes the sink
+    ISink(std::string_view name, bool takes_records, bool locks_writes = false)
+        : _name(name), _takes_records(takes_records), _locks_writes(locks_writes)
+    {
+    }
+
     virtual void _write(std::string_view message) = 0;
 
+    // Records with a formatted message are rendered with the sink pattern
+    virtual void _write_record(const slog::LogRecord& record)
+    {
+        std::string text;
+
+        _formatter.format(record, text);
+        _write(text);
+    }
+
+    // Sinks able to write several messages at once (e.g. with a single syscall) override it
+    virtual void _write_batch(std::span<const std::string_view> messages)
+    {
+        for (std::string_view message : messages) {
+            _write(message);
+        }
+    }
+
+    // Concatenates `messages` into a buffer owned by the sink, valid until the next call
+    [[nodiscard]] std::string_view _join(std::span<const std::string_view> messages)
+    {
+        size_t size = 0;
+
+        for (std::string_view message : messages) {
+            size += message.size();
+        }
+        _joined.resize(size);
+
+        char* out = _joined.data();
+        for (std::string_view message : messages) {
+            std::memcpy(out, message.data(), message.size());
+            out += message.size();
+        }
+        return _joined;
+    }
+
 private:
+    [[nodiscard]] SLOG_ALWAYS_INLINE bool _must_lock() const noexcept
+    {
+        return _locks_writes || _shared_by_workers.load(std::memory_order_relaxed);
+    }
+
     slog::fmt::PatternFormatter _formatter;
     std::string _name;
-    std::string _message;
+    std::string _joined;
     slog::LogLevel _level{slog::LogLevel::TRACE};
-    SLOG_SINK_MUTEX_MEMBER(_sink_mutex)
+    bool _takes_records{false};
+    bool _locks_writes{false};
+    SLOG_MUTEX_MEMBER(_sink_mutex)
+
+    // Set by the registry when it runs more than one worker, never reset
+    static inline std::atomic<bool> _shared_by_workers{false};
+
+    friend class slog::Registry;
+    friend class slog::sinks::SinkManager;
 };
 
 }
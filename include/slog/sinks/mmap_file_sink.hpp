@@ -0,0 +1,270 @@
+#ifndef SLOG_SINKS_MMAP_FILE_SINK_HPP
+#define SLOG_SINKS_MMAP_FILE_SINK_HPP
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <slog/config_macros.hpp>
+#include <slog/details/helper_thread.hpp>
+#include <slog/details/macros.hpp>
+#include <slog/sinks/isink.hpp>
+
+namespace slog::sinks
+{
+
+// Copies messages into a shared mapping of the file: no syscall per write, the data is in the
+// page cache (and survives the process) once copied. The file grows by segments of
+// `segment_size` bytes that a helper thread allocates, maps and faults in ahead of the writer;
+// it also starts the writeback of the filled segments and unmaps them. The file size is a
+// multiple of the segment size while the sink lives, the unused tail is truncated when the
+// sink is destroyed (a crash leaves it zero filled, appending starts after the last non zero
+// byte). While a segment can't be mapped (e.g. the disk is full) messages are dropped and
+// counted, every write retries it.
+class SLOG_API MmapFileSink : public ISink
+{
+public:
+    static constexpr size_t DEFAULT_SEGMENT_SIZE = size_t{16} << 20;
+
+    MmapFileSink(const std::string_view sink_name, const std::string_view file_name,
+                 size_t segment_size = DEFAULT_SEGMENT_SIZE, bool append = false)
+        : ISink(sink_name), _file_name(file_name)
+    {
+        auto page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        int flags = O_RDWR | O_CREAT | O_CLOEXEC | (append ? 0 : O_TRUNC);
+
+        _segment_size = std::max(page, (segment_size + page - 1) / page * page);
+        _fd = ::open(_file_name.c_str(), flags, 0644);
+        if (_fd < 0) {
+            throw std::runtime_error("Failed to open log file.");
+        }
+        if (append) {
+            struct stat st{};
+
+            if (::fstat(_fd, &st) != 0) {
+                ::close(_fd);
+                throw std::runtime_error("Failed to stat log file.");
+            }
+            _written = _data_end(static_cast<size_t>(st.st_size));
+        }
+
+        // The first segment starts at the page holding the end of the file
+        size_t start = _written / page * page;
+
+        _current = _map(start);
+        if (!_current.data) {
+            ::close(_fd);
+            throw std::runtime_error("Failed to map log file.");
+        }
+        _cursor = _written - start;
+        _helper.start([this](Task& task, Segment& next) { return _run(task, next); });
+        _helper.post(Task{TaskKind::MAP, Segment{nullptr, start + _segment_size}});
+    }
+
+    MmapFileSink(const MmapFileSink&) = delete;
+    MmapFileSink(MmapFileSink&&) = delete;
+
+    ~MmapFileSink() override
+    {
+        _helper.stop();
+        _unmap(_current);
+        _unmap(_helper.prepared());
+        ::ftruncate(_fd, static_cast<off_t>(_written));
+        ::close(_fd);
+    }
+
+    MmapFileSink& operator=(const MmapFileSink&) = delete;
+
+    // The data is already in the page cache, only its writeback is started, by the helper
+    void flush() override { _helper.post(Task{TaskKind::SYNC, Segment{}}); }
+
+    [[nodiscard]] std::string get_file_name() const { return _file_name; }
+
+    [[nodiscard]] size_t get_segment_size() const noexcept { return _segment_size; }
+
+    // Bytes of the messages dropped while a segment couldn't be mapped
+    [[nodiscard]] uint64_t get_lost_bytes() const noexcept
+    {
+        return _lost_bytes.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Segment
+    {
+        char* data{nullptr}; // null if the segment couldn't be mapped
+        size_t offset{0};    // in the file
+    };
+
+    enum class TaskKind : uint8_t
+    {
+        MAP,    // allocates, maps and faults in the segment at `offset` as the next one
+        RETIRE, // starts the writeback of a filled segment and unmaps it
+        SYNC    // starts the writeback of the current segment
+    };
+
+    struct Task
+    {
+        TaskKind kind;
+        Segment segment;
+    };
+
+    void _write(std::string_view message) override
+    {
+        if (!_current.data) [[unlikely]] {
+            _roll();
+        }
+        while (!message.empty()) {
+            if (_cursor == _segment_size) [[unlikely]] {
+                _roll();
+            }
+            if (!_current.data) [[unlikely]] {
+                _lost_bytes.fetch_add(message.size(), std::memory_order_relaxed);
+                return;
+            }
+
+            size_t size = std::min(message.size(), _segment_size - _cursor);
+
+            std::memcpy(_current.data + _cursor, message.data(), size);
+            _cursor += size;
+            _written += size;
+            message.remove_prefix(size);
+        }
+    }
+
+    // Takes the segment mapped ahead, waits for it only when the helper fell behind. A segment
+    // that couldn't be mapped is mapped again rather than skipped, the file has no holes. The
+    // next segment is queued first, the writer may need it before the writeback is done.
+    void _roll()
+    {
+        _helper.take([this](Segment& next, std::deque<Task>& tasks) {
+            Segment filled = std::exchange(_current, std::exchange(next, Segment{}));
+            size_t offset = _current.data ? _current.offset + _segment_size : _current.offset;
+
+            tasks.push_back(Task{TaskKind::MAP, Segment{nullptr, offset}});
+            if (filled.data) {
+                tasks.push_back(Task{TaskKind::RETIRE, filled});
+            }
+        });
+        _cursor = 0;
+    }
+
+    // Helper thread. The segment synced is read under the helper lock, `_current` only changes
+    // in a swap; it is still mapped, its RETIRE task comes after.
+    bool _run(Task& task, Segment& next)
+    {
+        switch (task.kind) {
+        case TaskKind::MAP: next = _map(task.segment.offset); return true;
+        case TaskKind::RETIRE:
+            _writeback(task.segment);
+            _unmap(task.segment);
+            break;
+        case TaskKind::SYNC: _writeback(_helper.locked([this]() { return _current; })); break;
+        }
+        return false;
+    }
+
+    // End of the data of a file a crash left with its zero filled tail, the messages written
+    // after it would be hidden behind the zeros
+    [[nodiscard]] size_t _data_end(size_t size) const
+    {
+        std::string block(size_t{64} << 10, '\0');
+
+        while (size > 0) {
+            size_t chunk = std::min(size, block.size());
+
+            if (::pread(_fd, block.data(), chunk, static_cast<off_t>(size - chunk)) !=
+                static_cast<ssize_t>(chunk)) {
+                return size;
+            }
+
+            size_t last = block.find_last_not_of('\0', chunk - 1);
+
+            if (last != std::string::npos) {
+                return size - chunk + last + 1;
+            }
+            size -= chunk;
+        }
+        return 0;
+    }
+
+    [[nodiscard]] Segment _map(size_t offset) noexcept
+    {
+#ifdef __linux__
+        bool allocated = ::posix_fallocate(_fd, static_cast<off_t>(offset),
+                                           static_cast<off_t>(_segment_size)) == 0;
+#else
+        bool allocated = ::ftruncate(_fd, static_cast<off_t>(offset + _segment_size)) == 0;
+#endif
+        if (!allocated) {
+            return Segment{nullptr, offset};
+        }
+
+        void* data = ::mmap(nullptr, _segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd,
+                            static_cast<off_t>(offset));
+
+        if (data == MAP_FAILED) {
+            return Segment{nullptr, offset};
+        }
+
+        // Write faults are taken here rather than by the writer: one byte per page is written
+        // back in place, the segment isn't handed out yet
+        auto* bytes = static_cast<volatile char*>(data);
+        auto page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+
+        for (size_t i = 0; i < _segment_size; i += page) {
+            bytes[i] = bytes[i];
+        }
+        return Segment{static_cast<char*>(data), offset};
+    }
+
+    void _unmap(Segment& segment) noexcept
+    {
+        if (segment.data) {
+            ::munmap(segment.data, _segment_size);
+            segment.data = nullptr;
+        }
+    }
+
+    void _writeback(const Segment& segment) noexcept
+    {
+        if (!segment.data) {
+            return;
+        }
+#ifdef __linux__
+        ::sync_file_range(_fd, static_cast<off_t>(segment.offset), static_cast<off_t>(_segment_size),
+                          SYNC_FILE_RANGE_WRITE);
+#else
+        ::msync(segment.data, _segment_size, MS_ASYNC);
+#endif
+    }
+
+    std::string _file_name;
+    int _fd{-1};
+    size_t _segment_size{0};
+    Segment _current;
+    size_t _cursor{0};  // in _current
+    size_t _written{0}; // file size once truncated
+    std::atomic<uint64_t> _lost_bytes{0};
+
+    slog::details::HelperThread<Task, Segment> _helper;
+};
+
+} // namespace slog::sinks
+
+#endif
+
+#endif // SLOG_SINKS_MMAP_FILE_SINK_HPP
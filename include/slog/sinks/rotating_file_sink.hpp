@@ -0,0 +1,287 @@
+#ifndef SLOG_SINKS_ROTATING_FILE_SINK_HPP
+#define SLOG_SINKS_ROTATING_FILE_SINK_HPP
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include <slog/config_macros.hpp>
+#include <slog/details/filesystem.hpp>
+#include <slog/details/helper_thread.hpp>
+#include <slog/details/macros.hpp>
+#include <slog/sinks/isink.hpp>
+
+namespace slog::sinks
+{
+
+// When a RotatingFileSink starts a new file. Both limits can be combined, the first reached
+// rotates; intervals are aligned on the epoch (e.g. every hour on the hour).
+struct RotationPolicy
+{
+    [[nodiscard]] static constexpr RotationPolicy size(uint64_t max_size) noexcept { return {max_size, {}}; }
+
+    [[nodiscard]] static constexpr RotationPolicy every(std::chrono::seconds interval) noexcept
+    {
+        return {0, interval};
+    }
+
+    [[nodiscard]] static constexpr RotationPolicy size_or_every(uint64_t max_size,
+                                                                std::chrono::seconds interval) noexcept
+    {
+        return {max_size, interval};
+    }
+
+    uint64_t max_size{0};            // bytes, 0 for no limit
+    std::chrono::seconds interval{0}; // 0 for no limit
+};
+
+// Writes to `file_name` (appending to an existing file) and moves it to `<stem>.<n><ext>` on
+// rotation, `n` growing with every file. The next file is opened ahead by a helper thread, the
+// writer only swaps the streams: closing the full file, renaming both files and deleting the
+// oldest ones beyond `max_files` (0 keeps them all) run on the helper as well. POSIX only: the
+// files are renamed while open.
+class SLOG_API RotatingFileSink : public ISink
+{
+public:
+    RotatingFileSink(const std::string_view sink_name, const std::string_view file_name,
+                     RotationPolicy policy, size_t max_files = 0)
+        : ISink(sink_name, false, true), _file_name(file_name), _next_name(_file_name + ".next"),
+          _policy(policy), _max_files(max_files)
+    {
+        std::error_code error;
+
+        _scan_archives();
+        // A process stopped between a swap and its renames left the newest records there
+        if (std::filesystem::file_size(_next_name, error) > 0 && !error && !_promote_next()) {
+            throw std::runtime_error("Failed to rotate log file.");
+        }
+        _stream = slog::details::fopen(_file_name, "ab");
+        if (!_stream) {
+            throw std::runtime_error("Failed to open log file.");
+        }
+        _size = std::filesystem::file_size(_file_name, error);
+        _next_rotation = _boundary(std::chrono::system_clock::now());
+        _helper.start([this](Task& task, std::FILE*& next) { return _run(task, next); });
+        _helper.post(Task{nullptr});
+    }
+
+    RotatingFileSink(const RotatingFileSink&) = delete;
+    RotatingFileSink(RotatingFileSink&&) = delete;
+
+    ~RotatingFileSink() override
+    {
+        _helper.stop();
+        std::fclose(_stream);
+        if (std::FILE* next = _helper.prepared()) {
+            std::fclose(next);
+            std::error_code error;
+
+            std::filesystem::remove(_next_name, error);
+        }
+    }
+
+    RotatingFileSink& operator=(const RotatingFileSink&) = delete;
+
+    // Rotations swap `_stream` (and the helper closes the old one), hence the locked writes
+    SLOG_ALWAYS_INLINE void flush() override { std::fflush(_stream); }
+
+    [[nodiscard]] std::string get_file_name() const { return _file_name; }
+
+    [[nodiscard]] RotationPolicy get_policy() const noexcept { return _policy; }
+
+    // Rotations that waited for the helper to open the next file, it fell behind the writer
+    [[nodiscard]] uint64_t get_rotation_waits() { return _helper.waits(); }
+
+private:
+    // A null `retired` stream only opens the next file
+    struct Task
+    {
+        std::FILE* retired;
+    };
+
+    void _write(std::string_view message) override
+    {
+        _rotate_if_needed(message.size());
+        slog::details::fwrite_file(message.data(), message.size(), _stream);
+        _size += message.size();
+    }
+
+    // One stdio call for the whole batch unless it crosses a rotation
+    void _write_batch(std::span<const std::string_view> messages) override
+    {
+        std::string_view joined = _join(messages);
+
+        if (_must_rotate(joined.size())) {
+            for (std::string_view message : messages) {
+                _write(message);
+            }
+            return;
+        }
+        _restart_if_empty();
+        slog::details::fwrite_file(joined.data(), joined.size(), _stream);
+        _size += joined.size();
+    }
+
+    [[nodiscard]] SLOG_ALWAYS_INLINE bool _must_rotate(size_t incoming) const
+    {
+        if (_size == 0) {
+            return false;
+        }
+        if (_policy.max_size && _size + incoming > _policy.max_size) {
+            return true;
+        }
+        return _policy.interval.count() && std::chrono::system_clock::now() >= _next_rotation;
+    }
+
+    SLOG_ALWAYS_INLINE void _rotate_if_needed(size_t incoming)
+    {
+        if (_must_rotate(incoming)) [[unlikely]] {
+            _rotate();
+        } else {
+            _restart_if_empty();
+        }
+    }
+
+    // An empty file isn't rotated, its interval restarts
+    SLOG_ALWAYS_INLINE void _restart_if_empty()
+    {
+        if (_size == 0 && _policy.interval.count()) [[unlikely]] {
+            _next_rotation = _boundary(std::chrono::system_clock::now());
+        }
+    }
+
+    // Swaps to the file opened ahead, waits for it only when the helper fell behind. The
+    // current file is kept when there is no next one (it couldn't be opened or the previous
+    // rotation couldn't rename the files): the size limit counts again from there, the helper
+    // retries meanwhile.
+    void _rotate()
+    {
+        _helper.take([&](std::FILE*& next, std::deque<Task>& tasks) {
+            if (!next) {
+                tasks.push_back(Task{nullptr});
+                return;
+            }
+            tasks.push_back(Task{std::exchange(_stream, std::exchange(next, nullptr))});
+        });
+        _size = 0;
+        _next_rotation = _boundary(std::chrono::system_clock::now());
+    }
+
+    [[nodiscard]] std::chrono::system_clock::time_point
+    _boundary(std::chrono::system_clock::time_point now) const
+    {
+        if (!_policy.interval.count()) {
+            return std::chrono::system_clock::time_point::max();
+        }
+        auto seconds = std::chrono::floor<std::chrono::seconds>(now);
+
+        return seconds - seconds.time_since_epoch() % _policy.interval + _policy.interval;
+    }
+
+    // Helper thread, every task opens the next file once the retired one is archived. The
+    // writer already moved to the file opened ahead, still named `_next_name`: no other file is
+    // opened under that name until it is renamed.
+    bool _run(Task& task, std::FILE*& next)
+    {
+        if (task.retired) {
+            std::fclose(task.retired);
+            _renaming = true;
+        }
+        if (_renaming && !_promote_next()) {
+            next = nullptr;
+            return true;
+        }
+        _renaming = false;
+        next = slog::details::fopen(_next_name, "wb");
+        return true;
+    }
+
+    // Archives the current file, renames the next one as current and enforces the retention.
+    // False when either rename failed, the files keep their names: renaming the next file over
+    // a current one that wasn't archived would lose its records.
+    [[nodiscard]] bool _promote_next()
+    {
+        std::error_code error;
+
+        // Missing when a previous attempt only archived it
+        std::filesystem::rename(_file_name, _archive_name(_last_index + 1), error);
+        if (!error) {
+            _archives.insert(++_last_index);
+            while (_max_files && _archives.size() > _max_files) {
+                std::filesystem::remove(_archive_name(*_archives.begin()), error);
+                _archives.erase(_archives.begin());
+            }
+        }
+        else if (error != std::errc::no_such_file_or_directory) {
+            return false;
+        }
+        std::filesystem::rename(_next_name, _file_name, error);
+        return !error;
+    }
+
+    [[nodiscard]] std::string _archive_name(uint64_t index) const
+    {
+        std::filesystem::path path(_file_name);
+
+        return (path.parent_path() / (path.stem().string() + "." + std::to_string(index) + path.extension().string()))
+            .string();
+    }
+
+    // Files archived by previous runs count for the retention and the numbering
+    void _scan_archives()
+    {
+        std::filesystem::path path(_file_name);
+        std::filesystem::path directory = path.parent_path().empty() ? "." : path.parent_path();
+        std::string prefix = path.stem().string() + ".";
+        std::string extension = path.extension().string();
+        std::error_code error;
+
+        for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+            std::string name = entry.path().filename().string();
+
+            if (name.size() <= prefix.size() + extension.size() || !name.starts_with(prefix) ||
+                !name.ends_with(extension)) {
+                continue;
+            }
+
+            std::string_view digits =
+                std::string_view(name).substr(prefix.size(), name.size() - prefix.size() - extension.size());
+
+            if (digits.size() < 20 && digits.find_first_not_of("0123456789") == std::string_view::npos) {
+                _archives.insert(std::stoull(std::string(digits)));
+            }
+        }
+        _last_index = _archives.empty() ? 0 : *_archives.rbegin();
+    }
+
+    std::string _file_name;
+    std::string _next_name;
+    RotationPolicy _policy;
+    size_t _max_files;
+    std::FILE* _stream{nullptr};
+    uint64_t _size{0}; // of the current file
+    std::chrono::system_clock::time_point _next_rotation;
+
+    // Helper thread only, once it runs
+    std::set<uint64_t> _archives;
+    uint64_t _last_index{0};
+    bool _renaming{false}; // the writer's file is still named `_next_name`
+
+    slog::details::HelperThread<Task, std::FILE*> _helper;
+};
+
+} // namespace slog::sinks
+
+#endif
+
+#endif // SLOG_SINKS_ROTATING_FILE_SINK_HPP
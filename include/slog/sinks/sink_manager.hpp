@@ -1,11 +1,19 @@
 #ifndef SLOG_SINKS_SINK_MANAGER_HPP
 #define SLOG_SINKS_SINK_MANAGER_HPP
 
+#include <algorithm>
 #include <atomic>
+#include <cstdint>
+#include <limits>
 #include <memory>
+#include <span>
+#include <string>
+#include <string_view>
 #include <thread>
+#include <utility>
 #include <vector>
 
+#include <slog/details/clock.hpp>
 #include <slog/sinks/isink.hpp>
 #include <slog/fmt/pattern_formatter.hpp>
 
@@ -76,21 +84,96 @@ public:
                 }
             }
             _sinks_vec.push_back(sink);
+            _groups_generation = STALE;
             return true;
         });
     }
 
     void dispatch(slog::LogRecord& record)
     {
-        if (record.format_fn) {
-            record.format_fn(record.format_str, record.stored_args, record.string_buffer);
+        slog::LogLevel text_level = slog::LogLevel::OFF;
+
+        // Nothing is rendered, not even the message, when no sink takes the record
+        if (record.level > _guard([&]() { return _most_verbose_level(text_level); })) {
+            return;
+        }
+        record.timestamp = slog::details::Clock::resolve(record.timestamp);
+        if (record.format_fn && record.level <= text_level) {
+            record.format_fn(record.format_str, record.args(), record.string_buffer,
+                             slog::fmt::FormatMode::MESSAGE);
         }
         _guard([&]()
         {
-            _formatter.format(record, record.message);
-            for (const std::shared_ptr<ISink>& sink : _sinks_vec) {
-                if (record.level <= sink->get_level()) {
-                    sink->log(record, _formatter.get_pattern());
+            _refresh_groups();
+            for (PatternGroup& group : _groups) {
+                group.rendered = false;
+            }
+            for (size_t i = 0; i < _sinks_vec.size(); i++) {
+                if (record.level > _sinks_vec[i]->get_level()) {
+                    continue;
+                }
+                if (_sinks_vec[i]->takes_records()) {
+                    _sinks_vec[i]->log(std::as_const(record));
+                }
+                else {
+                    _sinks_vec[i]->log(_render(_groups[_sink_groups[i]], record));
+                }
+            }
+        });
+    }
+
+    // Records of the same logger in push order, every sink gets them with a single call
+    void dispatch(std::span<slog::LogRecord* const> records)
+    {
+        slog::LogLevel text_level = slog::LogLevel::OFF;
+        slog::LogLevel level = _guard([&]() { return _most_verbose_level(text_level); });
+
+        for (slog::LogRecord* record : records) {
+            if (record->level <= level) {
+                record->timestamp = slog::details::Clock::resolve(record->timestamp);
+                if (record->format_fn && record->level <= text_level) {
+                    record->format_fn(record->format_str, record->args(), record->string_buffer,
+                                      slog::fmt::FormatMode::MESSAGE);
+                }
+            }
+        }
+        _guard([&]()
+        {
+            _refresh_groups();
+            for (PatternGroup& group : _groups) {
+                group.rendered = false;
+                group.level = slog::LogLevel::OFF;
+            }
+            // A group renders the records taken by any of its sinks, up to the level the messages
+            // were formatted for
+            for (size_t i = 0; i < _sinks_vec.size(); i++) {
+                PatternGroup& group = _groups[_sink_groups[i]];
+
+                if (!_sinks_vec[i]->takes_records()) {
+                    group.level = std::max(group.level, std::min(level, _sinks_vec[i]->get_level()));
+                }
+            }
+            for (size_t i = 0; i < _sinks_vec.size(); i++) {
+                PatternGroup& group = _groups[_sink_groups[i]];
+                slog::LogLevel sink_level = std::min(level, _sinks_vec[i]->get_level());
+
+                if (_sinks_vec[i]->takes_records()) {
+                    for (const slog::LogRecord* record : records) {
+                        if (record->level <= sink_level) {
+                            _sinks_vec[i]->log(*record);
+                        }
+                    }
+                    continue;
+                }
+                _render(group, records);
+                _batch.clear();
+                for (size_t r = 0; r < records.size(); r++) {
+                    if (records[r]->level <= sink_level) {
+                        _batch.push_back(group.views[r]);
+                    }
+                }
+                if (!_batch.empty()) {
+                    _sinks_vec[i]->log(_batch);
                 }
             }
         });
@@ -101,6 +184,7 @@ public:
         _guard([&]()
         {
             for (const std::shared_ptr<ISink>& sink : _sinks_vec) {
+                SLOG_LOCK(sink->_sink_mutex)
                 sink->flush();
             }
         });
@@ -147,6 +231,7 @@ public:
             for (auto it = _sinks_vec.begin(); it != _sinks_vec.end(); it++) {
                 if ((*it)->get_name() == name) {
                     _sinks_vec.erase(it);
+                    _groups_generation = STALE;
                     return;
                 }
             }
@@ -164,10 +249,140 @@ public:
         });
     }
 
+    template<slog::fmt::PatternString Pattern>
+    void set_pattern(slog::fmt::CompiledPattern<Pattern> pattern)
+    {
+        _guard([&]()
+        {
+            _formatter.set_pattern(pattern);
+            for (const std::shared_ptr<ISink>& sink : _sinks_vec) {
+                sink->set_pattern(pattern);
+            }
+        });
+    }
+
 private:
 
+    static constexpr uint64_t STALE = std::numeric_limits<uint64_t>::max();
+    static constexpr size_t MANAGER = std::numeric_limits<size_t>::max();
+
+    // Sinks with the same pattern, rendered once per record
+    struct PatternGroup
+    {
+        uint32_t pattern_id;
+        size_t sink;          // renders with the formatter of _sinks_vec[sink], MANAGER: _formatter
+        std::string message{}; // output of sink groups, the manager group writes record.message
+        std::vector<std::string_view> views{}; // batches, one per record
+        std::vector<size_t> ends{};
+        slog::LogLevel level{slog::LogLevel::OFF}; // batches, most verbose level of the sinks
+        bool rendered{false};
+    };
+
+    // `text_level` receives the most verbose level of the sinks taking text, the only ones
+    // needing the formatted message
+    [[nodiscard]] slog::LogLevel _most_verbose_level(slog::LogLevel& text_level) const noexcept
+    {
+        slog::LogLevel level = slog::LogLevel::OFF;
+
+        text_level = slog::LogLevel::OFF;
+        for (const std::shared_ptr<ISink>& sink : _sinks_vec) {
+            level = std::max(level, sink->get_level());
+            if (!sink->takes_records()) {
+                text_level = std::max(text_level, sink->get_level());
+            }
+        }
+        return level;
+    }
+
+    // Regroups the sinks by pattern when a sink was added or removed, or any pattern changed
+    // (sinks can be given a pattern directly)
+    void _refresh_groups()
+    {
+        uint64_t generation = slog::fmt::PatternFormatter::pattern_generation();
+
+        if (generation == _groups_generation) [[likely]] {
+            return;
+        }
+        _groups.clear();
+        _sink_groups.clear();
+        _groups.push_back(PatternGroup{_formatter.get_pattern_id(), MANAGER});
+        for (size_t i = 0; i < _sinks_vec.size(); i++) {
+            uint32_t pattern_id = _sinks_vec[i]->get_pattern_id();
+            size_t group = 0;
+
+            while (group < _groups.size() && _groups[group].pattern_id != pattern_id) {
+                group++;
+            }
+            if (group == _groups.size()) {
+                _groups.push_back(PatternGroup{pattern_id, i});
+            }
+            _sink_groups.push_back(static_cast<uint32_t>(group));
+        }
+        _groups_generation = generation;
+    }
+
+    void _format(const PatternGroup& group, const slog::LogRecord& record, std::string& dest) const
+    {
+        if (group.sink == MANAGER) {
+            _formatter.format(record, dest);
+        }
+        else {
+            _sinks_vec[group.sink]->format(record, dest);
+        }
+    }
+
+    std::string_view _render(PatternGroup& group, slog::LogRecord& record)
+    {
+        std::string& dest = group.sink == MANAGER ? record.message : group.message;
+
+        if (!group.rendered) {
+            // Workers may reuse the same record
+            dest.clear();
+            _format(group, record, dest);
+            group.rendered = true;
+        }
+        return dest;
+    }
+
+    // Renders the records of the group level into `group.views`, empty for the others
+    void _render(PatternGroup& group, std::span<slog::LogRecord* const> records)
+    {
+        if (group.rendered) {
+            return;
+        }
+        group.views.assign(records.size(), std::string_view{});
+        if (group.sink == MANAGER) {
+            for (size_t r = 0; r < records.size(); r++) {
+                if (records[r]->level <= group.level) {
+                    records[r]->message.clear();
+                    _format(group, *records[r], records[r]->message);
+                    group.views[r] = records[r]->message;
+                }
+            }
+        }
+        else {
+            // Messages are rendered back to back, views are taken once `message` stops growing
+            group.message.clear();
+            group.ends.clear();
+            for (const slog::LogRecord* record : records) {
+                if (record->level <= group.level) {
+                    _format(group, *record, group.message);
+                }
+                group.ends.push_back(group.message.size());
+            }
+            for (size_t r = 0, begin = 0; r < records.size(); begin = group.ends[r++]) {
+                group.views[r] = {group.message.data() + begin, group.ends[r] - begin};
+            }
+        }
+        group.rendered = true;
+    }
+
     slog::fmt::PatternFormatter _formatter;
     std::vector<std::shared_ptr<ISink>> _sinks_vec;
+    std::vector<PatternGroup> _groups;   // the manager pattern first
+    std::vector<uint32_t> _sink_groups;  // group of _sinks_vec[i]
+    std::vector<std::string_view> _batch;
+    uint64_t _groups_generation{STALE};
     mutable std::atomic_flag _flag;
 };
 
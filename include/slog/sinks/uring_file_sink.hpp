@@ -0,0 +1,433 @@
+#ifndef SLOG_SINKS_URING_FILE_SINK_HPP
+#define SLOG_SINKS_URING_FILE_SINK_HPP
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+    #define SLOG_HAS_IO_URING
+    #include <linux/io_uring.h>
+    #include <sys/syscall.h>
+#endif
+
+#include <slog/config_macros.hpp>
+#include <slog/details/macros.hpp>
+#include <slog/sinks/isink.hpp>
+
+namespace slog::sinks
+{
+
+struct UringFileOptions
+{
+    size_t chunk_size{size_t{1} << 20}; // bytes submitted by a single write
+    size_t chunks{4};                   // 2 to 64, all but the one being filled can be in flight
+    bool append{false};
+    bool io_uring{true}; // false always uses the blocking fallback
+};
+
+enum class WriteBackend : uint8_t
+{
+    IO_URING_FIXED, // io_uring writes from the registered chunks
+    IO_URING,       // io_uring, registering the chunks failed (e.g. RLIMIT_MEMLOCK)
+    PWRITE          // blocking pwrite of every full chunk, without io_uring
+};
+
+[[nodiscard]] constexpr std::string_view to_string(WriteBackend backend) noexcept
+{
+    switch (backend) {
+    case WriteBackend::IO_URING_FIXED: return "io_uring (registered buffers)";
+    case WriteBackend::IO_URING: return "io_uring";
+    case WriteBackend::PWRITE: return "pwrite";
+    }
+    return "unknown";
+}
+
+// Copies messages into chunks and submits every full chunk as one io_uring write, the writer
+// moves to the next chunk without waiting for it. Completions are reaped (without syscall)
+// whenever a chunk is submitted, the writer only waits when every other chunk is still in
+// flight. flush() submits the partially filled chunk and returns without waiting for it, the
+// first write submitted after it only starts once every write before completed: the file
+// never holds data logged after a flush without the data flushed. Without io_uring (other
+// systems, older kernels, io_uring disabled or filtered) chunks are written with a blocking
+// pwrite.
+class SLOG_API UringFileSink : public ISink
+{
+public:
+    UringFileSink(const std::string_view sink_name, const std::string_view file_name,
+                  UringFileOptions options = {})
+        : ISink(sink_name, false, true), _file_name(file_name),
+          _chunk_size(std::max<size_t>(options.chunk_size, 4096)), _chunks(std::clamp<size_t>(options.chunks, 2, 64))
+    {
+        int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (options.append ? 0 : O_TRUNC);
+
+        _fd = ::open(_file_name.c_str(), flags, 0644);
+        if (_fd < 0) {
+            throw std::runtime_error("Failed to open log file.");
+        }
+        if (options.append) {
+            struct stat st{};
+
+            if (::fstat(_fd, &st) != 0) {
+                ::close(_fd);
+                throw std::runtime_error("Failed to stat log file.");
+            }
+            _offset = static_cast<uint64_t>(st.st_size);
+        }
+
+        void* memory = ::mmap(nullptr, _chunk_size * _chunks.size(), PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (memory == MAP_FAILED) {
+            ::close(_fd);
+            throw std::runtime_error("Failed to allocate the log chunks.");
+        }
+        for (size_t i = 0; i < _chunks.size(); i++) {
+            _chunks[i].data = static_cast<char*>(memory) + i * _chunk_size;
+        }
+#ifdef SLOG_HAS_IO_URING
+        if (options.io_uring) {
+            _setup_ring();
+        }
+#endif
+    }
+
+    UringFileSink(const UringFileSink&) = delete;
+    UringFileSink(UringFileSink&&) = delete;
+
+    ~UringFileSink() override
+    {
+        _submit_current();
+        for (Chunk& chunk : _chunks) {
+            while (chunk.in_flight) {
+                _wait_completion();
+            }
+        }
+#ifdef SLOG_HAS_IO_URING
+        if (_ring_fd >= 0) {
+            ::munmap(_sqes, _sqes_size);
+            ::munmap(_cq_ring, _cq_ring_size);
+            if (_sq_ring != _cq_ring) {
+                ::munmap(_sq_ring, _sq_ring_size);
+            }
+            ::close(_ring_fd);
+        }
+#endif
+        ::munmap(_chunks[0].data, _chunk_size * _chunks.size());
+        ::close(_fd);
+    }
+
+    UringFileSink& operator=(const UringFileSink&) = delete;
+
+    // Submitting moves `_fill` and `_offset` and reaps the chunks, hence the locked writes
+    void flush() override
+    {
+        _submit_current();
+        _drain_next = true;
+    }
+
+    [[nodiscard]] std::string get_file_name() const { return _file_name; }
+
+    [[nodiscard]] WriteBackend get_backend() const noexcept { return _backend; }
+
+    // Bytes of the writes that failed, they are dropped
+    [[nodiscard]] uint64_t get_lost_bytes() const noexcept
+    {
+        return _lost_bytes.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Chunk
+    {
+        char* data{nullptr};
+        size_t used{0};
+        size_t done{0};      // bytes already written, a short write is resubmitted for the rest
+        uint64_t offset{0};  // in the file
+        bool in_flight{false};
+    };
+
+    void _write(std::string_view message) override
+    {
+        while (!message.empty()) {
+            Chunk& chunk = _chunks[_fill];
+            size_t size = std::min(message.size(), _chunk_size - chunk.used);
+
+            std::memcpy(chunk.data + chunk.used, message.data(), size);
+            chunk.used += size;
+            message.remove_prefix(size);
+            if (chunk.used == _chunk_size) [[unlikely]] {
+                _submit_current();
+            }
+        }
+    }
+
+    // Hands the chunk being filled to the kernel and makes sure the next one is free
+    void _submit_current()
+    {
+        Chunk& chunk = _chunks[_fill];
+
+        if (chunk.used == 0) {
+            return;
+        }
+        chunk.offset = _offset;
+        chunk.done = 0;
+        _offset += chunk.used;
+        _submit(_fill, std::exchange(_drain_next, false));
+        _fill = (_fill + 1) % _chunks.size();
+        _reap();
+        while (_chunks[_fill].in_flight) {
+            _wait_completion();
+        }
+    }
+
+    // A `drain` write starts once the writes submitted before completed
+    void _submit(size_t index, bool drain = false)
+    {
+        Chunk& chunk = _chunks[index];
+
+#ifdef SLOG_HAS_IO_URING
+        if (_backend != WriteBackend::PWRITE) {
+            chunk.in_flight = true;
+            _push(index, drain);
+            return;
+        }
+#endif
+        while (chunk.done < chunk.used) {
+            ssize_t written = ::pwrite(_fd, chunk.data + chunk.done, chunk.used - chunk.done,
+                                       static_cast<off_t>(chunk.offset + chunk.done));
+
+            if (written < 0 && errno == EINTR) {
+                continue;
+            }
+            if (written <= 0) {
+                _lost_bytes.fetch_add(chunk.used - chunk.done, std::memory_order_relaxed);
+                break;
+            }
+            chunk.done += static_cast<size_t>(written);
+        }
+        chunk.used = 0;
+    }
+
+#ifdef SLOG_HAS_IO_URING
+    void _setup_ring()
+    {
+        io_uring_params params{};
+        auto entries = static_cast<unsigned>(_chunks.size());
+
+        _ring_fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (_ring_fd < 0) {
+            return;
+        }
+
+        _sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        _cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        if (params.features & IORING_FEAT_SINGLE_MMAP) {
+            _sq_ring_size = _cq_ring_size = std::max(_sq_ring_size, _cq_ring_size);
+        }
+        _sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+
+        void* sq_ring = ::mmap(nullptr, _sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                               _ring_fd, IORING_OFF_SQ_RING);
+        void* cq_ring = sq_ring;
+
+        if (sq_ring != MAP_FAILED && !(params.features & IORING_FEAT_SINGLE_MMAP)) {
+            cq_ring = ::mmap(nullptr, _cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                             _ring_fd, IORING_OFF_CQ_RING);
+        }
+
+        void* sqes = ::mmap(nullptr, _sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd,
+                            IORING_OFF_SQES);
+
+        if (sq_ring == MAP_FAILED || cq_ring == MAP_FAILED || sqes == MAP_FAILED) {
+            for (auto [ring, size] : {std::pair{sq_ring, _sq_ring_size}, std::pair{sqes, _sqes_size}}) {
+                if (ring != MAP_FAILED) {
+                    ::munmap(ring, size);
+                }
+            }
+            if (cq_ring != MAP_FAILED && cq_ring != sq_ring) {
+                ::munmap(cq_ring, _cq_ring_size);
+            }
+            ::close(_ring_fd);
+            _ring_fd = -1;
+            return;
+        }
+
+        auto* sq = static_cast<char*>(sq_ring);
+        auto* cq = static_cast<char*>(cq_ring);
+
+        _sq_ring = sq_ring;
+        _cq_ring = cq_ring;
+        _sqes = static_cast<io_uring_sqe*>(sqes);
+        _sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        _sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        _sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        _sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        _cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        _cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        _cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        _cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        // Registered chunks aren't mapped by the kernel again for every write
+        std::vector<iovec> buffers(_chunks.size());
+
+        for (size_t i = 0; i < _chunks.size(); i++) {
+            buffers[i] = iovec{_chunks[i].data, _chunk_size};
+        }
+        _backend = ::syscall(__NR_io_uring_register, _ring_fd, IORING_REGISTER_BUFFERS, buffers.data(),
+                             static_cast<unsigned>(buffers.size())) == 0
+                       ? WriteBackend::IO_URING_FIXED
+                       : WriteBackend::IO_URING;
+    }
+
+    // Queues the rest of the chunk and submits it. There is a submission entry per chunk and
+    // every chunk has a single write in flight, the submission queue can't be full. When the
+    // ring fails (e.g. the kernel dropped it), the entry is taken back and the sink moves to
+    // pwrite, starting with this chunk.
+    void _push(size_t index, bool drain = false)
+    {
+        Chunk& chunk = _chunks[index];
+        unsigned tail = *_sq_tail;
+        unsigned slot = tail & _sq_mask;
+        io_uring_sqe& sqe = _sqes[slot];
+
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = _backend == WriteBackend::IO_URING_FIXED ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+        sqe.flags = drain ? IOSQE_IO_DRAIN : 0;
+        sqe.fd = _fd;
+        sqe.addr = reinterpret_cast<uint64_t>(chunk.data + chunk.done);
+        sqe.len = static_cast<uint32_t>(chunk.used - chunk.done);
+        sqe.off = chunk.offset + chunk.done;
+        sqe.buf_index = static_cast<uint16_t>(index);
+        sqe.user_data = index;
+        _sq_array[slot] = slot;
+        std::atomic_ref<unsigned>(*_sq_tail).store(tail + 1, std::memory_order_release);
+
+        while (::syscall(__NR_io_uring_enter, _ring_fd, 1, 0, 0, nullptr, 0) < 0) {
+            if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+                _reap();
+                continue;
+            }
+            // Consumed entries complete with their error, the others would never be submitted
+            if (std::atomic_ref<unsigned>(*_sq_head).load(std::memory_order_acquire) == tail) {
+                std::atomic_ref<unsigned>(*_sq_tail).store(tail, std::memory_order_release);
+                _backend = WriteBackend::PWRITE;
+                chunk.in_flight = false;
+                _submit(index);
+            }
+            break;
+        }
+    }
+
+    // Handles the completions already posted, without syscall. The writes to finish are pushed
+    // once every completion read is consumed: pushing reaps again.
+    void _reap()
+    {
+        if (_ring_fd < 0) {
+            return;
+        }
+
+        unsigned head = *_cq_head;
+        unsigned tail = std::atomic_ref<unsigned>(*_cq_tail).load(std::memory_order_acquire);
+        uint64_t resubmit = 0; // chunk bits, a chunk has a single write in flight
+
+        while (head != tail) {
+            const io_uring_cqe& cqe = _cqes[head & _cq_mask];
+            Chunk& chunk = _chunks[cqe.user_data];
+            int result = cqe.res;
+
+            std::atomic_ref<unsigned>(*_cq_head).store(++head, std::memory_order_release);
+            if (result == -EINTR || result == -EAGAIN) {
+                resubmit |= uint64_t{1} << cqe.user_data;
+                continue;
+            }
+            // Write opcodes unknown to the kernel (before 5.6)
+            if (result == -EINVAL || result == -EOPNOTSUPP) {
+                _backend = WriteBackend::PWRITE;
+                chunk.in_flight = false;
+                _submit(cqe.user_data);
+                continue;
+            }
+            if (result > 0) {
+                chunk.done += static_cast<size_t>(result);
+                if (chunk.done < chunk.used) {
+                    resubmit |= uint64_t{1} << cqe.user_data;
+                    continue;
+                }
+            } else {
+                _lost_bytes.fetch_add(chunk.used - chunk.done, std::memory_order_relaxed);
+            }
+            chunk.used = 0;
+            chunk.in_flight = false;
+        }
+        for (size_t index = 0; resubmit; index++, resubmit >>= 1) {
+            if (!(resubmit & 1)) {
+                continue;
+            }
+            if (_backend == WriteBackend::PWRITE) {
+                _chunks[index].in_flight = false;
+                _submit(index);
+            } else {
+                _push(index);
+            }
+        }
+    }
+#endif
+
+    void _wait_completion()
+    {
+#ifdef SLOG_HAS_IO_URING
+        ::syscall(__NR_io_uring_enter, _ring_fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+        _reap();
+#endif
+    }
+
+    std::string _file_name;
+    int _fd{-1};
+    size_t _chunk_size;
+    std::vector<Chunk> _chunks;
+    size_t _fill{0}; // chunk being filled
+    uint64_t _offset{0};
+    std::atomic<uint64_t> _lost_bytes{0};
+    WriteBackend _backend{WriteBackend::PWRITE};
+    bool _drain_next{false}; // the next chunk submitted follows a flush
+
+#ifdef SLOG_HAS_IO_URING
+    int _ring_fd{-1};
+    void* _sq_ring{nullptr};
+    void* _cq_ring{nullptr};
+    size_t _sq_ring_size{0};
+    size_t _cq_ring_size{0};
+    size_t _sqes_size{0};
+    io_uring_sqe* _sqes{nullptr};
+    unsigned* _sq_head{nullptr};
+    unsigned* _sq_tail{nullptr};
+    unsigned* _sq_array{nullptr};
+    unsigned _sq_mask{0};
+    unsigned* _cq_head{nullptr};
+    unsigned* _cq_tail{nullptr};
+    unsigned _cq_mask{0};
+    io_uring_cqe* _cqes{nullptr};
+#endif
+};
+
+} // namespace slog::sinks
+
+#endif
+
+#endif // SLOG_SINKS_URING_FILE_SINK_HPP
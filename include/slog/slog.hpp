@@ -5,6 +5,7 @@
 #include <slog/core/log_proxy.hpp>
 #include <slog/core/logger.hpp>
 #include <slog/core/registry.hpp>
+#include <slog/details/cached_logger.hpp>
 #include <slog/details/deref.hpp>
 
 #ifdef SLOG_HEADER_ONLY
@@ -16,7 +17,12 @@
 
 #define SLOG_REGISTRY slog::Registry::instance()
 #define SLOG_DEFAULT_LOGGER SLOG_REGISTRY.get_default_logger()
-#define SLOG_GET_LOGGER(name) SLOG_REGISTRY.get_logger(name)
+// Each call site caches its lookup, constant names then cost a single load
+#define SLOG_GET_LOGGER(name)                                                                     \
+    ([](auto&& logger_name) -> slog::Logger& {                                                    \
+        static constinit slog::details::CachedLogger cache;                                       \
+        return cache.get(logger_name);                                                            \
+    }(name))
 
 // ---------------------------------
 // Logging macros for Default Logger
@@ -68,6 +74,6 @@
 #endif
 
 #define SLOG_IS_OFF(lvl, logger)                                                                  \
-    (lvl > SLOG_REGISTRY.get_log_level()) || (lvl > slog::details::deref(logger).get_log_level())
+    (lvl > slog::Registry::get_log_level()) || (lvl > slog::details::deref(logger).get_log_level())
 
 #endif // SLOG_HPP
@@ -9,4 +9,20 @@
     #include <slog/sinks/file_sink.hpp>
 #endif
 
+#ifndef SLOG_BINARY_FILE_SINK_DISABLED
+    #include <slog/sinks/binary_file_sink.hpp>
+#endif
+
+#ifndef SLOG_MMAP_FILE_SINK_DISABLED
+    #include <slog/sinks/mmap_file_sink.hpp>
+#endif
+
+#ifndef SLOG_ROTATING_FILE_SINK_DISABLED
+    #include <slog/sinks/rotating_file_sink.hpp>
+#endif
+
+#ifndef SLOG_URING_FILE_SINK_DISABLED
+    #include <slog/sinks/uring_file_sink.hpp>
+#endif
+
 #include <slog/slog.hpp>
@@ -1,10 +1,15 @@
+#include <atomic>
+#include <chrono>
+#include <ctime>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <thread>
 #include <vector>
 
 #include <gtest/gtest.h>
 
+#include <slog/details/time.hpp>
 #include <slog/slog.hpp>
 
 #include "async_vector_sink.hpp"
@@ -110,3 +115,107 @@ TEST_F(AsyncTest, Concurrency)
     // Clear for reuse
     sink_a->clear();
 }
+
+TEST_F(AsyncTest, WallClockTimestamp)
+{
+    // Whatever the clock, the flags print wall clock time (coarse clocks may lag a few ms)
+    auto render = [](std::chrono::system_clock::time_point tp) {
+        std::time_t tt = std::chrono::system_clock::to_time_t(tp);
+        std::tm local{};
+        slog::details::localtime(&tt, &local);
+
+        return std::format("{:04d}-{:02d}-{:02d} {:02d}:{:02d}:{:02d}", local.tm_year + 1900,
+                           local.tm_mon + 1, local.tm_mday, local.tm_hour, local.tm_min,
+                           local.tm_sec);
+    };
+
+    sink_a->set_pattern("%Y-%m-%d %H:%M:%S");
+
+    auto before = std::chrono::system_clock::now() - std::chrono::milliseconds(20);
+    logger_a->info("now");
+    auto after = std::chrono::system_clock::now();
+
+    ASSERT_TRUE(sink_a->wait_for(1));
+
+    std::string stamp = sink_a->get(0);
+    EXPECT_TRUE(stamp == render(before) || stamp == render(after)) << stamp;
+
+    // Clear for reuse
+    sink_a->clear();
+}
+
+TEST_F(AsyncTest, ThreadNameFlag)
+{
+    sink_a->set_pattern("%N %v");
+
+    std::thread([this]() {
+        slog::set_thread_name("producer-1");
+        logger_a->info("named");
+    }).join();
+
+    ASSERT_TRUE(sink_a->wait_for(1));
+    EXPECT_EQ(sink_a->get(0), "producer-1 named");
+
+    // Clear for reuse
+    sink_a->clear();
+}
+
+namespace
+{
+
+// Counts the flushes that ran while a write was in progress
+class FlushRaceSink : public slog::sinks::ISink
+{
+public:
+    FlushRaceSink() : ISink("flush_race", false, true) {}
+
+    void flush() override
+    {
+        if (_busy.load()) {
+            _overlaps++;
+        }
+    }
+
+    [[nodiscard]] size_t writes() const noexcept { return _writes.load(); }
+
+    [[nodiscard]] size_t overlaps() const noexcept { return _overlaps.load(); }
+
+private:
+    void _write(std::string_view) override
+    {
+        _busy.store(true);
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+        _busy.store(false);
+        _writes++;
+    }
+
+    std::atomic<bool> _busy{false};
+    std::atomic<size_t> _writes{0};
+    std::atomic<size_t> _overlaps{0};
+};
+
+} // namespace
+
+TEST(AsyncFlushTest, FlushIsSerializedWithTheWorker)
+{
+    constexpr size_t count = 200;
+    auto writer = slog::Registry::instance().create_logger("async_flush_race_writer");
+    auto flusher = slog::Registry::instance().create_logger("async_flush_race_flusher");
+    auto sink = std::make_shared<FlushRaceSink>();
+
+    // The sink managers only serialize a flush with the writes of their own logger
+    writer->add_sink(sink);
+    flusher->add_sink(sink);
+    for (size_t i = 0; i < count; i++) {
+        writer->info("record {}", i);
+    }
+
+    // Flushes while the worker writes, each write sleeps so that flushes land in the middle
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+    while (sink->writes() < count && std::chrono::steady_clock::now() < deadline) {
+        flusher->flush();
+    }
+    EXPECT_EQ(sink->writes(), count);
+    EXPECT_EQ(sink->overlaps(), 0u);
+}
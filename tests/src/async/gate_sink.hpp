@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <slog/sinks/isink.hpp>
+
+namespace slog::tests
+{
+
+// Holds the worker inside the first write until released, the queue then fills up
+class GateSink : public slog::sinks::ISink
+{
+public:
+    GateSink() : ISink("gate") {}
+
+    void flush() override {}
+
+    bool wait_entered()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _cv.wait_for(lock, std::chrono::seconds(2), [this] { return _entered; });
+    }
+
+    void release()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _released = true;
+        _cv.notify_all();
+    }
+
+    bool wait_for(const std::string& message)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _cv.wait_for(lock, std::chrono::seconds(2), [&] {
+            return std::find(_messages.begin(), _messages.end(), message) != _messages.end();
+        });
+    }
+
+    std::vector<std::string> messages()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _messages;
+    }
+
+private:
+    void _write(std::string_view message) override
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        _entered = true;
+        _cv.notify_all();
+        // Bounded, a failed test must not leave the worker stuck
+        _cv.wait_for(lock, std::chrono::seconds(10), [this] { return _released; });
+        _messages.emplace_back(message);
+        _cv.notify_all();
+    }
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    bool _entered{false};
+    bool _released{false};
+    std::vector<std::string> _messages;
+};
+
+} // namespace slog::tests
@@ -0,0 +1,201 @@
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <slog/async/manager_table.hpp>
+#include <slog/slog.hpp>
+
+#include "async_vector_sink.hpp"
+
+namespace
+{
+
+bool wait_expired(const std::weak_ptr<slog::sinks::SinkManager>& manager)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+
+    while (!manager.expired()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+slog::async::AsyncOp make_op(slog::async::ManagerHandle handle, uint32_t value)
+{
+    slog::LogRecord record;
+
+    record.level = slog::LogLevel::INFO;
+    record.thread_id = 0;
+    record.format_str = "msg {}";
+    record.format_fn = &slog::fmt::format_deferred<uint32_t>;
+    slog::fmt::store_args<uint32_t>(record.stored_args, value);
+    return slog::async::AsyncOp{std::move(record), handle};
+}
+
+// Pushes a new record for every record written until stopped: the queue is never empty
+class RelaySink : public slog::sinks::ISink
+{
+public:
+    explicit RelaySink(slog::async::Worker& worker) : ISink("relay"), _worker(worker) {}
+
+    void flush() override {}
+
+    void start(slog::async::ManagerHandle handle)
+    {
+        _handle = handle;
+        _worker.push(make_op(_handle, 0));
+    }
+
+    void stop() { _running.store(false, std::memory_order_relaxed); }
+
+private:
+    void _write(std::string_view) override
+    {
+        if (_running.load(std::memory_order_relaxed)) {
+            _worker.push(make_op(_handle, 0));
+        }
+    }
+
+    slog::async::Worker& _worker;
+    slog::async::ManagerHandle _handle{0};
+    std::atomic<bool> _running{true};
+};
+
+} // namespace
+
+TEST(ManagerTableTest, GetResolvesAttachedManager)
+{
+    slog::async::ManagerTable table;
+    auto first = std::make_shared<slog::sinks::SinkManager>();
+    auto second = std::make_shared<slog::sinks::SinkManager>();
+
+    auto first_handle = table.attach(first);
+    auto second_handle = table.attach(second);
+
+    EXPECT_NE(first_handle, second_handle);
+    EXPECT_EQ(table.get(first_handle), first.get());
+    EXPECT_EQ(table.get(second_handle), second.get());
+}
+
+TEST(ManagerTableTest, ReclaimOnlyReleasesRetiredUpToEpoch)
+{
+    slog::async::ManagerTable table;
+    auto first = std::make_shared<slog::sinks::SinkManager>();
+    auto second = std::make_shared<slog::sinks::SinkManager>();
+    std::weak_ptr<slog::sinks::SinkManager> first_weak = first;
+    std::weak_ptr<slog::sinks::SinkManager> second_weak = second;
+
+    auto first_handle = table.attach(std::move(first));
+    auto second_handle = table.attach(std::move(second));
+
+    table.detach(first_handle);
+    uint64_t epoch = table.epoch();
+    table.detach(second_handle);
+
+    // Detached managers stay alive until reclaimed
+    EXPECT_FALSE(first_weak.expired());
+    EXPECT_TRUE(table.has_retired());
+
+    table.reclaim(epoch);
+    EXPECT_TRUE(first_weak.expired());
+    EXPECT_FALSE(second_weak.expired());
+    EXPECT_TRUE(table.has_retired());
+
+    table.reclaim(table.epoch());
+    EXPECT_TRUE(second_weak.expired());
+    EXPECT_FALSE(table.has_retired());
+}
+
+TEST(ManagerTableTest, FullTableThrowsUntilReclaimed)
+{
+    slog::async::ManagerTable table;
+    std::vector<slog::async::ManagerHandle> handles;
+
+    for (size_t i = 0; i < slog::async::ManagerTable::CAPACITY; i++) {
+        handles.push_back(table.attach(std::make_shared<slog::sinks::SinkManager>()));
+    }
+    EXPECT_THROW((void)table.attach(std::make_shared<slog::sinks::SinkManager>()),
+                 std::runtime_error);
+
+    table.detach(handles.back());
+    EXPECT_THROW((void)table.attach(std::make_shared<slog::sinks::SinkManager>()),
+                 std::runtime_error);
+
+    table.reclaim(table.epoch());
+    EXPECT_EQ(table.attach(std::make_shared<slog::sinks::SinkManager>()), handles.back());
+}
+
+TEST(ManagerTableTest, WorkerDispatchesQueuedRecordsOfDetachedManager)
+{
+    constexpr uint32_t message_count = 100;
+    slog::async::Worker worker;
+    auto sink = std::make_shared<slog::tests::AsyncVectorSink>("sink");
+    auto manager = std::make_shared<slog::sinks::SinkManager>(sink);
+    std::weak_ptr<slog::sinks::SinkManager> weak = manager;
+
+    manager->set_pattern("%v");
+    auto handle = worker.attach(std::move(manager));
+
+    for (uint32_t i = 0; i < message_count; i++) {
+        slog::LogRecord record;
+
+        record.level = slog::LogLevel::INFO;
+        record.thread_id = 0;
+        record.format_str = "msg {}";
+        record.format_fn = &slog::fmt::format_deferred<uint32_t>;
+        slog::fmt::store_args<uint32_t>(record.stored_args, i);
+        worker.push(slog::async::AsyncOp{std::move(record), handle});
+    }
+    worker.detach(handle);
+
+    ASSERT_TRUE(sink->wait_for(message_count));
+    ASSERT_TRUE(wait_expired(weak));
+    for (uint32_t i = 0; i < message_count; i++) {
+        EXPECT_EQ(sink->get(i), std::format("msg {}", i));
+    }
+}
+
+TEST(ManagerTableTest, WorkerReclaimsDetachedManagersWhileQueueStaysBusy)
+{
+    slog::async::Worker worker;
+    auto relay = std::make_shared<RelaySink>(worker);
+    auto manager = std::make_shared<slog::sinks::SinkManager>(relay);
+    size_t failed = 0;
+
+    manager->set_pattern("%v");
+    worker.set_idle_strategy(slog::async::IdleStrategy::backoff());
+    relay->start(worker.attach(std::move(manager)));
+
+    // More loggers than the table holds: a full table waits for the worker to reclaim the
+    // detached ones, which it must do without ever seeing its queue empty
+    for (uint32_t i = 0; i < 2 * slog::async::ManagerTable::CAPACITY && failed == 0; i++) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+
+        while (true) {
+            try {
+                auto handle = worker.attach(std::make_shared<slog::sinks::SinkManager>());
+
+                worker.push(make_op(handle, i));
+                worker.detach(handle);
+                break;
+            }
+            catch (const std::runtime_error&) {
+                if (std::chrono::steady_clock::now() > deadline) {
+                    failed++;
+                    break;
+                }
+                std::this_thread::yield();
+            }
+        }
+    }
+    relay->stop();
+    EXPECT_EQ(failed, 0u);
+}
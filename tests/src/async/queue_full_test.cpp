@@ -0,0 +1,150 @@
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <slog/async/worker.hpp>
+#include <slog/slog.hpp>
+
+#include "gate_sink.hpp"
+
+namespace
+{
+
+slog::async::AsyncOp make_op(slog::async::ManagerHandle handle, uint32_t i,
+                             slog::LogLevel level = slog::LogLevel::INFO)
+{
+    slog::LogRecord record;
+
+    record.level = level;
+    record.thread_id = 0;
+    record.format_str = "msg {}";
+    record.format_fn = &slog::fmt::format_deferred<uint32_t>;
+    slog::fmt::store_args<uint32_t>(record.stored_args, i);
+    return slog::async::AsyncOp{std::move(record), handle};
+}
+
+struct Fixture
+{
+    Fixture()
+    {
+        manager->set_pattern("[%l] %v");
+        handle = worker.attach(manager, "queue_full");
+    }
+
+    // The worker drains its queue when destroyed
+    ~Fixture() { sink->release(); }
+
+    // Blocks the worker on its first record
+    void hold_worker()
+    {
+        worker.push(make_op(handle, 0));
+        ASSERT_TRUE(sink->wait_entered());
+    }
+
+    std::shared_ptr<slog::tests::GateSink> sink = std::make_shared<slog::tests::GateSink>();
+    std::shared_ptr<slog::sinks::SinkManager> manager = std::make_shared<slog::sinks::SinkManager>(sink);
+    slog::async::Worker worker;
+    slog::async::ManagerHandle handle{0};
+};
+
+constexpr uint32_t MAX_PUSHES = 1u << 22;
+
+} // namespace
+
+TEST(QueueFullTest, DiscardCountsAndReportsDrops)
+{
+    Fixture f;
+    uint32_t failures = 0;
+
+    f.worker.set_queue_full_policy(slog::async::QueueFullPolicy::discard());
+    f.hold_worker();
+    for (uint32_t i = 1; i < MAX_PUSHES && failures < 10; i++) {
+        failures += f.worker.push(make_op(f.handle, i)) ? 0 : 1;
+    }
+    ASSERT_EQ(failures, 10u);
+    EXPECT_EQ(f.worker.dropped(), 10u);
+
+    f.sink->release();
+    EXPECT_TRUE(f.sink->wait_for("[WARNING] 10 messages dropped"));
+    EXPECT_EQ(f.sink->messages().front(), "[INFO] msg 0");
+}
+
+TEST(QueueFullTest, DropByLevelKeepsSevereRecords)
+{
+    Fixture f;
+    uint32_t pushed = 1;
+
+    f.worker.set_queue_full_policy(
+        slog::async::QueueFullPolicy::drop_by_level(slog::LogLevel::WARNING, 0.5));
+    f.hold_worker();
+    // Past the watermark DEBUG records are shed while the queue still has room
+    while (pushed < MAX_PUSHES && f.worker.push(make_op(f.handle, pushed, slog::LogLevel::DEBUG))) {
+        pushed++;
+    }
+    EXPECT_TRUE(f.worker.push(make_op(f.handle, pushed, slog::LogLevel::ERROR)));
+    EXPECT_FALSE(f.worker.push(make_op(f.handle, pushed + 1, slog::LogLevel::INFO)));
+    EXPECT_EQ(f.worker.dropped(), 2u);
+
+    f.sink->release();
+    EXPECT_TRUE(f.sink->wait_for("[ERROR] msg " + std::to_string(pushed)));
+    EXPECT_TRUE(f.sink->wait_for("[WARNING] 2 messages dropped"));
+}
+
+TEST(QueueFullTest, WaitGivesUpAfterTimeout)
+{
+    constexpr auto timeout = std::chrono::milliseconds(5);
+    Fixture f;
+    bool pushed = true;
+    auto elapsed = std::chrono::steady_clock::duration::zero();
+
+    f.worker.set_queue_full_policy(slog::async::QueueFullPolicy::wait_for(timeout));
+    f.hold_worker();
+    for (uint32_t i = 1; i < MAX_PUSHES && pushed; i++) {
+        auto start = std::chrono::steady_clock::now();
+
+        pushed = f.worker.push(make_op(f.handle, i));
+        elapsed = std::chrono::steady_clock::now() - start;
+    }
+    EXPECT_FALSE(pushed);
+    EXPECT_GE(elapsed, timeout);
+    EXPECT_EQ(f.worker.dropped(), 1u);
+
+    f.sink->release();
+    EXPECT_TRUE(f.sink->wait_for("[WARNING] 1 message dropped"));
+}
+
+#if !defined(SLOG_ASYNC_BYTE_QUEUE) && !defined(SLOG_ASYNC_THREAD_QUEUES)
+TEST(QueueFullTest, DropOldestKeepsNewestRecords)
+{
+    constexpr uint32_t overflow = 10;
+    constexpr uint32_t count = SLOG_MPSC_QUEUE_SIZE + overflow;
+    Fixture f;
+
+    f.worker.set_queue_full_policy(slog::async::QueueFullPolicy::drop_oldest());
+    f.hold_worker();
+    for (uint32_t i = 1; i <= count; i++) {
+        EXPECT_TRUE(f.worker.push(make_op(f.handle, i)));
+    }
+    EXPECT_EQ(f.worker.dropped(), overflow);
+
+    f.sink->release();
+    ASSERT_TRUE(f.sink->wait_for("[WARNING] 10 messages dropped"));
+
+    EXPECT_TRUE(f.sink->wait_for("[INFO] msg " + std::to_string(count)));
+
+    std::vector<std::string> records;
+
+    for (const std::string& message : f.sink->messages()) {
+        if (message.starts_with("[INFO]")) {
+            records.push_back(message);
+        }
+    }
+    ASSERT_EQ(records.size(), count + 1 - overflow);
+    EXPECT_EQ(records[0], "[INFO] msg 0");
+    EXPECT_EQ(records[1], "[INFO] msg " + std::to_string(overflow + 1));
+}
+#endif
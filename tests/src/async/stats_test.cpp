@@ -0,0 +1,167 @@
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <slog/async/worker.hpp>
+#include <slog/slog.hpp>
+
+#include "async_vector_sink.hpp"
+#include "gate_sink.hpp"
+#include "wait_dispatched.hpp"
+
+namespace
+{
+
+slog::async::AsyncOp make_op(slog::async::ManagerHandle handle)
+{
+    slog::LogRecord record;
+
+    record.level = slog::LogLevel::INFO;
+    record.thread_id = 0;
+    record.format_str = "msg";
+    return slog::async::AsyncOp{std::move(record), handle};
+}
+
+} // namespace
+
+TEST(WorkerStatsTest, CountsRecordsAndWakeups)
+{
+    constexpr uint64_t count = 100;
+    auto sink = std::make_shared<slog::tests::AsyncVectorSink>("sink");
+    auto manager = std::make_shared<slog::sinks::SinkManager>(sink);
+    slog::async::Worker worker;
+    auto handle = worker.attach(manager);
+
+    for (uint64_t i = 0; i < count; i++) {
+        worker.push(make_op(handle));
+    }
+    ASSERT_TRUE(slog::tests::wait_dispatched(worker, count));
+
+    slog::async::WorkerStats stats = worker.stats();
+
+    EXPECT_EQ(stats.enqueued, count);
+    EXPECT_EQ(stats.dequeued, count);
+    EXPECT_EQ(stats.dropped, 0u);
+    EXPECT_EQ(stats.depth, 0u);
+    EXPECT_GE(stats.high_water, 1u);
+    EXPECT_LE(stats.high_water, stats.capacity);
+    EXPECT_GE(stats.wakeups, 1u);
+    EXPECT_LE(stats.wakeups, count);
+    EXPECT_GT(stats.busy.count(), 0);
+    EXPECT_GT(stats.records_per_wakeup(), 0.0);
+}
+
+TEST(WorkerStatsTest, DepthAndProducerWaitWhileTheWorkerIsHeld)
+{
+    constexpr uint64_t queued = 50;
+    constexpr auto timeout = std::chrono::milliseconds(5);
+    auto sink = std::make_shared<slog::tests::GateSink>();
+    auto manager = std::make_shared<slog::sinks::SinkManager>(sink);
+    slog::async::Worker worker;
+    auto handle = worker.attach(manager);
+
+    worker.push(make_op(handle));
+    ASSERT_TRUE(sink->wait_entered());
+    for (uint64_t i = 0; i < queued; i++) {
+        worker.push(make_op(handle));
+    }
+    // The held record counts until its dispatch returns
+    EXPECT_EQ(worker.stats().depth, queued + 1);
+    EXPECT_EQ(worker.stats().producer_wait.count(), 0);
+
+    // Fill the queue, the push that gives up waited at least the timeout
+    worker.set_queue_full_policy(slog::async::QueueFullPolicy::wait_for(timeout));
+    while (worker.push(make_op(handle))) {
+    }
+
+    slog::async::WorkerStats stats = worker.stats();
+
+    EXPECT_EQ(stats.dropped, 1u);
+    EXPECT_GE(stats.producer_wait, timeout);
+    EXPECT_EQ(stats.depth, stats.enqueued);
+
+    sink->release();
+    ASSERT_TRUE(slog::tests::wait_dispatched(worker, stats.enqueued));
+    EXPECT_EQ(worker.stats().depth, 0u);
+    EXPECT_GE(worker.stats().high_water, queued);
+}
+
+TEST(WorkerStatsTest, PeriodicReportIsLogged)
+{
+    auto sink = std::make_shared<slog::tests::AsyncVectorSink>("sink");
+    auto stats_sink = std::make_shared<slog::tests::AsyncVectorSink>("stats");
+    auto manager = std::make_shared<slog::sinks::SinkManager>(sink);
+    auto stats_manager = std::make_shared<slog::sinks::SinkManager>(stats_sink);
+    slog::async::Worker worker;
+    auto handle = worker.attach(manager);
+
+    stats_manager->set_pattern("[%l] [%n] %v");
+    worker.set_stats_reporting(stats_manager, "stats", std::chrono::milliseconds(1));
+    // The report is emitted by a worker with records to process
+    for (int i = 0; i < 20 && stats_sink->buffer_size() == 0; i++) {
+        worker.push(make_op(handle));
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    ASSERT_TRUE(stats_sink->wait_for(1));
+    EXPECT_EQ(stats_sink->get(0).rfind("[INFO] [stats] async stats: enqueued ", 0), 0u) << stats_sink->get(0);
+
+    worker.set_stats_reporting(nullptr, {}, std::chrono::milliseconds(0));
+}
+
+TEST(WorkerStatsTest, RegistrySnapshotCoversEveryWorker)
+{
+    auto stats = slog::Registry::instance().get_worker_stats();
+
+    ASSERT_EQ(stats.size(), slog::Registry::instance().get_worker_count());
+    for (const auto& worker : stats) {
+        EXPECT_GE(worker.enqueued, worker.dequeued);
+    }
+}
+
+TEST(WorkerStatsTest, QueueOptionsAreReported)
+{
+    slog::async::QueueOptions options{.capacity = 1000, .huge_pages = false, .prefault = true};
+    slog::async::Worker worker(slog::async::IdleStrategy::block(), options);
+    slog::async::WorkerStats stats = worker.stats();
+
+#ifdef SLOG_ASYNC_THREAD_QUEUES
+    // Per-thread rings keep their compile time size and are built on first push
+    EXPECT_EQ(stats.capacity, SLOG_SPSC_QUEUE_SIZE);
+    EXPECT_EQ(stats.memory.bytes, 0u);
+#elif defined(SLOG_ASYNC_BYTE_QUEUE)
+    EXPECT_EQ(stats.capacity, 1024u);
+    EXPECT_GE(stats.memory.bytes, 1024u);
+    EXPECT_TRUE(stats.memory.prefaulted);
+#else
+    EXPECT_EQ(stats.capacity, 1024u);
+    EXPECT_GE(stats.memory.bytes, 1024u * sizeof(slog::async::AsyncOp));
+    EXPECT_TRUE(stats.memory.prefaulted);
+#endif
+    EXPECT_EQ(stats.memory.backing, slog::async::PageBacking::REGULAR);
+}
+
+TEST(WorkerStatsTest, QueueOptionsAreFrozenOnceTheRegistryIsBuilt)
+{
+    (void)slog::Registry::instance();
+    EXPECT_FALSE(slog::Registry::set_queue_options(slog::async::QueueOptions{.capacity = 64}));
+    for (const auto& worker : slog::Registry::instance().get_worker_stats()) {
+        EXPECT_NE(worker.capacity, 64u);
+    }
+}
+
+TEST(WorkerStatsTest, WorkerCountIsFrozenOnceTheRegistryIsBuilt)
+{
+#ifdef SLOG_TEST_WORKER_COUNT
+    constexpr size_t expected = SLOG_TEST_WORKER_COUNT;
+#else
+    constexpr size_t expected = SLOG_ASYNC_WORKERS;
+#endif
+
+    EXPECT_EQ(slog::Registry::instance().get_worker_count(), expected);
+    EXPECT_FALSE(slog::Registry::set_worker_count(expected + 1));
+    EXPECT_EQ(slog::Registry::instance().get_worker_count(), expected);
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include <slog/async/worker.hpp>
+
+namespace slog::tests
+{
+
+// Waits up to a second for the worker to have dispatched `count` records
+inline bool wait_dispatched(const slog::async::Worker& worker, uint64_t count)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+
+    while (worker.dispatched() < count) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+} // namespace slog::tests
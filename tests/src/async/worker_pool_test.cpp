@@ -0,0 +1,155 @@
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <slog/async/worker_pool.hpp>
+#include <slog/slog.hpp>
+
+#include "async_vector_sink.hpp"
+#include "wait_dispatched.hpp"
+
+TEST(WorkerPoolTest, HashIsStable)
+{
+    slog::async::WorkerPool pool(4);
+
+    auto first = pool.assign("network", slog::async::Sharding::HASH);
+    auto second = pool.assign("network", slog::async::Sharding::HASH);
+
+    EXPECT_EQ(first, second);
+}
+
+TEST(WorkerPoolTest, LeastLoadedSpreadsLoggers)
+{
+    slog::async::WorkerPool pool(3);
+
+    auto a = pool.assign("a", slog::async::Sharding::LEAST_LOADED);
+    auto b = pool.assign("b", slog::async::Sharding::LEAST_LOADED);
+    auto c = pool.assign("c", slog::async::Sharding::LEAST_LOADED);
+
+    EXPECT_NE(a, b);
+    EXPECT_NE(b, c);
+    EXPECT_NE(a, c);
+    for (const auto& counters : pool.counters()) {
+        EXPECT_EQ(counters.loggers, 1u);
+    }
+}
+
+TEST(WorkerPoolTest, PinWrapsAround)
+{
+    slog::async::WorkerPool pool(2);
+
+    EXPECT_EQ(pool.pin(1), pool.pin(3));
+    EXPECT_EQ(pool.counters()[1].loggers, 2u);
+    EXPECT_EQ(pool.counters()[0].loggers, 0u);
+}
+
+TEST(WorkerPoolTest, CountersAndPerWorkerOrdering)
+{
+    constexpr uint32_t message_count = 200;
+    slog::async::WorkerPool pool(2);
+    auto sink_a = std::make_shared<slog::tests::AsyncVectorSink>("sink_a");
+    auto sink_b = std::make_shared<slog::tests::AsyncVectorSink>("sink_b");
+    auto manager_a = std::make_shared<slog::sinks::SinkManager>(sink_a);
+    auto manager_b = std::make_shared<slog::sinks::SinkManager>(sink_b);
+    auto worker_a = pool.pin(0);
+    auto worker_b = pool.pin(1);
+    auto handle_a = worker_a->attach(manager_a);
+    auto handle_b = worker_b->attach(manager_b);
+
+    manager_a->set_pattern("%v");
+    manager_b->set_pattern("%v");
+    for (uint32_t i = 0; i < message_count; i++) {
+        slog::LogRecord record;
+
+        record.level = slog::LogLevel::INFO;
+        record.thread_id = 0;
+        record.format_str = "msg {}";
+        record.format_fn = &slog::fmt::format_deferred<uint32_t>;
+        slog::fmt::store_args<uint32_t>(record.stored_args, i);
+        if (i % 4 == 0) {
+            worker_b->push(slog::async::AsyncOp{std::move(record), handle_b});
+        }
+        else {
+            worker_a->push(slog::async::AsyncOp{std::move(record), handle_a});
+        }
+    }
+
+    ASSERT_TRUE(slog::tests::wait_dispatched(*worker_a, message_count * 3 / 4));
+    ASSERT_TRUE(slog::tests::wait_dispatched(*worker_b, message_count / 4));
+    EXPECT_EQ(pool.counters()[0].dispatched, message_count * 3 / 4);
+    EXPECT_EQ(pool.counters()[1].dispatched, message_count / 4);
+
+    // Each worker keeps the push order of its records
+    for (uint32_t i = 0, a = 0, b = 0; i < message_count; i++) {
+        if (i % 4 == 0) {
+            EXPECT_EQ(sink_b->get(b++), std::format("msg {}", i));
+        }
+        else {
+            EXPECT_EQ(sink_a->get(a++), std::format("msg {}", i));
+        }
+    }
+}
+
+TEST(WorkerPoolTest, IdleStrategiesDeliverEveryRecord)
+{
+    constexpr uint32_t bursts = 4;
+    constexpr uint32_t burst_size = 16;
+
+    for (auto idle : {slog::async::IdleStrategy::block(), slog::async::IdleStrategy::backoff(64, 4),
+                      slog::async::IdleStrategy::spin()}) {
+        auto sink = std::make_shared<slog::tests::AsyncVectorSink>("sink");
+        auto manager = std::make_shared<slog::sinks::SinkManager>(sink);
+        slog::async::Worker worker(idle);
+        auto handle = worker.attach(manager);
+
+        manager->set_pattern("%v");
+        // Gaps let the worker run out of polling budget and park between bursts
+        for (uint32_t i = 0; i < bursts * burst_size; i++) {
+            slog::LogRecord record;
+
+            record.level = slog::LogLevel::INFO;
+            record.thread_id = 0;
+            record.format_str = "msg {}";
+            record.format_fn = &slog::fmt::format_deferred<uint32_t>;
+            slog::fmt::store_args<uint32_t>(record.stored_args, i);
+            worker.push(slog::async::AsyncOp{std::move(record), handle});
+            if (i % burst_size == burst_size - 1) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+        }
+
+        ASSERT_TRUE(slog::tests::wait_dispatched(worker, bursts * burst_size)) << static_cast<int>(idle.mode);
+        for (uint32_t i = 0; i < bursts * burst_size; i++) {
+            EXPECT_EQ(sink->get(i), std::format("msg {}", i));
+        }
+        // The worker stops while polling
+    }
+}
+
+TEST(WorkerPoolTest, IdleStrategyChangesWhileRunning)
+{
+    slog::async::WorkerPool pool(2);
+    auto sink = std::make_shared<slog::tests::AsyncVectorSink>("sink");
+    auto manager = std::make_shared<slog::sinks::SinkManager>(sink);
+    auto worker = pool.pin(0);
+    auto handle = worker->attach(manager);
+
+    manager->set_pattern("%v");
+    for (auto idle : {slog::async::IdleStrategy::spin(), slog::async::IdleStrategy::block(),
+                      slog::async::IdleStrategy::backoff()}) {
+        slog::LogRecord record;
+        uint64_t dispatched = worker->dispatched();
+
+        pool.set_idle_strategy(idle);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        record.level = slog::LogLevel::INFO;
+        record.thread_id = 0;
+        record.format_str = "msg";
+        worker->push(slog::async::AsyncOp{std::move(record), handle});
+        ASSERT_TRUE(slog::tests::wait_dispatched(*worker, dispatched + 1)) << static_cast<int>(idle.mode);
+    }
+    pool.set_idle_strategy(slog::async::IdleStrategy::block());
+}
@@ -0,0 +1,83 @@
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <slog/async/byte_ring_queue.hpp>
+#include <slog/async/policies.hpp>
+
+namespace
+{
+
+struct Entry
+{
+    size_t thread_id;
+    size_t sequence;
+};
+
+} // namespace
+
+TEST(ByteRingQueue_Concurrent, MultiProducerSingleConsumer)
+{
+    constexpr size_t NUM_PRODUCERS = 8;
+    constexpr size_t ITEMS_PER_PRODUCER = 10000;
+
+    slog::async::ByteRingQueue<1024 * 16, slog::async::BlockOnFull> queue;
+
+    std::atomic<bool> start_flag{false};
+    std::vector<std::thread> producers;
+
+    for (size_t t = 0; t < NUM_PRODUCERS; t++) {
+        producers.emplace_back([&, t]() {
+            while (!start_flag.load(std::memory_order_acquire));
+
+            for (size_t i = 0; i < ITEMS_PER_PRODUCER; i++) {
+                // Variable length payload: Entry followed by a filler of `i % 64` bytes
+                size_t size = sizeof(Entry) + i % 64;
+
+                queue.push(size, [&](std::byte* dst) {
+                    Entry e{t, i};
+                    std::memcpy(dst, &e, sizeof(Entry));
+                    std::memset(dst + sizeof(Entry), static_cast<int>(t), size - sizeof(Entry));
+                });
+            }
+        });
+    }
+
+    start_flag.store(true, std::memory_order_release);
+
+    size_t total_consumed = 0;
+    std::vector<size_t> last_seen_seq(NUM_PRODUCERS, (size_t)-1);
+
+    while (total_consumed < NUM_PRODUCERS * ITEMS_PER_PRODUCER) {
+        Entry e{};
+        size_t size = 0;
+        bool filler_ok = true;
+
+        bool popped = queue.pop([&](std::byte* data, size_t n) {
+            std::memcpy(&e, data, sizeof(Entry));
+            size = n;
+            for (size_t k = sizeof(Entry); k < n; k++) {
+                filler_ok &= data[k] == static_cast<std::byte>(e.thread_id);
+            }
+        });
+
+        if (!popped) {
+            std::this_thread::yield();
+            continue;
+        }
+        total_consumed++;
+
+        ASSERT_LT(e.thread_id, NUM_PRODUCERS) << "Received invalid thread ID";
+        ASSERT_EQ(size, sizeof(Entry) + e.sequence % 64) << "Corrupted entry size";
+        ASSERT_TRUE(filler_ok) << "Corrupted entry payload";
+        ASSERT_EQ(e.sequence, last_seen_seq[e.thread_id] + 1)
+            << "Gap or disorder detected for thread " << e.thread_id;
+        last_seen_seq[e.thread_id] = e.sequence;
+    }
+    for (auto& p : producers) {
+        p.join();
+    }
+    EXPECT_EQ(total_consumed, NUM_PRODUCERS * ITEMS_PER_PRODUCER);
+}
@@ -0,0 +1,172 @@
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <slog/async/byte_ring_queue.hpp>
+#include <slog/async/policies.hpp>
+
+namespace
+{
+
+template<typename Queue>
+bool push_string(Queue& queue, std::string_view str)
+{
+    return queue.push(str.size(), [&](std::byte* dst) { std::memcpy(dst, str.data(), str.size()); });
+}
+
+template<typename Queue>
+bool pop_string(Queue& queue, std::string& out)
+{
+    return queue.pop([&](std::byte* data, size_t size) {
+        out.assign(reinterpret_cast<const char*>(data), size);
+    });
+}
+
+} // namespace
+
+TEST(ByteRingQueue_Functional, BasicPushPop)
+{
+    slog::async::ByteRingQueue<1024, slog::async::BlockOnFull> queue;
+    std::string out;
+
+    EXPECT_TRUE(push_string(queue, "hello"));
+    EXPECT_TRUE(push_string(queue, "a longer entry spanning more than one block alignment"));
+
+    EXPECT_TRUE(pop_string(queue, out));
+    EXPECT_EQ(out, "hello");
+    EXPECT_TRUE(pop_string(queue, out));
+    EXPECT_EQ(out, "a longer entry spanning more than one block alignment");
+
+    // Queue should be empty now
+    EXPECT_FALSE(pop_string(queue, out));
+}
+
+TEST(ByteRingQueue_Functional, VariableSizesWrapAround)
+{
+    // Sizes chosen so that entries regularly hit the end of the ring and need padding
+    slog::async::ByteRingQueue<256, slog::async::BlockOnFull> queue;
+    std::string out;
+
+    for (size_t i = 0; i < 500; i++) {
+        std::string entry(1 + (i * 7) % 90, static_cast<char>('a' + i % 26));
+
+        ASSERT_TRUE(push_string(queue, entry));
+        ASSERT_TRUE(pop_string(queue, out));
+        ASSERT_EQ(out, entry);
+    }
+    EXPECT_FALSE(pop_string(queue, out));
+}
+
+TEST(ByteRingQueue_Functional, DiscardOnFull)
+{
+    using Queue = slog::async::ByteRingQueue<256, slog::async::DiscardOnFull>;
+    Queue queue;
+    std::string entry(64 - Queue::HEADER_SIZE, 'x');
+    std::string out;
+
+    // 4 entries of 64 bytes fill the ring
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(push_string(queue, entry));
+    }
+    EXPECT_FALSE(push_string(queue, entry));
+
+    EXPECT_TRUE(pop_string(queue, out));
+    EXPECT_TRUE(push_string(queue, entry));
+}
+
+TEST(ByteRingQueue_Functional, DropOldestDropsNewEntry)
+{
+    // Entries are read in place, the ring can't evict them
+    using Queue = slog::async::ByteRingQueue<256, slog::async::BlockOnFull>;
+    Queue queue;
+    slog::async::DropOldestOnFull<> policy;
+    std::string entry(64 - Queue::HEADER_SIZE, 'x');
+    auto write = [&](std::byte* dst) { std::memcpy(dst, entry.data(), entry.size()); };
+    std::string out;
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(queue.push(entry.size(), write, policy));
+    }
+    EXPECT_EQ(queue.size_approx(), queue.capacity());
+    EXPECT_FALSE(queue.push(entry.size(), write, policy));
+    EXPECT_TRUE(pop_string(queue, out));
+}
+
+TEST(ByteRingQueue_Functional, OversizedEntryIsRejected)
+{
+    using Queue = slog::async::ByteRingQueue<256, slog::async::BlockOnFull>;
+    Queue queue;
+
+    EXPECT_FALSE(push_string(queue, std::string(queue.max_payload() + 1, 'x')));
+    EXPECT_TRUE(push_string(queue, std::string(queue.max_payload(), 'x')));
+}
+
+TEST(ByteRingQueue_Functional, UncommittedEntryBlocksConsumer)
+{
+    slog::async::ByteRingQueue<1024, slog::async::BlockOnFull> queue;
+    slog::async::Reservation first;
+    slog::async::Reservation second;
+    std::string out;
+
+    ASSERT_TRUE(queue.try_reserve(first, 1));
+    ASSERT_TRUE(queue.try_reserve(second, 1));
+    *first.data = std::byte{'1'};
+    *second.data = std::byte{'2'};
+
+    // FIFO: the second entry must not be visible before the first one is committed
+    queue.commit(second);
+    EXPECT_FALSE(pop_string(queue, out));
+
+    queue.commit(first);
+    EXPECT_TRUE(pop_string(queue, out));
+    EXPECT_EQ(out, "1");
+    EXPECT_TRUE(pop_string(queue, out));
+    EXPECT_EQ(out, "2");
+}
+
+TEST(ByteRingQueue_Functional, PeekAndRelease)
+{
+    slog::async::ByteRingQueue<256, slog::async::BlockOnFull> queue;
+    std::vector<std::string> seen;
+    std::string out;
+
+    for (size_t round = 0; round < 20; round++) {
+        ASSERT_TRUE(push_string(queue, std::string(40, 'a')));
+        ASSERT_TRUE(push_string(queue, std::string(40, 'b')));
+        ASSERT_TRUE(push_string(queue, std::string(40, 'c')));
+
+        seen.clear();
+        size_t count = queue.peek(2, [&](std::byte* data, size_t size) {
+            seen.emplace_back(reinterpret_cast<const char*>(data), size);
+        });
+
+        ASSERT_EQ(count, 2u);
+        EXPECT_EQ(seen[0], std::string(40, 'a'));
+        EXPECT_EQ(seen[1], std::string(40, 'b'));
+
+        // Nothing is released until release() is called
+        EXPECT_EQ(queue.peek(8, [](std::byte*, size_t) {}), 3u);
+        queue.peek(2, [](std::byte*, size_t) {});
+        queue.release();
+
+        ASSERT_TRUE(pop_string(queue, out));
+        EXPECT_EQ(out, std::string(40, 'c'));
+        EXPECT_FALSE(pop_string(queue, out));
+    }
+}
+
+TEST(ByteRingQueue_Functional, RuntimeCapacity)
+{
+    slog::async::ByteRingQueue<256, slog::async::BlockOnFull> queue(
+        slog::async::QueueOptions{.capacity = 3000, .prefault = true});
+    std::string out;
+
+    ASSERT_EQ(queue.capacity(), 4096u);
+    EXPECT_GE(queue.memory().bytes, 4096u);
+    EXPECT_TRUE(queue.memory().prefaulted);
+    EXPECT_TRUE(push_string(queue, std::string(1000, 'x')));
+    EXPECT_TRUE(pop_string(queue, out));
+    EXPECT_EQ(out.size(), 1000u);
+}
@@ -0,0 +1,136 @@
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <slog/slog.hpp>
+
+namespace
+{
+
+slog::Logger& lookup_registry_cached()
+{
+    return SLOG_GET_LOGGER("registry_cached");
+}
+
+constexpr char SITE_NAMES[2][16] = {"registry_site_1", "registry_site_2"};
+
+// One call site, several names
+slog::Logger& lookup_site(const char (&name)[16])
+{
+    return SLOG_GET_LOGGER(name);
+}
+
+} // namespace
+
+TEST(RegistryTest, GetLoggerFindsCreatedLoggers)
+{
+    std::vector<std::shared_ptr<slog::Logger>> loggers;
+
+    for (int i = 0; i < 100; i++) {
+        loggers.push_back(slog::Registry::instance().create_logger("registry_" + std::to_string(i)));
+    }
+    for (int i = 0; i < 100; i++) {
+        std::string name = "registry_" + std::to_string(i);
+
+        EXPECT_EQ(&slog::Registry::instance().get_logger(name), loggers[i].get());
+        EXPECT_EQ(slog::Registry::instance().get_logger_ptr(name), loggers[i]);
+        EXPECT_EQ(slog::Registry::instance().find_logger(name), loggers[i].get());
+    }
+}
+
+TEST(RegistryTest, MissingLoggerFallsBackToDefault)
+{
+    slog::Registry& registry = slog::Registry::instance();
+
+    EXPECT_EQ(&registry.get_logger("registry_missing"), &registry.get_default_logger());
+    EXPECT_EQ(registry.get_logger_ptr("registry_missing"), nullptr);
+    EXPECT_EQ(registry.find_logger("registry_missing"), nullptr);
+}
+
+TEST(RegistryTest, DefaultLoggerCanBeChanged)
+{
+    slog::Registry& registry = slog::Registry::instance();
+    std::string previous(registry.get_default_logger().get_name());
+    auto logger = registry.create_logger("registry_default");
+
+    EXPECT_FALSE(registry.set_default_logger_name("registry_not_created"));
+    ASSERT_TRUE(registry.set_default_logger_name("registry_default"));
+    EXPECT_EQ(&registry.get_default_logger(), logger.get());
+    EXPECT_EQ(registry.get_default_logger_ptr(), logger);
+
+    ASSERT_TRUE(registry.set_default_logger_name(previous));
+    EXPECT_EQ(registry.get_default_logger().get_name(), previous);
+}
+
+TEST(RegistryTest, CallSiteCacheFollowsCreation)
+{
+    slog::Registry& registry = slog::Registry::instance();
+
+    // Not created yet: default logger, not cached
+    EXPECT_EQ(&lookup_registry_cached(), &registry.get_default_logger());
+
+    auto logger = registry.create_logger("registry_cached");
+
+    EXPECT_EQ(&lookup_registry_cached(), logger.get());
+    EXPECT_EQ(&lookup_registry_cached(), logger.get());
+
+    // Names that aren't literals go through the registry every time
+    std::string name = "registry_cached";
+    EXPECT_EQ(&SLOG_GET_LOGGER(name), logger.get());
+}
+
+TEST(RegistryTest, CallSiteCacheSkipsMutableBuffers)
+{
+    slog::Registry& registry = slog::Registry::instance();
+    auto first = registry.create_logger("registry_buffer_1");
+    auto second = registry.create_logger("registry_buffer_2");
+    char name[] = "registry_buffer_1";
+
+    for (int i = 0; i < 2; i++) {
+        slog::Logger& logger = SLOG_GET_LOGGER(name);
+
+        EXPECT_EQ(&logger, i == 0 ? first.get() : second.get());
+        name[sizeof(name) - 2] = '2';
+    }
+}
+
+TEST(RegistryTest, CallSiteCacheMatchesNameAndLogger)
+{
+    slog::Registry& registry = slog::Registry::instance();
+    auto first = registry.create_logger(SITE_NAMES[0]);
+    auto second = registry.create_logger(SITE_NAMES[1]);
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(&lookup_site(SITE_NAMES[i % 2]), i % 2 == 0 ? first.get() : second.get());
+    }
+}
+
+TEST(RegistryTest, LookupsWhileCreating)
+{
+    constexpr int LOGGERS = 200;
+    slog::Registry& registry = slog::Registry::instance();
+    auto first = registry.create_logger("registry_concurrent_first");
+    std::atomic<bool> done{false};
+    std::vector<std::thread> readers;
+
+    for (int t = 0; t < 3; t++) {
+        readers.emplace_back([&]() {
+            while (!done.load(std::memory_order_acquire)) {
+                EXPECT_EQ(registry.find_logger("registry_concurrent_first"), first.get());
+                EXPECT_EQ(&SLOG_GET_LOGGER("registry_concurrent_first"), first.get());
+            }
+        });
+    }
+    for (int i = 0; i < LOGGERS; i++) {
+        auto logger = registry.create_logger("registry_concurrent_" + std::to_string(i));
+
+        EXPECT_EQ(registry.find_logger(logger->get_name()), logger.get());
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+}
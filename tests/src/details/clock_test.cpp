@@ -0,0 +1,60 @@
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <slog/details/clock.hpp>
+
+namespace
+{
+
+using namespace std::chrono_literals;
+
+// Absolute distance between two time points
+std::chrono::nanoseconds distance(slog::details::TimePoint a, slog::details::TimePoint b)
+{
+    return a > b ? a - b : b - a;
+}
+
+} // namespace
+
+TEST(ClockTest, SystemClockIsWallTime)
+{
+    auto stamp = slog::details::SystemClock::resolve(slog::details::SystemClock::now());
+
+    EXPECT_LT(distance(stamp, std::chrono::system_clock::now()), 50ms);
+}
+
+TEST(ClockTest, CoarseClockIsWallTime)
+{
+    auto stamp = slog::details::CoarseClock::resolve(slog::details::CoarseClock::now());
+
+    // Kernel tick resolution
+    EXPECT_LT(distance(stamp, std::chrono::system_clock::now()), 50ms);
+}
+
+TEST(ClockTest, TscResolvesToWallTime)
+{
+    auto ticks = slog::details::TscClock::now();
+    auto wall = std::chrono::system_clock::now();
+
+    EXPECT_GT(slog::details::TscClock::instance().ns_per_tick(), 0.0);
+    EXPECT_LT(distance(slog::details::TscClock::resolve(ticks), wall), 5ms);
+}
+
+TEST(ClockTest, TscKeepsIntervalsAcrossRecalibration)
+{
+    auto first = slog::details::TscClock::now();
+    std::this_thread::sleep_for(30ms);
+    auto second = slog::details::TscClock::now();
+
+    // Resolving a later tick first may re-anchor the mapping, the older tick must still map back
+    auto second_wall = slog::details::TscClock::resolve(second);
+    auto first_wall = slog::details::TscClock::resolve(first);
+
+    auto elapsed = second_wall - first_wall;
+
+    // sleep_for may oversleep on a loaded machine
+    EXPECT_GT(elapsed, 25ms);
+    EXPECT_LT(elapsed, 500ms);
+}
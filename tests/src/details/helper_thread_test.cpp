@@ -0,0 +1,57 @@
+#include <chrono>
+#include <deque>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <slog/details/helper_thread.hpp>
+
+TEST(HelperThreadTest, TasksRunInOrderAndPrepareTheNext)
+{
+    std::vector<int> ran;
+    slog::details::HelperThread<int, int> helper;
+
+    // Negative tasks prepare the next resource
+    helper.post(-1);
+    helper.start([&](int& task, int& next) {
+        ran.push_back(task);
+        next = -task;
+        return task < 0;
+    });
+    for (int i = 2; i <= 4; i++) {
+        int taken = 0;
+
+        helper.take([&](int& next, std::deque<int>& tasks) {
+            taken = next;
+            tasks.push_back(i);
+            tasks.push_back(-i);
+        });
+        EXPECT_EQ(taken, i - 1);
+    }
+    helper.stop();
+
+    EXPECT_EQ(ran, (std::vector<int>{-1, 2, -2, 3, -3, 4, -4}));
+    EXPECT_EQ(helper.prepared(), 4);
+}
+
+TEST(HelperThreadTest, TakeWaitsWhenTheHelperFellBehind)
+{
+    slog::details::HelperThread<int, int> helper;
+
+    helper.start([](int& task, int& next) {
+        next = task;
+        return true;
+    });
+    // Nothing prepared yet: take waits for the task posted later
+    std::thread poster([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        helper.post(7);
+    });
+    int taken = 0;
+
+    helper.take([&](int& next, std::deque<int>&) { taken = next; });
+    poster.join();
+    EXPECT_EQ(taken, 7);
+    EXPECT_EQ(helper.waits(), 1u);
+}
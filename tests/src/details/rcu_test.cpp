@@ -0,0 +1,58 @@
+#include <atomic>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <slog/details/rcu.hpp>
+
+TEST(RcuTest, QuiescentWithoutReaders)
+{
+    uint64_t epoch = slog::details::Rcu::advance();
+
+    EXPECT_TRUE(slog::details::Rcu::quiescent(epoch));
+}
+
+TEST(RcuTest, WaitsForReadersPinnedBefore)
+{
+    std::atomic<bool> pinned{false};
+    std::atomic<bool> release{false};
+
+    std::thread reader([&]() {
+        slog::details::Rcu::ReadGuard guard;
+
+        pinned.store(true, std::memory_order_release);
+        while (!release.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    });
+    while (!pinned.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+
+    uint64_t epoch = slog::details::Rcu::advance();
+
+    EXPECT_FALSE(slog::details::Rcu::quiescent(epoch));
+
+    release.store(true, std::memory_order_release);
+    reader.join();
+    EXPECT_TRUE(slog::details::Rcu::quiescent(epoch));
+
+    // Readers entering after advance() don't hold back the epoch
+    slog::details::Rcu::ReadGuard guard;
+    EXPECT_TRUE(slog::details::Rcu::quiescent(epoch));
+}
+
+TEST(RcuTest, NestedGuardsKeepThePin)
+{
+    uint64_t epoch;
+
+    {
+        slog::details::Rcu::ReadGuard outer;
+        {
+            slog::details::Rcu::ReadGuard inner;
+        }
+        epoch = slog::details::Rcu::advance();
+        EXPECT_FALSE(slog::details::Rcu::quiescent(epoch));
+    }
+    EXPECT_TRUE(slog::details::Rcu::quiescent(epoch));
+}
@@ -0,0 +1,63 @@
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <slog/details/thread_context.hpp>
+#include <slog/details/thread_id.hpp>
+
+TEST(ThreadContextTest, CurrentIsCreatedOncePerThread)
+{
+    const slog::details::ThreadContext& first = slog::details::ThreadContext::current();
+    const slog::details::ThreadContext& second = slog::details::ThreadContext::current();
+    const slog::details::ThreadContext* other = nullptr;
+
+    std::thread([&]() {
+        other = &slog::details::ThreadContext::current();
+        other->retain();
+    }).join();
+
+    EXPECT_EQ(&first, &second);
+    EXPECT_NE(&first, other);
+    EXPECT_EQ(first.id(), slog::details::current_thread_id());
+    EXPECT_EQ(first.id_text(), std::to_string(slog::details::current_thread_id()));
+    // A retained context outlives its thread
+    EXPECT_EQ(other->id_text(), std::to_string(other->id()));
+    other->release();
+}
+
+TEST(ThreadContextTest, RenameKeepsPreviousContext)
+{
+    std::thread([]() {
+        const slog::details::ThreadContext& before = slog::details::ThreadContext::current();
+        std::string before_name(before.name());
+
+        // As a queued record does
+        before.retain();
+        slog::set_thread_name("a-very-long-thread-name");
+
+        const slog::details::ThreadContext& after = slog::details::ThreadContext::current();
+
+        // Truncated like pthread names
+        EXPECT_EQ(after.name(), "a-very-long-thr");
+        EXPECT_EQ(after.id(), before.id());
+        EXPECT_EQ(before.name(), before_name);
+        before.release();
+    }).join();
+}
+
+TEST(ThreadContextTest, UnnamedFallsBackToId)
+{
+    slog::details::ThreadContext context(4242, "");
+
+    EXPECT_EQ(context.id_text(), "4242");
+    EXPECT_EQ(context.name(), "4242");
+
+    // A thread only carrying the name inherited from the process is unnamed too
+    std::thread([]() {
+        const slog::details::ThreadContext& current = slog::details::ThreadContext::current();
+
+        EXPECT_EQ(current.name(), current.id_text());
+    }).join();
+}
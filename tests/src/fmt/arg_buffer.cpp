@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <slog/fmt/arg_buffer.hpp>
+#include <slog/fmt/deferred_format.hpp>
+
+// Non trivially copyable type to exercise the boxed path and its manager
+struct Tracked
+{
+    static inline int alive = 0;
+
+    Tracked(int v) : value(v) { alive++; }
+    Tracked(const Tracked& other) : value(other.value) { alive++; }
+    Tracked(Tracked&& other) noexcept : value(other.value) { alive++; }
+    ~Tracked() { alive--; }
+
+    int value;
+};
+
+// Copying it throws while `fail` is set
+struct Throwing : Tracked
+{
+    static inline bool fail = false;
+
+    Throwing(int v) : Tracked(v) {}
+    Throwing(const Throwing& other) : Tracked(other)
+    {
+        if (fail) {
+            throw std::runtime_error("copy failed");
+        }
+    }
+};
+
+template<>
+struct std::formatter<Tracked> : std::formatter<int>
+{
+    auto format(const Tracked& t, std::format_context& ctx) const
+    {
+        return std::formatter<int>::format(t.value, ctx);
+    }
+};
+
+// ============================================================================
+// ArgBuffer tests — storage, spill and lifetime of the encoded arguments
+// ============================================================================
+
+TEST(ArgBufferTest, CommonArgsStayInline)
+{
+    slog::fmt::ArgBuffer buffer;
+
+    slog::fmt::store_args<int, double, const char*, std::string, bool>(buffer, 1, 2.5, "literal",
+                                                                        std::string("short"), true);
+    EXPECT_TRUE(buffer.is_inline());
+    EXPECT_LE(buffer.size(), slog::fmt::ArgBuffer::INLINE_SIZE);
+}
+
+TEST(ArgBufferTest, OversizedPayloadSpills)
+{
+    slog::fmt::ArgBuffer buffer;
+    std::string big(slog::fmt::ArgBuffer::INLINE_SIZE * 2, 'x');
+    std::string out;
+
+    slog::fmt::store_args<std::string, int>(buffer, big, 7);
+    EXPECT_FALSE(buffer.is_inline());
+
+    slog::fmt::format_deferred<std::string, int>("{}{}", buffer, out);
+    EXPECT_EQ(out, big + "7");
+}
+
+TEST(ArgBufferTest, MoveAndCopyKeepPayload)
+{
+    slog::fmt::ArgBuffer buffer;
+    std::string big(slog::fmt::ArgBuffer::INLINE_SIZE * 2, 'y');
+    std::string out;
+
+    slog::fmt::store_args<int, std::string>(buffer, 3, std::string("abc"));
+
+    slog::fmt::ArgBuffer copied(buffer);
+    slog::fmt::ArgBuffer moved(std::move(buffer));
+
+    slog::fmt::format_deferred<int, std::string>("{}{}", copied, out);
+    EXPECT_EQ(out, "3abc");
+    slog::fmt::format_deferred<int, std::string>("{}{}", moved, out);
+    EXPECT_EQ(out, "3abc");
+    EXPECT_EQ(buffer.size(), 0);
+
+    slog::fmt::store_args<std::string>(moved, big);
+    copied = moved;
+    slog::fmt::format_deferred<std::string>("{}", copied, out);
+    EXPECT_EQ(out, big);
+}
+
+TEST(ArgBufferTest, BoxedArgsLifetime)
+{
+    std::string out;
+
+    {
+        slog::fmt::ArgBuffer buffer;
+
+        slog::fmt::store_args<std::string, Tracked>(buffer, std::string("t="), Tracked{5});
+        EXPECT_EQ(Tracked::alive, 1);
+
+        std::vector<slog::fmt::ArgBuffer> buffers;
+        buffers.push_back(buffer);
+        buffers.push_back(std::move(buffer));
+        EXPECT_EQ(Tracked::alive, 2);
+
+        for (const slog::fmt::ArgBuffer& b : buffers) {
+            slog::fmt::format_deferred<std::string, Tracked>("{}{:03}", b, out);
+            EXPECT_EQ(out, "t=005");
+        }
+
+        buffers[0].reset();
+        EXPECT_EQ(Tracked::alive, 1);
+    }
+    EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST(ArgBufferTest, ThrowingCopyDestroysEncodedArgs)
+{
+    slog::fmt::ArgBuffer buffer;
+    Tracked first{1};
+    Throwing second{2};
+
+    Throwing::fail = true;
+    EXPECT_THROW((slog::fmt::store_args<Tracked, Throwing>(buffer, first, second)), std::runtime_error);
+    Throwing::fail = false;
+    // Only the two locals are left, the copy of `first` was destroyed
+    EXPECT_EQ(Tracked::alive, 2);
+    EXPECT_EQ(buffer.size(), 0u);
+}
@@ -0,0 +1,146 @@
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <slog/core/log_record.hpp>
+#include <slog/fmt/compiled_pattern.hpp>
+#include <slog/fmt/pattern_formatter.hpp>
+#include <slog/sinks/sink_manager.hpp>
+
+namespace
+{
+
+class CompiledPatternTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        auto day = std::chrono::sys_days{std::chrono::year{2026}/std::chrono::month{2}/std::chrono::day{3}};
+        auto tp  = day + std::chrono::hours{4} + std::chrono::minutes{5} + std::chrono::seconds{6}
+                       + std::chrono::milliseconds{7} + std::chrono::microseconds{8};
+
+        record.level         = slog::LogLevel::WARNING;
+        record.logger_name   = "app";
+        record.string_buffer = "test message";
+        record.location      = std::source_location::current();
+        record.timestamp     = tp;
+        record.thread_id     = 99;
+    }
+
+    // Compiled and runtime formatters must produce the same output
+    template<slog::fmt::PatternString Pattern>
+    void expect_same_output()
+    {
+        slog::fmt::PatternFormatter runtime(Pattern.view());
+        slog::fmt::PatternFormatter compiled(slog::fmt::compiled_pattern<Pattern>);
+        std::string expected = "prefix|";
+        std::string actual = "prefix|";
+
+        runtime.format(record, expected);
+        compiled.format(record, actual);
+        EXPECT_EQ(actual, expected) << Pattern.view();
+    }
+
+    slog::LogRecord record;
+};
+
+class RecorderSink : public slog::sinks::ISink
+{
+public:
+    explicit RecorderSink(std::string_view name) : ISink(name) {}
+
+    void flush() override {}
+
+    std::vector<std::string> messages;
+
+private:
+    void _write(std::string_view message) override { messages.emplace_back(message); }
+};
+
+} // namespace
+
+TEST_F(CompiledPatternTest, MatchesRuntimeFormatter)
+{
+    expect_same_output<"[%Y-%m-%d %H:%M:%S.%e] [%l] %v\n">();
+    expect_same_output<"%H:%M:%S.%f %L/%s:%# %! %v">();
+    expect_same_output<"[%n] [%t] [%N] %g">();
+    expect_same_output<"100%% done %Z trailing%">();
+    expect_same_output<"">();
+}
+
+TEST_F(CompiledPatternTest, MatchesRuntimeFormatterForEveryLevel)
+{
+    for (auto level : {slog::LogLevel::FATAL, slog::LogLevel::ERROR, slog::LogLevel::INFO,
+                       slog::LogLevel::DEBUG, slog::LogLevel::TRACE}) {
+        record.level = level;
+        expect_same_output<"%l|%L">();
+    }
+}
+
+TEST_F(CompiledPatternTest, ClockBlockMatchesRuntimeFormatter)
+{
+    auto day = std::chrono::sys_days{std::chrono::year{2026}/std::chrono::month{12}/std::chrono::day{31}};
+
+    for (auto offset : {std::chrono::milliseconds{0}, std::chrono::milliseconds{9},
+                        std::chrono::milliseconds{10'099}, std::chrono::hours{23} + std::chrono::minutes{59} +
+                                                               std::chrono::milliseconds{59'999}}) {
+        record.timestamp = day + offset;
+        expect_same_output<"[%H:%M:%S.%e]">();
+        expect_same_output<"%H:%M:%S.%e%H:%M:%S.%e">();
+        // Not the clock block, written flag by flag
+        expect_same_output<"%H:%M:%S,%e">();
+        expect_same_output<"%H:%M:%S.%f">();
+        expect_same_output<"%H:%M%S.%e">();
+    }
+}
+
+TEST_F(CompiledPatternTest, MaxFixedWidth)
+{
+    // Literals, the date and time, the level at its longest, the message is unbounded
+    using Default = slog::fmt::CompiledPattern<"[%Y-%m-%d %H:%M:%S.%e] [%l] %v\n">;
+
+    EXPECT_EQ(Default::MAX_FIXED_WIDTH, std::string_view("[2026-02-03 04:05:06.007] [WARNING] \n").size());
+    EXPECT_EQ(Default::pattern(), "[%Y-%m-%d %H:%M:%S.%e] [%l] %v\n");
+}
+
+TEST_F(CompiledPatternTest, OwnIdSpace)
+{
+    slog::fmt::PatternFormatter runtime("[%l] %v");
+    slog::fmt::PatternFormatter compiled(slog::fmt::compiled_pattern<"[%l] %v">);
+    slog::fmt::PatternFormatter other(slog::fmt::compiled_pattern<"[%l] %v">);
+
+    // A registered flag changes the runtime rendering only, they can't share a rendering
+    EXPECT_EQ(compiled.get_pattern(), "[%l] %v");
+    EXPECT_NE(compiled.get_pattern_id(), runtime.get_pattern_id());
+    EXPECT_EQ(compiled.get_pattern_id(), other.get_pattern_id());
+}
+
+TEST_F(CompiledPatternTest, RuntimePatternReplacesCompiled)
+{
+    slog::fmt::PatternFormatter fmt(slog::fmt::compiled_pattern<"[%l] %v">);
+    std::string dest;
+
+    fmt.set_pattern("<%v>");
+    fmt.format(record, dest);
+    EXPECT_EQ(dest, "<test message>");
+}
+
+TEST_F(CompiledPatternTest, SinkManagerAndSinks)
+{
+    auto shared = std::make_shared<RecorderSink>("shared");
+    auto own = std::make_shared<RecorderSink>("own");
+    slog::sinks::SinkManager manager({shared, own});
+
+    manager.set_pattern(slog::fmt::compiled_pattern<"[%L] %v">);
+    own->set_pattern(slog::fmt::compiled_pattern<"%v (%n)">);
+    manager.dispatch(record);
+
+    ASSERT_EQ(shared->messages.size(), 1u);
+    ASSERT_EQ(own->messages.size(), 1u);
+    EXPECT_EQ(shared->messages[0], "[W] test message");
+    EXPECT_EQ(own->messages[0], "test message (app)");
+}
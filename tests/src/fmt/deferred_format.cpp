@@ -1,8 +1,7 @@
 #include <gtest/gtest.h>
-#include <any>
 #include <string>
-#include <tuple>
 
+#include <slog/fmt/arg_buffer.hpp>
 #include <slog/fmt/deferred_format.hpp>
 
 // ============================================================================
@@ -12,35 +11,34 @@
 class DeferredFormatTest : public ::testing::Test
 {
 protected:
-    std::any stored;
+    slog::fmt::ArgBuffer stored;
     std::string out;
 };
 
 TEST_F(DeferredFormatTest, SingleInt)
 {
-    stored.emplace<std::tuple<int>>(42);
+    slog::fmt::store_args<int>(stored, 42);
     slog::fmt::format_deferred<int>("value={}", stored, out);
     EXPECT_EQ(out, "value=42");
 }
 
 TEST_F(DeferredFormatTest, SingleString)
 {
-    stored.emplace<std::tuple<std::string>>(std::string("hello"));
+    slog::fmt::store_args<std::string>(stored, std::string("hello"));
     slog::fmt::format_deferred<std::string>("{}", stored, out);
     EXPECT_EQ(out, "hello");
 }
 
 TEST_F(DeferredFormatTest, MixedArgs)
 {
-    using Tuple = std::tuple<int, std::string, double>;
-    stored.emplace<Tuple>(42, std::string("world"), 3.14);
+    slog::fmt::store_args<int, std::string, double>(stored, 42, std::string("world"), 3.14);
     slog::fmt::format_deferred<int, std::string, double>("{} {} {:.2f}", stored, out);
     EXPECT_EQ(out, "42 world 3.14");
 }
 
 TEST_F(DeferredFormatTest, NoArgs)
 {
-    stored.emplace<std::tuple<>>();
+    slog::fmt::store_args<>(stored);
     slog::fmt::format_deferred<>("hello world", stored, out);
     EXPECT_EQ(out, "hello world");
 }
@@ -48,21 +46,63 @@ TEST_F(DeferredFormatTest, NoArgs)
 TEST_F(DeferredFormatTest, FunctionPointerUsage)
 {
     // Verify format_deferred can be used as a function pointer (as stored in LogRecord)
-    using Tuple = std::tuple<int, const char*>;
-    void (*fn)(std::string_view, std::any&, std::string&) = &slog::fmt::format_deferred<int, const char*>;
+    void (*fn)(std::string_view, const slog::fmt::ArgBuffer&, std::string&) =
+        &slog::fmt::format_deferred<int, const char*>;
 
-    stored.emplace<Tuple>(7, "test");
+    slog::fmt::store_args<int, const char*>(stored, 7, "test");
     fn("{} {}", stored, out);
     EXPECT_EQ(out, "7 test");
 }
 
 TEST_F(DeferredFormatTest, CalledTwiceOverwritesOutput)
 {
-    stored.emplace<std::tuple<int>>(1);
+    slog::fmt::store_args<int>(stored, 1);
     slog::fmt::format_deferred<int>("first={}", stored, out);
     EXPECT_EQ(out, "first=1");
 
-    stored.emplace<std::tuple<int>>(2);
+    slog::fmt::store_args<int>(stored, 2);
     slog::fmt::format_deferred<int>("second={}", stored, out);
     EXPECT_EQ(out, "second=2");
 }
+
+TEST_F(DeferredFormatTest, StringSpecsApplyToDecodedStrings)
+{
+    std::string_view sv = "sv";
+    const char* cstr = "cstr";
+
+    slog::fmt::store_args<std::string_view, const char*, std::string>(stored, sv, cstr, std::string("str"));
+    slog::fmt::format_deferred<std::string_view, const char*, std::string>("[{:>4}][{:<6}][{:^5}]", stored, out);
+    EXPECT_EQ(out, "[  sv][cstr  ][ str ]");
+}
+
+TEST_F(DeferredFormatTest, NullCString)
+{
+    const char* cstr = nullptr;
+
+    slog::fmt::store_args<const char*>(stored, cstr);
+    slog::fmt::format_deferred<const char*>("[{}]", stored, out);
+    EXPECT_EQ(out, "[]");
+}
+
+TEST_F(DeferredFormatTest, CharArrayIsCopied)
+{
+    char buf[16] = "local";
+
+    slog::fmt::store_args<char*>(stored, buf);
+    buf[0] = 'X';
+    slog::fmt::format_deferred<char*>("{}", stored, out);
+    EXPECT_EQ(out, "local");
+}
+
+TEST_F(DeferredFormatTest, ModeSelectsThePortableEncoding)
+{
+    slog::fmt::store_args<int>(stored, 7);
+    slog::fmt::format_deferred<int>("value={}", stored.data(), out, slog::fmt::FormatMode::MESSAGE);
+    EXPECT_EQ(out, "value=7");
+
+    out.clear();
+    slog::fmt::format_deferred<int>("{}", stored.data(), out, slog::fmt::FormatMode::PORTABLE_ARGS);
+    ASSERT_EQ(out.size(), 3u);
+    EXPECT_EQ(out[0], 1);
+    EXPECT_EQ(out[1], static_cast<char>(slog::fmt::PortableTag::INT));
+}
@@ -0,0 +1,129 @@
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include <slog/fmt/digits.hpp>
+#include <slog/fmt/format_flags.hpp>
+
+namespace
+{
+
+std::string to_chars_padded(uint64_t value, size_t width)
+{
+    char buf[32];
+    std::string text(buf, std::to_chars(buf, buf + sizeof(buf), value).ptr);
+
+    return text.size() < width ? std::string(width - text.size(), '0') + text : text;
+}
+
+template<size_t Width>
+void expect_fixed_width_range()
+{
+    uint32_t end = static_cast<uint32_t>(slog::fmt::detail::POWERS_OF_10[Width]);
+    char buf[Width];
+
+    for (uint32_t value = 0; value < end; value++) {
+        ASSERT_EQ(slog::fmt::detail::write_fixed<Width>(buf, value), buf + Width);
+        ASSERT_EQ(std::string_view(buf, Width), to_chars_padded(value, Width)) << value;
+    }
+}
+
+void expect_decimal(uint64_t value)
+{
+    char buf[32];
+    char* end = slog::fmt::detail::write_decimal(buf, value);
+
+    ASSERT_EQ(std::string_view(buf, static_cast<size_t>(end - buf)), to_chars_padded(value, 0)) << value;
+    ASSERT_EQ(slog::fmt::detail::count_digits(value), static_cast<size_t>(end - buf)) << value;
+}
+
+} // namespace
+
+TEST(DigitsTest, FixedWidthMatchesToChars)
+{
+    expect_fixed_width_range<1>();
+    expect_fixed_width_range<2>();
+    expect_fixed_width_range<3>();
+    expect_fixed_width_range<4>();
+    expect_fixed_width_range<6>();
+}
+
+TEST(DigitsTest, DecimalMatchesToChars)
+{
+    for (uint64_t value = 0; value < 10'000'000; value++) {
+        expect_decimal(value);
+    }
+    // Every digit count boundary up to the largest value
+    for (uint64_t power : slog::fmt::detail::POWERS_OF_10) {
+        expect_decimal(power - 1);
+        expect_decimal(power);
+        expect_decimal(power + 1);
+    }
+    for (int bit = 0; bit < 64; bit++) {
+        expect_decimal(uint64_t{1} << bit);
+        expect_decimal((uint64_t{1} << bit) - 1);
+    }
+    expect_decimal(std::numeric_limits<uint64_t>::max());
+}
+
+TEST(DigitsTest, PaddedMatchesToChars)
+{
+    char buf[32];
+
+    for (uint64_t value = 0; value < 1'000'000; value += 7) {
+        for (size_t width = 0; width <= 8; width++) {
+            char* end = slog::fmt::detail::write_padded(buf, value, width);
+
+            ASSERT_EQ(std::string_view(buf, static_cast<size_t>(end - buf)), to_chars_padded(value, width));
+        }
+    }
+}
+
+TEST(DigitsTest, AppendPaddedMatchesToChars)
+{
+    for (int value = -1000; value < 100'000; value++) {
+        for (int width = 0; width <= 6; width++) {
+            char buf[32];
+            std::to_chars_result result = std::to_chars(buf, buf + sizeof(buf), value);
+            std::string digits(buf, result.ptr);
+            std::string expected = digits.size() < static_cast<size_t>(width)
+                                       ? std::string(static_cast<size_t>(width) - digits.size(), '0') + digits
+                                       : digits;
+            std::string actual;
+
+            slog::fmt::detail::append_padded(actual, value, width);
+            ASSERT_EQ(actual, expected) << value << " width " << width;
+        }
+    }
+}
+
+TEST(DigitsTest, ClockMatchesFields)
+{
+    char buf[slog::fmt::detail::CLOCK_WIDTH];
+
+    auto expected = [](uint32_t h, uint32_t m, uint32_t s, uint32_t ms) {
+        return to_chars_padded(h, 2) + ':' + to_chars_padded(m, 2) + ':' + to_chars_padded(s, 2) + '.' +
+               to_chars_padded(ms, 3);
+    };
+
+    // Every time of day (leap second included) with changing milliseconds
+    for (uint32_t h = 0; h < 24; h++) {
+        for (uint32_t m = 0; m < 60; m++) {
+            for (uint32_t s = 0; s <= 60; s++) {
+                uint32_t ms = (h * 3600 + m * 60 + s) % 1000;
+
+                ASSERT_EQ(slog::fmt::detail::write_clock(buf, h, m, s, ms), buf + sizeof(buf));
+                ASSERT_EQ(std::string_view(buf, sizeof(buf)), expected(h, m, s, ms));
+            }
+        }
+    }
+    // Every millisecond
+    for (uint32_t ms = 0; ms < 1000; ms++) {
+        slog::fmt::detail::write_clock(buf, 23, 59, 59, ms);
+        ASSERT_EQ(std::string_view(buf, sizeof(buf)), expected(23, 59, 59, ms));
+    }
+}
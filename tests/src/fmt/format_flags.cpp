@@ -65,6 +65,44 @@ TEST_F(FormatFlagsTest, FmtThreadId)
     EXPECT_EQ(dest, "12345");
 }
 
+TEST_F(FormatFlagsTest, FmtThreadIdFromContext)
+{
+    slog::details::ThreadContext thread(777, "io-worker");
+    record.thread = &thread;
+
+    slog::fmt::FormatContext ctx(record);
+    slog::fmt::fmt_thread_id(ctx, dest);
+    EXPECT_EQ(dest, "777");
+}
+
+TEST_F(FormatFlagsTest, FmtThreadName)
+{
+    slog::details::ThreadContext thread(777, "io-worker");
+    slog::details::ThreadContext unnamed(778, "");
+
+    {
+        slog::fmt::FormatContext ctx(record);
+        slog::fmt::fmt_thread_name(ctx, dest);
+        EXPECT_EQ(dest, "12345");
+    }
+
+    dest.clear();
+    record.thread = &thread;
+    {
+        slog::fmt::FormatContext ctx(record);
+        slog::fmt::fmt_thread_name(ctx, dest);
+        EXPECT_EQ(dest, "io-worker");
+    }
+
+    dest.clear();
+    record.thread = &unnamed;
+    {
+        slog::fmt::FormatContext ctx(record);
+        slog::fmt::fmt_thread_name(ctx, dest);
+        EXPECT_EQ(dest, "778");
+    }
+}
+
 TEST_F(FormatFlagsTest, FmtLoggerName)
 {
     slog::fmt::FormatContext ctx(record);
@@ -133,6 +133,110 @@ TEST_F(PatternFormatterTest, DateTimeMillis)
     EXPECT_EQ(dest, expected);
 }
 
+TEST_F(PatternFormatterTest, CachedTimeFollowsTimestamps)
+{
+    slog::fmt::PatternFormatter fmt("[%H:%M:%S.%f] [%t] %S %v");
+    auto expected = [&](std::chrono::system_clock::time_point tp, int micros) {
+        std::time_t tt = std::chrono::system_clock::to_time_t(tp);
+        std::tm local{};
+        slog::details::localtime(&tt, &local);
+
+        return std::format("[{:02d}:{:02d}:{:02d}.{:06d}] [99] {:02d} test message",
+            local.tm_hour, local.tm_min, local.tm_sec, micros, local.tm_sec);
+    };
+    auto base = record.timestamp;
+
+    // Same second: only the sub-second field changes
+    fmt.format(record, dest);
+    EXPECT_EQ(dest, expected(base, 123456));
+
+    dest.clear();
+    record.timestamp = base + std::chrono::microseconds{500'000};
+    fmt.format(record, dest);
+    EXPECT_EQ(dest, expected(base, 623456));
+
+    // Next minute, then back in time
+    dest.clear();
+    record.timestamp = base + std::chrono::seconds{15};
+    fmt.format(record, dest);
+    EXPECT_EQ(dest, expected(record.timestamp, 123456));
+
+    dest.clear();
+    record.timestamp = base;
+    fmt.format(record, dest);
+    EXPECT_EQ(dest, expected(base, 123456));
+}
+
+TEST_F(PatternFormatterTest, SetPatternResetsCachedTime)
+{
+    slog::fmt::PatternFormatter fmt("%Y");
+    fmt.format(record, dest);
+
+    dest.clear();
+    fmt.set_pattern("%S|%Y");
+    fmt.format(record, dest);
+
+    std::time_t tt = std::chrono::system_clock::to_time_t(record.timestamp);
+    std::tm local{};
+    slog::details::localtime(&tt, &local);
+
+    EXPECT_EQ(dest, std::format("{:02d}|{:04d}", local.tm_sec, local.tm_year + 1900));
+}
+
+TEST_F(PatternFormatterTest, EveryBuiltinFlagMatchesItsFunction)
+{
+    for (size_t c = 0; c < slog::fmt::BUILTIN_FLAGS.size(); c++) {
+        slog::fmt::FormatFn fn = slog::fmt::BUILTIN_FLAGS[c];
+
+        if (!fn) {
+            continue;
+        }
+
+        // Enough steps to be sized, written after existing content
+        std::string flag = std::string("%") + static_cast<char>(c);
+        std::string pattern = "<" + flag + ">|" + flag + "|";
+        std::string expected = "prefix<";
+        slog::fmt::FormatContext ctx(record);
+        slog::fmt::PatternFormatter fmt(pattern);
+
+        fn(ctx, expected);
+        expected.append(">|");
+        fn(ctx, expected);
+        expected.push_back('|');
+        dest = "prefix";
+        fmt.format(record, dest);
+        EXPECT_EQ(dest, expected) << pattern;
+    }
+}
+
+TEST_F(PatternFormatterTest, RegisteredFlagMixedWithBuiltins)
+{
+    slog::fmt::PatternFormatter::register_flag('Q', [](const slog::fmt::FormatContext& ctx, std::string& d) {
+        d.append(ctx.record.logger_name);
+        d.append("!");
+    });
+
+    slog::fmt::PatternFormatter fmt("[%e] [%l] %Q %v|");
+    fmt.format(record, dest);
+    fmt.format(record, dest);
+    EXPECT_EQ(dest, "[123] [INFO] app! test message|[123] [INFO] app! test message|");
+}
+
+TEST_F(PatternFormatterTest, PatternIdFollowsPattern)
+{
+    slog::fmt::PatternFormatter a("[%l] %v");
+    slog::fmt::PatternFormatter b("[%l] %v");
+    slog::fmt::PatternFormatter c("%v");
+
+    EXPECT_EQ(a.get_pattern_id(), b.get_pattern_id());
+    EXPECT_NE(a.get_pattern_id(), c.get_pattern_id());
+
+    uint64_t generation = slog::fmt::PatternFormatter::pattern_generation();
+    c.set_pattern("[%l] %v");
+    EXPECT_EQ(a.get_pattern_id(), c.get_pattern_id());
+    EXPECT_GT(slog::fmt::PatternFormatter::pattern_generation(), generation);
+}
+
 TEST_F(PatternFormatterTest, TrailingPercentSign)
 {
     // A pattern ending with a lone '%' — should be treated as literal
@@ -127,3 +127,42 @@ TEST(MPSCQueue_Concurrent, DiscardOnFull_Stress)
     // But we should have consumed AT LEAST something (sanity check)
     EXPECT_GT(total_consumed, 0);
 }
+
+TEST(MPSCQueue_Concurrent, PackedSlots_MultiProducerOrder)
+{
+    // Small ring so the consumer's prefetch wraps around while producers commit
+    constexpr size_t QUEUE_SIZE = 256;
+    constexpr size_t NUM_PRODUCERS = 4;
+    constexpr size_t ITEMS_PER_PRODUCER = 20000;
+
+    slog::async::MPSCQueue<TestRecord, QUEUE_SIZE, slog::async::BlockOnFull, slog::async::SlotLayout::PACKED>
+        queue;
+    std::vector<std::thread> producers;
+
+    for (size_t t = 0; t < NUM_PRODUCERS; t++) {
+        producers.emplace_back([&, t]() {
+            for (size_t i = 0; i < ITEMS_PER_PRODUCER; i++) {
+                queue.push(TestRecord{"packed", t, i});
+            }
+        });
+    }
+
+    size_t total_consumed = 0;
+    std::vector<size_t> next_seq(NUM_PRODUCERS, 0);
+
+    while (total_consumed < NUM_PRODUCERS * ITEMS_PER_PRODUCER) {
+        TestRecord rec;
+
+        if (!queue.pop(rec)) {
+            std::this_thread::yield();
+            continue;
+        }
+        ASSERT_LT(rec.thread_id, NUM_PRODUCERS);
+        ASSERT_EQ(rec.sequence, next_seq[rec.thread_id]++);
+        total_consumed++;
+    }
+    for (auto& p : producers) {
+        p.join();
+    }
+    EXPECT_TRUE(queue.empty());
+}
@@ -1,3 +1,4 @@
+#include <chrono>
 #include <vector>
 #include <limits>
 
@@ -96,6 +97,45 @@ TEST(MPSCQueue_Functional, DiscardOnFull)
     EXPECT_EQ(val, 4);
 }
 
+TEST(MPSCQueue_Functional, DropOldestOnFull)
+{
+    std::vector<int> evicted;
+    auto on_evict = [&evicted](int& item) { evicted.push_back(item); };
+    slog::async::DropOldestOnFull<decltype(on_evict)> policy{on_evict};
+    slog::async::MPSCQueue<int, 4, slog::async::BlockOnFull> queue;
+
+    for (int i = 1; i <= 6; i++) {
+        EXPECT_TRUE(queue.push(std::move(i), policy));
+    }
+    EXPECT_EQ(queue.size_approx(), 4u);
+    EXPECT_EQ(evicted, (std::vector<int>{1, 2}));
+
+    int val;
+    for (int expected = 3; expected <= 6; expected++) {
+        ASSERT_TRUE(queue.pop(val));
+        EXPECT_EQ(val, expected);
+    }
+    EXPECT_FALSE(queue.try_evict(val));
+}
+
+TEST(MPSCQueue_Functional, WaitOnFullTimesOut)
+{
+    slog::async::WaitOnFull policy{std::chrono::milliseconds(2)};
+    slog::async::MPSCQueue<int, 2, slog::async::BlockOnFull> queue;
+
+    EXPECT_TRUE(queue.push(1, policy));
+    EXPECT_TRUE(queue.push(2, policy));
+
+    auto start = std::chrono::steady_clock::now();
+
+    EXPECT_FALSE(queue.push(3, policy));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, policy.timeout);
+
+    int val;
+    EXPECT_TRUE(queue.pop(val));
+    EXPECT_TRUE(queue.push(4, policy));
+}
+
 TEST(MPSCQueue_Functional, ComplexTypes)
 {
     slog::async::MPSCQueue<TestRecord, 4, slog::async::BlockOnFull> queue;
@@ -113,3 +153,53 @@ TEST(MPSCQueue_Functional, ComplexTypes)
     EXPECT_TRUE(queue.pop(out));
     EXPECT_EQ(out, d2);
 }
+
+TEST(MPSCQueue_Functional, RuntimeCapacity)
+{
+    slog::async::MPSCQueue<int, 4, slog::async::DiscardOnFull> queue(slog::async::QueueOptions{.capacity = 100});
+    int val = 0;
+
+    // Rounded up to a power of 2
+    ASSERT_EQ(queue.capacity(), 128u);
+    for (int i = 0; i < 128; i++) {
+        EXPECT_TRUE(queue.push(std::move(i)));
+    }
+    EXPECT_FALSE(queue.push(128));
+    EXPECT_TRUE(queue.pop(val));
+    EXPECT_EQ(val, 0);
+}
+
+TEST(MPSCQueue_Functional, HugePagesAndPrefault)
+{
+    slog::async::QueueOptions options{.capacity = 1024, .huge_pages = true, .prefault = true};
+    slog::async::MPSCQueue<TestRecord, 4, slog::async::BlockOnFull> queue(options);
+    TestRecord out;
+
+    // Falls back to regular pages when no huge page is available
+    EXPECT_GE(queue.memory().bytes, queue.capacity() * sizeof(TestRecord));
+    EXPECT_TRUE(queue.memory().prefaulted);
+    EXPECT_TRUE(queue.push(TestRecord{"huge", 1, 1}));
+    EXPECT_TRUE(queue.pop(out));
+    EXPECT_EQ(out.data, "huge");
+}
+
+TEST(MPSCQueue_Functional, PackedSlotsWrapAround)
+{
+    using Packed = slog::async::MPSCQueue<TestRecord, 4, slog::async::BlockOnFull, slog::async::SlotLayout::PACKED>;
+    using Split = slog::async::MPSCQueue<TestRecord, 4, slog::async::BlockOnFull, slog::async::SlotLayout::SPLIT>;
+    Packed queue;
+    TestRecord out;
+
+    // Sequence and record share the first line, slots stay cacheline aligned
+    EXPECT_EQ(Packed::slot_size() % SLOG_CACHELINE_SIZE, 0u);
+    EXPECT_LE(Packed::slot_size(), Split::slot_size());
+    for (size_t i = 0; i < 10; i++) {
+        EXPECT_TRUE(queue.push(TestRecord{"packed", 0, i}));
+        EXPECT_TRUE(queue.push(TestRecord{"packed", 0, i + 100}));
+        ASSERT_TRUE(queue.pop(out));
+        EXPECT_EQ(out.sequence, i);
+        ASSERT_TRUE(queue.pop(out));
+        EXPECT_EQ(out.sequence, i + 100);
+    }
+    EXPECT_FALSE(queue.pop(out));
+}
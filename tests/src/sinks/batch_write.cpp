@@ -0,0 +1,133 @@
+#include <array>
+#include <cstdio>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <slog/fmt/deferred_format.hpp>
+#include <slog/sinks/console_sink.hpp>
+#include <slog/sinks/sink_manager.hpp>
+
+namespace
+{
+
+class BatchRecorderSink : public slog::sinks::ISink
+{
+public:
+    BatchRecorderSink(std::string_view name) : ISink(name) {}
+
+    void flush() override {}
+
+    std::vector<std::vector<std::string>> batches;
+
+private:
+    void _write(std::string_view message) override { batches.push_back({std::string(message)}); }
+
+    void _write_batch(std::span<const std::string_view> messages) override
+    {
+        batches.emplace_back(messages.begin(), messages.end());
+    }
+};
+
+struct Records
+{
+    explicit Records(size_t count) : records(count)
+    {
+        for (size_t i = 0; i < count; i++) {
+            records[i].level = i % 2 ? slog::LogLevel::DEBUG : slog::LogLevel::INFO;
+            records[i].thread_id = 0;
+            records[i].format_str = "msg {}";
+            records[i].format_fn = &slog::fmt::format_deferred<size_t>;
+            slog::fmt::store_args<size_t>(records[i].stored_args, i);
+            pointers.push_back(&records[i]);
+        }
+    }
+
+    std::vector<slog::LogRecord> records;
+    std::vector<slog::LogRecord*> pointers;
+};
+
+} // namespace
+
+TEST(BatchWriteTest, SharedPatternSingleBatch)
+{
+    auto sink = std::make_shared<BatchRecorderSink>("recorder");
+    slog::sinks::SinkManager manager(sink);
+    Records batch(4);
+
+    manager.set_pattern("%v|");
+    manager.dispatch(batch.pointers);
+
+    ASSERT_EQ(sink->batches.size(), 1u);
+    EXPECT_EQ(sink->batches[0], (std::vector<std::string>{"msg 0|", "msg 1|", "msg 2|", "msg 3|"}));
+}
+
+TEST(BatchWriteTest, OwnPatternAndLevelFilter)
+{
+    auto sink = std::make_shared<BatchRecorderSink>("recorder");
+    slog::sinks::SinkManager manager(sink);
+    Records batch(6);
+
+    // The sink formats with its own pattern and drops the DEBUG records
+    sink->set_pattern("<%v>");
+    sink->set_level(slog::LogLevel::INFO);
+    manager.dispatch(batch.pointers);
+
+    ASSERT_EQ(sink->batches.size(), 1u);
+    EXPECT_EQ(sink->batches[0], (std::vector<std::string>{"<msg 0>", "<msg 2>", "<msg 4>"}));
+}
+
+TEST(BatchWriteTest, FanOutFollowsPatternChanges)
+{
+    auto shared = std::make_shared<BatchRecorderSink>("shared");
+    auto own = std::make_shared<BatchRecorderSink>("own");
+    slog::sinks::SinkManager manager({shared, own});
+    Records batch(2);
+
+    manager.set_pattern("%v|");
+    own->set_pattern("<%v>");
+    manager.dispatch(batch.pointers);
+
+    // Patterns changed directly on the sinks after they were added
+    shared->set_pattern("(%v)");
+    own->set_pattern("%v|");
+    manager.dispatch(batch.pointers);
+
+    ASSERT_EQ(shared->batches.size(), 2u);
+    ASSERT_EQ(own->batches.size(), 2u);
+    EXPECT_EQ(shared->batches[0], (std::vector<std::string>{"msg 0|", "msg 1|"}));
+    EXPECT_EQ(own->batches[0], (std::vector<std::string>{"<msg 0>", "<msg 1>"}));
+    EXPECT_EQ(shared->batches[1], (std::vector<std::string>{"(msg 0)", "(msg 1)"}));
+    EXPECT_EQ(own->batches[1], (std::vector<std::string>{"msg 0|", "msg 1|"}));
+}
+
+TEST(BatchWriteTest, ConsoleSinkWritesWholeBatch)
+{
+#ifdef _WIN32
+    std::FILE* stream;
+    tmpfile_s(&stream);
+#else
+    std::FILE* stream = std::tmpfile();
+#endif
+    ASSERT_NE(stream, nullptr);
+
+    auto sink = std::make_shared<slog::sinks::ConsoleSink>("console", stream);
+    slog::sinks::SinkManager manager(sink);
+    Records batch(3);
+
+    manager.set_pattern("%v\n");
+    manager.dispatch(batch.pointers);
+    sink->flush();
+
+    std::rewind(stream);
+    std::array<char, 256> buffer;
+    std::size_t read_size = std::fread(buffer.data(), sizeof(char), buffer.size() - 1, stream);
+    buffer[read_size] = '\0';
+
+    EXPECT_EQ(std::string(buffer.data()), "msg 0\nmsg 1\nmsg 2\n");
+    std::fclose(stream);
+}
@@ -0,0 +1,219 @@
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <slog/core/log_record.hpp>
+#include <slog/fmt/deferred_format.hpp>
+#include <slog/sinks/binary_file_sink.hpp>
+#include <slog/sinks/binary_log.hpp>
+#include <slog/sinks/sink_manager.hpp>
+
+#include "common.hpp"
+
+namespace
+{
+
+// Copy of a decoded record, which only stays valid until the reader moves on
+struct Decoded
+{
+    std::string message;
+    std::string logger_name;
+    std::string file; // empty for text
+    std::chrono::system_clock::time_point timestamp;
+    uint64_t thread_id;
+    slog::LogLevel level;
+};
+
+template<typename... Args>
+slog::LogRecord make_record(slog::LogLevel level, std::format_string<Args...> fmt, Args&&... args)
+{
+    slog::LogRecord record;
+
+    record.level = level;
+    record.logger_name = "binary";
+    record.location = std::source_location::current();
+    record.timestamp = std::chrono::system_clock::now();
+    record.thread_id = 42;
+    record.format_str = fmt.get();
+    record.format_fn = &slog::fmt::format_deferred<std::decay_t<Args>...>;
+    slog::fmt::store_args<std::decay_t<Args>...>(record.stored_args, std::forward<Args>(args)...);
+    return record;
+}
+
+class BinaryFileSinkTest : public SinkFileTest<>
+{
+protected:
+    [[nodiscard]] static std::vector<Decoded> decode(std::string_view data, bool* complete = nullptr)
+    {
+        slog::sinks::binary::Reader reader(data);
+        std::vector<Decoded> records;
+        slog::sinks::binary::Record record;
+
+        while (reader.next(record)) {
+            records.push_back(Decoded{record.message, std::string(record.logger_name),
+                                      record.callsite ? record.callsite->file : std::string(),
+                                      record.timestamp, record.thread_id, record.level});
+        }
+        if (complete) {
+            *complete = reader.complete();
+        }
+        return records;
+    }
+};
+
+} // namespace
+
+TEST_F(BinaryFileSinkTest, RecordsDecodeToTheirMessage)
+{
+    std::vector<std::string> expected;
+    const char* name = "worker";
+
+    {
+        auto sink = std::make_shared<slog::sinks::BinaryFileSink>("binary", path);
+        slog::sinks::SinkManager manager(sink);
+        std::vector<slog::LogRecord> records;
+
+        records.push_back(make_record(slog::LogLevel::INFO, "int {} unsigned {} negative {}", 7, 42u, -123456789LL));
+        expected.push_back(std::format("int {} unsigned {} negative {}", 7, 42u, -123456789LL));
+        records.push_back(make_record(slog::LogLevel::WARNING, "{:>8}|{:08.3f}|{:x}|{:e}", std::string("right"), 3.14159, 255, 1.5f));
+        expected.push_back(std::format("{:>8}|{:08.3f}|{:x}|{:e}", std::string("right"), 3.14159, 255, 1.5f));
+        records.push_back(make_record(slog::LogLevel::ERROR, "{1} {0} {1:d}", name, true));
+        expected.push_back(std::format("{1} {0} {1:d}", name, true));
+        records.push_back(make_record(slog::LogLevel::DEBUG, "{}{{}}{:^9} {}", 'c', std::string_view("mid"), nullptr));
+        expected.push_back(std::format("{}{{}}{:^9} {}", 'c', std::string_view("mid"), nullptr));
+        for (slog::LogRecord& record : records) {
+            manager.dispatch(record);
+        }
+    }
+
+    std::vector<Decoded> records = decode(contents());
+
+    ASSERT_EQ(records.size(), expected.size());
+    for (size_t i = 0; i < records.size(); i++) {
+        EXPECT_EQ(records[i].message, expected[i]);
+        EXPECT_EQ(records[i].logger_name, "binary");
+        EXPECT_EQ(records[i].thread_id, 42u);
+        EXPECT_EQ(records[i].file, std::source_location::current().file_name());
+    }
+    EXPECT_EQ(records[1].level, slog::LogLevel::WARNING);
+}
+
+TEST_F(BinaryFileSinkTest, StreamRecordsKeepTheirText)
+{
+    {
+        auto sink = std::make_shared<slog::sinks::BinaryFileSink>("binary", path);
+        slog::sinks::SinkManager manager(sink);
+        slog::LogRecord record;
+
+        record.level = slog::LogLevel::INFO;
+        record.logger_name = "stream";
+        record.thread_id = 1;
+        record.string_buffer = "streamed {} text";
+        manager.dispatch(record);
+    }
+
+    std::vector<Decoded> records = decode(contents());
+
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_EQ(records[0].message, "streamed {} text");
+}
+
+TEST_F(BinaryFileSinkTest, CallsitesAndTimestampsAreCompact)
+{
+    constexpr size_t count = 1000;
+    auto start = std::chrono::system_clock::now();
+
+    {
+        auto sink = std::make_shared<slog::sinks::BinaryFileSink>("binary", path);
+        slog::sinks::SinkManager manager(sink);
+
+        for (size_t i = 0; i < count; i++) {
+            slog::LogRecord record = make_record(slog::LogLevel::INFO, "request {} served in {} us", i, 250);
+
+            manager.dispatch(record);
+        }
+    }
+
+    std::string data = contents();
+    std::vector<Decoded> records = decode(data);
+
+    ASSERT_EQ(records.size(), count);
+    EXPECT_EQ(records[999].message, "request 999 served in 250 us");
+    EXPECT_GE(records[0].timestamp, std::chrono::floor<std::chrono::nanoseconds>(start));
+    EXPECT_LE(records[0].timestamp, records[999].timestamp);
+    // The format string is stored once, a record is ~10 bytes when its text is ~30
+    EXPECT_EQ(data.find("served in"), data.rfind("served in"));
+    EXPECT_LT(data.size(), count * 16);
+}
+
+TEST_F(BinaryFileSinkTest, TruncatedFileDecodesUpToTheLastFrame)
+{
+    {
+        auto sink = std::make_shared<slog::sinks::BinaryFileSink>("binary", path);
+        slog::sinks::SinkManager manager(sink);
+
+        for (int i = 0; i < 3; i++) {
+            slog::LogRecord record = make_record(slog::LogLevel::INFO, "record {}", i);
+
+            manager.dispatch(record);
+        }
+    }
+
+    std::string data = contents();
+    bool complete = false;
+    std::vector<Decoded> records = decode(std::string_view(data).substr(0, data.size() - 1), &complete);
+
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[1].message, "record 1");
+    EXPECT_FALSE(complete);
+
+    EXPECT_EQ(decode(data, &complete).size(), 3u);
+    EXPECT_TRUE(complete);
+    EXPECT_TRUE(decode("not a binary log", &complete).empty());
+    EXPECT_FALSE(complete);
+}
+
+TEST_F(BinaryFileSinkTest, AppendingStartsANewSession)
+{
+    for (int session = 0; session < 2; session++) {
+        auto sink = std::make_shared<slog::sinks::BinaryFileSink>("binary", path, "ab");
+        slog::sinks::SinkManager manager(sink);
+        slog::LogRecord record = make_record(slog::LogLevel::INFO, "session {}", session);
+
+        manager.dispatch(record);
+        sink->log(std::string_view("raw text\n"));
+    }
+
+    std::vector<Decoded> records = decode(contents());
+
+    ASSERT_EQ(records.size(), 4u);
+    EXPECT_EQ(records[0].message, "session 0");
+    EXPECT_TRUE(records[1].file.empty());
+    EXPECT_EQ(records[1].message, "raw text\n");
+    EXPECT_EQ(records[2].message, "session 1");
+}
+
+TEST_F(BinaryFileSinkTest, MessageNotFormattedForBinarySinksOnly)
+{
+    auto binary = std::make_shared<slog::sinks::BinaryFileSink>("binary", path);
+    slog::sinks::SinkManager manager(binary);
+    slog::LogRecord record = make_record(slog::LogLevel::DEBUG, "value {}", 1);
+    slog::LogRecord* batch[] = {&record};
+
+    manager.dispatch(record);
+    manager.dispatch(std::span<slog::LogRecord* const>(batch));
+    EXPECT_TRUE(record.string_buffer.empty());
+    EXPECT_TRUE(record.message.empty());
+
+    binary->flush();
+    EXPECT_EQ(decode(contents()).size(), 2u);
+}
@@ -0,0 +1,37 @@
+#ifndef SINKS_TEST_COMMON_HPP
+#define SINKS_TEST_COMMON_HPP
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include <gtest/gtest.h>
+
+// Fixture of the file sink tests: `path` is a file in a directory of the test's own, removed
+// with everything the sink left there
+template<typename Base = ::testing::Test>
+class SinkFileTest : public Base
+{
+protected:
+    void SetUp() override { std::filesystem::create_directories(directory); }
+
+    void TearDown() override { std::filesystem::remove_all(directory); }
+
+    [[nodiscard]] static std::string contents(const std::filesystem::path& file)
+    {
+        std::ifstream stream(file, std::ios::binary);
+
+        return {std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+    }
+
+    [[nodiscard]] std::string contents() const { return contents(path); }
+
+    std::filesystem::path directory =
+        std::filesystem::temp_directory_path() /
+        ("slog_sink_test_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::string path = (directory / "app.log").string();
+};
+
+#endif // SINKS_TEST_COMMON_HPP
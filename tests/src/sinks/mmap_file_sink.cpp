@@ -0,0 +1,146 @@
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <csignal>
+
+#include <sys/resource.h>
+
+#include <gtest/gtest.h>
+
+#include <slog/sinks/mmap_file_sink.hpp>
+
+#include "common.hpp"
+
+namespace
+{
+
+class MmapFileSinkTest : public SinkFileTest<>
+{
+};
+
+} // namespace
+
+TEST_F(MmapFileSinkTest, MessagesSpanSegments)
+{
+    std::string expected;
+
+    {
+        // Smallest segment: one page, rolled many times
+        slog::sinks::MmapFileSink sink("mmap", path, 1);
+        size_t segment = sink.get_segment_size();
+
+        for (int i = 0; i < 2000; i++) {
+            std::string message = "message " + std::to_string(i) + "\n";
+
+            sink.log(message);
+            expected += message;
+        }
+        // Bigger than a segment
+        std::string big(segment * 2 + 17, 'x');
+
+        sink.log(big);
+        expected += big;
+        sink.flush();
+        EXPECT_EQ(std::filesystem::file_size(path) % segment, 0u);
+    }
+
+    // The unused tail of the last segment is truncated
+    EXPECT_EQ(std::filesystem::file_size(path), expected.size());
+    EXPECT_EQ(contents(), expected);
+}
+
+TEST_F(MmapFileSinkTest, DataVisibleBeforeClose)
+{
+    slog::sinks::MmapFileSink sink("mmap", path);
+    std::string_view message = "in the page cache\n";
+
+    sink.log(message);
+    EXPECT_EQ(contents().substr(0, message.size()), message);
+}
+
+TEST_F(MmapFileSinkTest, BatchesAreCopiedInOrder)
+{
+    std::vector<std::string_view> batch = {"first\n", "second\n", "third\n"};
+
+    {
+        slog::sinks::MmapFileSink sink("mmap", path, 1);
+
+        sink.log(batch);
+    }
+    EXPECT_EQ(contents(), "first\nsecond\nthird\n");
+}
+
+TEST_F(MmapFileSinkTest, AppendKeepsTheFile)
+{
+    {
+        slog::sinks::MmapFileSink sink("mmap", path);
+
+        sink.log(std::string_view("first run\n"));
+    }
+    {
+        slog::sinks::MmapFileSink sink("mmap", path, slog::sinks::MmapFileSink::DEFAULT_SEGMENT_SIZE, true);
+
+        sink.log(std::string_view("second run\n"));
+    }
+    EXPECT_EQ(contents(), "first run\nsecond run\n");
+}
+
+TEST_F(MmapFileSinkTest, AppendSkipsTheTailLeftByACrash)
+{
+    {
+        // As left by a process killed before truncating the segments allocated ahead
+        std::ofstream file(path, std::ios::binary);
+        std::string data = "first run\n";
+
+        data.resize(size_t{128} << 10, '\0');
+        file << data;
+    }
+    {
+        slog::sinks::MmapFileSink sink("mmap", path, 1, true);
+
+        sink.log(std::string_view("second run\n"));
+    }
+    EXPECT_EQ(contents(), "first run\nsecond run\n");
+}
+
+TEST_F(MmapFileSinkTest, CountsAndRecoversFromSegmentsThatCantBeMapped)
+{
+    struct rlimit limit{};
+
+    ASSERT_EQ(::getrlimit(RLIMIT_FSIZE, &limit), 0);
+
+    // The file size limit fails the allocation of the third segment, as a full disk would
+    auto previous = std::signal(SIGXFSZ, SIG_IGN);
+    slog::sinks::MmapFileSink sink("mmap", path, 1);
+    size_t segment = sink.get_segment_size();
+    struct rlimit capped = limit;
+
+    capped.rlim_cur = 2 * segment;
+    ASSERT_EQ(::setrlimit(RLIMIT_FSIZE, &capped), 0);
+    sink.log(std::string(segment, 'a'));
+    sink.log(std::string(segment, 'b'));
+    sink.log(std::string(segment, 'c'));
+    EXPECT_EQ(sink.get_lost_bytes(), segment);
+
+    // The segment is mapped again once possible: at most the next write still fails
+    ASSERT_EQ(::setrlimit(RLIMIT_FSIZE, &limit), 0);
+    std::signal(SIGXFSZ, previous);
+    sink.log(std::string_view("after\n"));
+    sink.log(std::string_view("after\n"));
+
+    std::string expected = std::string(segment, 'a') + std::string(segment, 'b') + "after\n";
+
+    if (sink.get_lost_bytes() == segment) {
+        expected += "after\n";
+    }
+    EXPECT_EQ(contents().substr(0, expected.size()), expected);
+    EXPECT_LE(sink.get_lost_bytes(), segment + 6);
+}
+
+#endif
@@ -0,0 +1,197 @@
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <slog/sinks/rotating_file_sink.hpp>
+
+#include "common.hpp"
+
+namespace
+{
+
+class RotatingFileSinkTest : public SinkFileTest<>
+{
+protected:
+    // Archived files, oldest first
+    [[nodiscard]] std::vector<std::filesystem::path> archives() const
+    {
+        std::vector<std::pair<uint64_t, std::filesystem::path>> found;
+
+        for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+            std::string stem = entry.path().stem().string();
+
+            if (entry.path().extension() == ".log" && stem.starts_with("app.")) {
+                found.emplace_back(std::stoull(stem.substr(4)), entry.path());
+            }
+        }
+        std::sort(found.begin(), found.end());
+
+        std::vector<std::filesystem::path> paths;
+
+        for (auto& [index, path] : found) {
+            paths.push_back(path);
+        }
+        return paths;
+    }
+};
+
+} // namespace
+
+TEST_F(RotatingFileSinkTest, SizeRotationKeepsEveryRecord)
+{
+    std::string expected;
+
+    {
+        slog::sinks::RotatingFileSink sink("rotating", path, slog::sinks::RotationPolicy::size(1024));
+
+        for (int i = 0; i < 200; i++) {
+            std::string message = "record " + std::to_string(i) + " of the size rotation test\n";
+
+            sink.log(message);
+            expected += message;
+        }
+    }
+
+    std::vector<std::filesystem::path> files = archives();
+    std::string joined;
+
+    EXPECT_GT(files.size(), 5u);
+    for (const std::filesystem::path& file : files) {
+        EXPECT_LE(std::filesystem::file_size(file), 1024u);
+        joined += contents(file);
+    }
+    joined += contents(path);
+    EXPECT_EQ(joined, expected);
+    EXPECT_FALSE(std::filesystem::exists(path + ".next"));
+}
+
+TEST_F(RotatingFileSinkTest, RetentionDeletesTheOldestFiles)
+{
+    {
+        slog::sinks::RotatingFileSink sink("rotating", path, slog::sinks::RotationPolicy::size(100), 3);
+
+        for (int i = 0; i < 50; i++) {
+            sink.log(std::string_view("a line of about fifty bytes written to the file\n"));
+        }
+    }
+
+    std::vector<std::filesystem::path> files = archives();
+
+    ASSERT_EQ(files.size(), 3u);
+    EXPECT_EQ(files.back().filename(), "app.24.log");
+
+    // The numbering goes on after a restart, the full file left by the first run is archived
+    {
+        slog::sinks::RotatingFileSink sink("rotating", path, slog::sinks::RotationPolicy::size(100), 3);
+
+        sink.log(std::string_view("a line of about fifty bytes written to the file\n"));
+    }
+    files = archives();
+    ASSERT_EQ(files.size(), 3u);
+    EXPECT_EQ(files.back().filename(), "app.25.log");
+}
+
+TEST_F(RotatingFileSinkTest, FailedArchiveKeepsEveryRecord)
+{
+    std::string expected;
+
+    {
+        slog::sinks::RotatingFileSink sink("rotating", path, slog::sinks::RotationPolicy::size(100));
+
+        // A non empty directory takes the first archive name, the current file can't be renamed
+        std::filesystem::create_directories(directory / "app.1.log" / "blocker");
+        for (int i = 0; i < 20; i++) {
+            std::string message = "record " + std::to_string(i) + " of the failed archive test\n";
+
+            if (i == 10) {
+                std::filesystem::remove_all(directory / "app.1.log");
+            }
+            sink.log(message);
+            expected += message;
+        }
+    }
+
+    std::string joined;
+
+    for (const std::filesystem::path& file : archives()) {
+        joined += contents(file);
+    }
+    joined += contents(path);
+    EXPECT_EQ(joined, expected);
+    EXPECT_FALSE(std::filesystem::exists(path + ".next"));
+}
+
+TEST_F(RotatingFileSinkTest, IntervalRotation)
+{
+    {
+        slog::sinks::RotatingFileSink sink("rotating", path, slog::sinks::RotationPolicy::every(std::chrono::seconds(1)));
+
+        sink.log(std::string_view("before\n"));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+        sink.log(std::string_view("after\n"));
+    }
+
+    std::vector<std::filesystem::path> files = archives();
+
+    ASSERT_EQ(files.size(), 1u);
+    EXPECT_EQ(contents(files[0]), "before\n");
+    EXPECT_EQ(contents(path), "after\n");
+}
+
+TEST_F(RotatingFileSinkTest, BatchToAnEmptyFileRestartsTheInterval)
+{
+    std::vector<std::string_view> batch = {"first\n", "second\n"};
+
+    {
+        slog::sinks::RotatingFileSink sink("rotating", path, slog::sinks::RotationPolicy::every(std::chrono::seconds(1)));
+
+        // The interval elapsed on an empty file: no rotation, the next one is a second away
+        std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+        sink.log(batch);
+        sink.log(std::string_view("third\n"));
+    }
+
+    EXPECT_TRUE(archives().empty());
+    EXPECT_EQ(contents(path), "first\nsecond\nthird\n");
+}
+
+TEST_F(RotatingFileSinkTest, RotationsDontWaitForTheHelper)
+{
+    constexpr size_t max_size = 256 * 1024;
+    const std::string message(200, 'x');
+    size_t rotations = 0;
+    uint64_t waits = 0;
+    size_t size = 0;
+
+    {
+        slog::sinks::RotatingFileSink sink("rotating", path, slog::sinks::RotationPolicy::size(max_size), 2);
+
+        // Back to back rotations, the helper has the writes in between to open the next file
+        for (size_t i = 0; i < 40 * (max_size / message.size()); i++) {
+            if (size + message.size() > max_size) {
+                rotations++;
+                size = 0;
+            }
+            sink.log(message);
+            size += message.size();
+        }
+        waits = sink.get_rotation_waits();
+    }
+
+    EXPECT_EQ(rotations, 39u);
+    EXPECT_EQ(archives().size(), 2u);
+    // The helper opened the next file during the writes in between: a rotation opening it would
+    // wait every time, a loaded machine may only schedule the helper late now and then (the
+    // first rotation can even come before it started)
+    EXPECT_LE(waits, rotations / 4);
+}
+
+#endif
@@ -0,0 +1,144 @@
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <slog/core/log_record.hpp>
+#include <slog/fmt/pattern_formatter.hpp>
+#include <slog/sinks/sink_manager.hpp>
+
+namespace
+{
+
+// Flag counting how many times a pattern using it was rendered
+size_t renders = 0;
+size_t messages_formatted = 0;
+
+void fmt_count(const slog::fmt::FormatContext&, std::string& dest)
+{
+    renders++;
+    dest.push_back('#');
+}
+
+void format_counting(std::string_view, const std::byte*, std::string& dest,
+                     slog::fmt::FormatMode)
+{
+    messages_formatted++;
+    dest = "msg";
+}
+
+class RecorderSink : public slog::sinks::ISink
+{
+public:
+    explicit RecorderSink(std::string_view name) : ISink(name) {}
+
+    void flush() override {}
+
+    std::vector<std::string> messages;
+
+private:
+    void _write(std::string_view message) override { messages.emplace_back(message); }
+};
+
+class SinkManagerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        slog::fmt::PatternFormatter::register_flag('K', fmt_count);
+        renders = 0;
+        messages_formatted = 0;
+    }
+
+    static slog::LogRecord make_record(slog::LogLevel level)
+    {
+        slog::LogRecord record;
+
+        record.level = level;
+        record.thread_id = 0;
+        record.format_fn = format_counting;
+        return record;
+    }
+};
+
+} // namespace
+
+TEST_F(SinkManagerTest, EqualPatternsRenderedOnce)
+{
+    auto first = std::make_shared<RecorderSink>("first");
+    auto second = std::make_shared<RecorderSink>("second");
+    auto other = std::make_shared<RecorderSink>("other");
+    slog::sinks::SinkManager manager({first, second, other});
+    slog::LogRecord record = make_record(slog::LogLevel::INFO);
+
+    manager.set_pattern("[%v]");
+    first->set_pattern("%K %v");
+    second->set_pattern("%K %v");
+    other->set_pattern("%K <%v>");
+    manager.dispatch(record);
+
+    // One render for the two sinks sharing a pattern, one for the other pattern
+    EXPECT_EQ(renders, 2u);
+    EXPECT_EQ(first->messages, (std::vector<std::string>{"# msg"}));
+    EXPECT_EQ(second->messages, (std::vector<std::string>{"# msg"}));
+    EXPECT_EQ(other->messages, (std::vector<std::string>{"# <msg>"}));
+}
+
+TEST_F(SinkManagerTest, OnlyPatternsOfAcceptingSinksRendered)
+{
+    auto verbose = std::make_shared<RecorderSink>("verbose");
+    auto quiet = std::make_shared<RecorderSink>("quiet");
+    slog::sinks::SinkManager manager({verbose, quiet});
+    slog::LogRecord record = make_record(slog::LogLevel::DEBUG);
+
+    manager.set_pattern("%K %v");
+    quiet->set_pattern("%K <%v>");
+    quiet->set_level(slog::LogLevel::ERROR);
+    manager.dispatch(record);
+
+    EXPECT_EQ(renders, 1u);
+    EXPECT_EQ(verbose->messages, (std::vector<std::string>{"# msg"}));
+    EXPECT_TRUE(quiet->messages.empty());
+}
+
+TEST_F(SinkManagerTest, NothingRenderedWithoutAcceptingSink)
+{
+    auto sink = std::make_shared<RecorderSink>("sink");
+    slog::sinks::SinkManager manager(sink);
+    slog::LogRecord record = make_record(slog::LogLevel::DEBUG);
+    slog::LogRecord* batch[] = {&record, &record};
+
+    manager.set_pattern("%K %v");
+    sink->set_level(slog::LogLevel::WARNING);
+    manager.dispatch(record);
+    manager.dispatch(std::span<slog::LogRecord* const>(batch));
+
+    EXPECT_EQ(renders, 0u);
+    EXPECT_EQ(messages_formatted, 0u);
+    EXPECT_TRUE(sink->messages.empty());
+}
+
+TEST_F(SinkManagerTest, BatchRendersGroupUpToItsMostVerboseSink)
+{
+    auto info = std::make_shared<RecorderSink>("info");
+    auto error = std::make_shared<RecorderSink>("error");
+    slog::sinks::SinkManager manager({info, error});
+    slog::LogRecord records[] = {make_record(slog::LogLevel::ERROR), make_record(slog::LogLevel::INFO),
+                                 make_record(slog::LogLevel::TRACE)};
+    slog::LogRecord* batch[] = {&records[0], &records[1], &records[2]};
+
+    info->set_pattern("%K %l");
+    error->set_pattern("%K %l");
+    info->set_level(slog::LogLevel::INFO);
+    error->set_level(slog::LogLevel::ERROR);
+    manager.dispatch(std::span<slog::LogRecord* const>(batch));
+
+    // TRACE taken by no sink: neither formatted nor rendered
+    EXPECT_EQ(messages_formatted, 2u);
+    EXPECT_EQ(renders, 2u);
+    EXPECT_EQ(info->messages, (std::vector<std::string>{"# ERROR", "# INFO"}));
+    EXPECT_EQ(error->messages, (std::vector<std::string>{"# ERROR"}));
+}
@@ -0,0 +1,107 @@
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <slog/sinks/uring_file_sink.hpp>
+
+#include "common.hpp"
+
+namespace
+{
+
+class UringFileSinkTest : public SinkFileTest<::testing::TestWithParam<bool>>
+{
+protected:
+    // Smallest chunks, with or without io_uring
+    [[nodiscard]] slog::sinks::UringFileOptions options(bool append = false) const
+    {
+        return {4096, 3, append, GetParam()};
+    }
+};
+
+} // namespace
+
+TEST_P(UringFileSinkTest, ChunksAreWrittenInOrder)
+{
+    std::string expected;
+
+    {
+        slog::sinks::UringFileSink sink("uring", path, options());
+
+        if (!GetParam()) {
+            EXPECT_EQ(sink.get_backend(), slog::sinks::WriteBackend::PWRITE);
+        }
+        for (int i = 0; i < 20000; i++) {
+            std::string message = "message " + std::to_string(i) + "\n";
+
+            sink.log(message);
+            expected += message;
+        }
+        // Bigger than every chunk together
+        std::string big(5 * 4096 + 17, 'x');
+
+        sink.log(big);
+        expected += big;
+    }
+
+    EXPECT_EQ(contents(), expected);
+}
+
+TEST_P(UringFileSinkTest, FlushSubmitsThePartialChunk)
+{
+    std::vector<std::string_view> batch = {"first\n", "second\n"};
+    slog::sinks::UringFileSink sink("uring", path, options());
+
+    sink.log(batch);
+    sink.flush();
+    sink.log(std::string_view("third\n"));
+    sink.flush();
+
+    // Written in the background, done at most when every chunk was needed again
+    for (int i = 0; i < 3; i++) {
+        sink.log(std::string(4096, 'y'));
+    }
+    EXPECT_EQ(contents().substr(0, 19), "first\nsecond\nthird\n");
+    EXPECT_EQ(sink.get_lost_bytes(), 0u);
+}
+
+TEST_P(UringFileSinkTest, FlushOrdersTheNextWrites)
+{
+    slog::sinks::UringFileSink sink("uring", path, options());
+
+    for (int i = 0; i < 200; i++) {
+        sink.log("flushed " + std::to_string(i) + "\n");
+        sink.flush();
+        sink.log(std::string(4096, 'z'));
+
+        // Whatever reached the file, no data after a flush went before the data flushed
+        EXPECT_EQ(contents().find('\0'), std::string::npos) << i;
+    }
+    EXPECT_EQ(sink.get_lost_bytes(), 0u);
+}
+
+TEST_P(UringFileSinkTest, AppendKeepsTheFile)
+{
+    {
+        slog::sinks::UringFileSink sink("uring", path, options());
+
+        sink.log(std::string_view("first run\n"));
+    }
+    {
+        slog::sinks::UringFileSink sink("uring", path, options(true));
+
+        sink.log(std::string_view("second run\n"));
+    }
+    EXPECT_EQ(contents(), "first run\nsecond run\n");
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, UringFileSinkTest, ::testing::Values(true, false),
+                         [](const ::testing::TestParamInfo<bool>& info) {
+                             return info.param ? "IoUring" : "Fallback";
+                         });
+
+#endif
@@ -1,7 +1,15 @@
 #include <gtest/gtest.h>
 
+#ifdef SLOG_TEST_WORKER_COUNT
+    #include <slog/slog.hpp>
+#endif
+
 int main(int argc, char **argv)
 {
+#ifdef SLOG_TEST_WORKER_COUNT
+    // Before any test builds the registry
+    slog::Registry::set_worker_count(SLOG_TEST_WORKER_COUNT);
+#endif
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
 }
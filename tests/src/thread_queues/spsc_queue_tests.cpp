@@ -0,0 +1,70 @@
+#include <atomic>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <slog/async/policies.hpp>
+#include <slog/async/spsc_queue.hpp>
+
+TEST(SPSCQueue_Functional, BasicPushPop)
+{
+    slog::async::SPSCQueue<int, 4, slog::async::BlockOnFull> queue;
+
+    EXPECT_TRUE(queue.push(10));
+    EXPECT_TRUE(queue.push(20));
+
+    int val;
+    ASSERT_NE(queue.front(), nullptr);
+    EXPECT_EQ(*queue.front(), 10);
+    EXPECT_TRUE(queue.pop(val));
+    EXPECT_EQ(val, 10);
+    EXPECT_TRUE(queue.pop(val));
+    EXPECT_EQ(val, 20);
+
+    // Queue should be empty now
+    EXPECT_EQ(queue.front(), nullptr);
+    EXPECT_FALSE(queue.pop(val));
+}
+
+TEST(SPSCQueue_Functional, DiscardOnFullAndWrapAround)
+{
+    constexpr size_t SIZE = 4;
+    slog::async::SPSCQueue<size_t, SIZE, slog::async::DiscardOnFull> queue;
+    size_t counter = 0;
+    size_t expected = 0;
+    size_t val;
+
+    for (size_t c = 0; c < 10; c++) {
+        for (size_t i = 0; i < SIZE; i++) {
+            EXPECT_TRUE(queue.push(size_t{counter++}));
+        }
+        EXPECT_FALSE(queue.push(size_t{counter}));
+        for (size_t i = 0; i < SIZE; i++) {
+            ASSERT_TRUE(queue.pop(val));
+            EXPECT_EQ(val, expected++);
+        }
+    }
+}
+
+TEST(SPSCQueue_Concurrent, ProducerConsumer)
+{
+    constexpr size_t ITEMS = 200000;
+    slog::async::SPSCQueue<size_t, 64, slog::async::BlockOnFull> queue;
+
+    std::thread producer([&]() {
+        for (size_t i = 0; i < ITEMS; i++) {
+            queue.push(size_t{i});
+        }
+    });
+
+    size_t expected = 0;
+    size_t val;
+    while (expected < ITEMS) {
+        if (!queue.pop(val)) {
+            std::this_thread::yield();
+            continue;
+        }
+        ASSERT_EQ(val, expected);
+        expected++;
+    }
+    producer.join();
+}
@@ -0,0 +1,114 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <slog/async/policies.hpp>
+#include <slog/async/thread_queues.hpp>
+
+namespace
+{
+
+struct Item
+{
+    size_t key;
+    size_t thread_id;
+};
+
+using Queues = slog::async::ThreadQueues<Item, 64, slog::async::BlockOnFull>;
+
+auto by_key = [](const Item& item) { return item.key; };
+
+} // namespace
+
+TEST(ThreadQueues_Functional, MergesRingsInKeyOrder)
+{
+    Queues queues;
+
+    // Interleaved keys pushed from two threads, each ring is sorted on its own
+    std::thread even([&]() {
+        for (size_t k = 0; k < 20; k += 2) {
+            queues.push(Item{k, 0});
+        }
+    });
+    std::thread odd([&]() {
+        for (size_t k = 1; k < 20; k += 2) {
+            queues.push(Item{k, 1});
+        }
+    });
+    even.join();
+    odd.join();
+
+    Item item;
+    for (size_t expected = 0; expected < 20; expected++) {
+        ASSERT_TRUE(queues.pop(item, by_key));
+        EXPECT_EQ(item.key, expected);
+        EXPECT_EQ(item.thread_id, expected % 2);
+    }
+    EXPECT_FALSE(queues.pop(item, by_key));
+}
+
+TEST(ThreadQueues_Functional, RetiresRingsOfExitedThreads)
+{
+    Queues queues;
+    Item item;
+
+    std::thread([&]() { queues.push(Item{1, 0}); }).join();
+    std::thread([&]() { queues.push(Item{2, 1}); }).join();
+
+    // Both threads exited, their items are still delivered
+    ASSERT_TRUE(queues.pop(item, by_key));
+    EXPECT_EQ(item.key, 1u);
+    ASSERT_TRUE(queues.pop(item, by_key));
+    EXPECT_EQ(item.key, 2u);
+
+    // Drained retired rings are dropped by the next pop
+    EXPECT_FALSE(queues.pop(item, by_key));
+    EXPECT_EQ(queues.size(), 0u);
+
+    // A live thread keeps its ring
+    queues.push(Item{3, 2});
+    ASSERT_TRUE(queues.pop(item, by_key));
+    EXPECT_FALSE(queues.pop(item, by_key));
+    EXPECT_EQ(queues.size(), 1u);
+}
+
+TEST(ThreadQueues_Concurrent, MultiProducerSingleConsumer)
+{
+    constexpr size_t NUM_PRODUCERS = 8;
+    constexpr size_t ITEMS_PER_PRODUCER = 20000;
+
+    Queues queues;
+    std::atomic<bool> start_flag{false};
+    std::vector<std::thread> producers;
+
+    for (size_t t = 0; t < NUM_PRODUCERS; t++) {
+        producers.emplace_back([&, t]() {
+            while (!start_flag.load(std::memory_order_acquire));
+            for (size_t i = 0; i < ITEMS_PER_PRODUCER; i++) {
+                queues.push(Item{i, t});
+            }
+        });
+    }
+    start_flag.store(true, std::memory_order_release);
+
+    size_t total_consumed = 0;
+    std::vector<size_t> last_seen(NUM_PRODUCERS, (size_t)-1);
+    Item item;
+
+    while (total_consumed < NUM_PRODUCERS * ITEMS_PER_PRODUCER) {
+        if (!queues.pop(item, by_key)) {
+            std::this_thread::yield();
+            continue;
+        }
+        total_consumed++;
+        ASSERT_LT(item.thread_id, NUM_PRODUCERS);
+        ASSERT_EQ(item.key, last_seen[item.thread_id] + 1)
+            << "Gap or disorder detected for thread " << item.thread_id;
+        last_seen[item.thread_id] = item.key;
+    }
+    for (auto& p : producers) {
+        p.join();
+    }
+    EXPECT_FALSE(queues.pop(item, by_key));
+}
@@ -0,0 +1,201 @@
+///
+/// @file decode/main.cpp
+/// @brief slog-decode: renders the binary logs written by BinaryFileSink as text, with any
+/// pattern. Usage:
+///
+///     slog-decode [--pattern <pattern>] <file>...
+///
+/// Without --pattern records are rendered with the default pattern of PatternFormatter.
+/// A file ending with a truncated frame (e.g. the process died while writing it) is decoded up
+/// to that frame and reported on stderr.
+///
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <slog/details/filesystem.hpp>
+#include <slog/details/thread_context.hpp>
+#include <slog/fmt/pattern_formatter.hpp>
+#include <slog/sinks/binary_log.hpp>
+#include <slog/slog.hpp>
+
+namespace
+{
+
+constexpr size_t OUTPUT_CHUNK = size_t{64} << 10;
+
+// The built-in source location flags read the std::source_location of the record, which can't
+// be rebuilt from the file: they are overridden to read the callsite being rendered
+const slog::sinks::binary::Callsite* current_callsite = nullptr;
+
+void fmt_source_file(const slog::fmt::FormatContext&, std::string& dest)
+{
+    dest.append(slog::details::path_basename(current_callsite->file));
+}
+
+void fmt_source_path(const slog::fmt::FormatContext&, std::string& dest)
+{
+    dest.append(current_callsite->file);
+}
+
+void fmt_source_line(const slog::fmt::FormatContext&, std::string& dest)
+{
+    dest.append(std::to_string(current_callsite->line));
+}
+
+void fmt_source_func(const slog::fmt::FormatContext&, std::string& dest)
+{
+    dest.append(current_callsite->function);
+}
+
+void usage(const char* program)
+{
+    std::fprintf(stderr, "usage: %s [--pattern <pattern>] <file>...\n", program);
+}
+
+// Patterns usually come from a shell: \n and \t are read as newline and tab
+std::string unescape(std::string_view pattern)
+{
+    std::string result;
+
+    for (size_t i = 0; i < pattern.size(); i++) {
+        if (pattern[i] == '\\' && i + 1 < pattern.size() && (pattern[i + 1] == 'n' || pattern[i + 1] == 't')) {
+            result.push_back(pattern[++i] == 'n' ? '\n' : '\t');
+        }
+        else {
+            result.push_back(pattern[i]);
+        }
+    }
+    return result;
+}
+
+bool read_file(const char* path, std::string& data)
+{
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file) {
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+class Decoder
+{
+public:
+    explicit Decoder(std::string_view pattern)
+    {
+        if (!pattern.empty()) {
+            _formatter.set_pattern(pattern);
+        }
+    }
+
+    ~Decoder() { _write(); }
+
+    Decoder(const Decoder&) = delete;
+    Decoder& operator=(const Decoder&) = delete;
+
+    // False when the file is not a binary log or ends with a truncated frame
+    bool decode(std::string_view data)
+    {
+        slog::sinks::binary::Reader reader(data);
+        slog::sinks::binary::Record decoded;
+
+        while (reader.next(decoded)) {
+            if (!decoded.callsite) {
+                _out.append(decoded.message);
+            }
+            else {
+                _render(decoded);
+            }
+            if (_out.size() >= OUTPUT_CHUNK) {
+                _write();
+            }
+        }
+        return reader.complete();
+    }
+
+private:
+    void _render(slog::sinks::binary::Record& decoded)
+    {
+        current_callsite = decoded.callsite;
+        _record.level = decoded.level;
+        _record.logger_name = decoded.logger_name;
+        _record.timestamp = decoded.timestamp;
+        _record.thread_id = static_cast<size_t>(decoded.thread_id);
+        _record.thread = decoded.thread_name.empty() ? nullptr : _thread(decoded);
+        _record.string_buffer.swap(decoded.message);
+        _formatter.format(_record, _out);
+        _record.string_buffer.swap(decoded.message);
+    }
+
+    // %t and %N read the thread context, one per thread id and name
+    const slog::details::ThreadContext* _thread(const slog::sinks::binary::Record& decoded)
+    {
+        auto key = std::make_pair(decoded.thread_id, std::string(decoded.thread_name));
+        auto [it, inserted] = _threads.try_emplace(std::move(key));
+
+        if (inserted) {
+            it->second = std::make_unique<slog::details::ThreadContext>(
+                static_cast<size_t>(decoded.thread_id), decoded.thread_name);
+        }
+        return it->second.get();
+    }
+
+    void _write()
+    {
+        std::fwrite(_out.data(), 1, _out.size(), stdout);
+        _out.clear();
+    }
+
+    slog::fmt::PatternFormatter _formatter;
+    slog::LogRecord _record;
+    std::map<std::pair<uint64_t, std::string>, std::unique_ptr<slog::details::ThreadContext>> _threads;
+    std::string _out;
+};
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string pattern;
+    int first_file = 1;
+
+    if (argc > 2 && std::strcmp(argv[1], "--pattern") == 0) {
+        pattern = unescape(argv[2]);
+        first_file = 3;
+    }
+    if (first_file >= argc || std::strcmp(argv[first_file], "--help") == 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // Before any pattern is parsed, parsed patterns keep the flags they were built with
+    slog::fmt::PatternFormatter::register_flag('s', fmt_source_file);
+    slog::fmt::PatternFormatter::register_flag('g', fmt_source_path);
+    slog::fmt::PatternFormatter::register_flag('#', fmt_source_line);
+    slog::fmt::PatternFormatter::register_flag('!', fmt_source_func);
+
+    Decoder decoder(pattern);
+    std::string data;
+    int status = 0;
+
+    for (int i = first_file; i < argc; i++) {
+        if (!read_file(argv[i], data)) {
+            std::fprintf(stderr, "%s: cannot read %s\n", argv[0], argv[i]);
+            status = 1;
+        }
+        else if (!decoder.decode(data)) {
+            std::fprintf(stderr, "%s: %s is truncated or not a binary log\n", argv[0], argv[i]);
+            status = 1;
+        }
+    }
+    return status;
+}